@@ -0,0 +1,83 @@
+#!/bin/sh
+#
+# Benchmark das implementações da fila de impressão
+#
+# Compila as implementações com otimização, executa cada uma sem os atrasos simulados
+# (--no-sleep) e sem mensagens por documento (--quiet) em uma matriz de produtores,
+# impressoras e tamanhos de buffer, e reúne as linhas de estatísticas (print_stats.h):
+# vazão, latência inserção → remoção (p50/p99/p99,9), trocas de contexto por documento
+# e tempo de serviço (p50/p99/p99,9).
+#
+# Uso:
+#   bench/bench_print_queue.sh [csv|json] > resultados.csv
+#
+# Variáveis de ambiente:
+#   IMPLS      Implementações a medir (padrão: "mutex steal sem sem_futex monitor lockfree sharded";
+#              sem_futex é print_system_sem.c compilado com -DUSE_FUTEX_SEM)
+#   PRODUCERS  Números de produtores (padrão: "1 2 4 8")
+#   CONSUMERS  Números de impressoras (padrão: "1 2 4 8")
+#   BUFFERS    Tamanhos de buffer (padrão: "8 64 1024")
+#   DOCUMENTS  Documentos por produtor (padrão: 100000)
+#   CC, CFLAGS Compilador e opções (padrão: cc, -O2)
+
+set -eu
+
+FORMAT=${1:-csv}
+case "$FORMAT" in
+csv | json) ;;
+*)
+    echo "Uso: $0 [csv|json]" >&2
+    exit 1
+    ;;
+esac
+
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${BUILD_DIR:-"$SRC_DIR/bench/build"}
+IMPLS=${IMPLS:-"mutex steal sem sem_futex monitor lockfree sharded"}
+PRODUCERS=${PRODUCERS:-"1 2 4 8"}
+CONSUMERS=${CONSUMERS:-"1 2 4 8"}
+BUFFERS=${BUFFERS:-"8 64 1024"}
+DOCUMENTS=${DOCUMENTS:-100000}
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:-"-O2"}
+
+mkdir -p "$BUILD_DIR"
+for impl in $IMPLS; do
+    case "$impl" in
+    sem_futex)
+        $CC $CFLAGS -DUSE_FUTEX_SEM -o "$BUILD_DIR/print_system_$impl" "$SRC_DIR/print_system_sem.c" -pthread -lm
+        ;;
+    *)
+        $CC $CFLAGS -o "$BUILD_DIR/print_system_$impl" "$SRC_DIR/print_system_$impl.c" -pthread -lm
+        ;;
+    esac
+done
+
+if [ "$FORMAT" = csv ]; then
+    echo "impl,producers,consumers,buffer_size,documents,elapsed_s,ops_per_sec,p50_ns,p99_ns,p999_ns,ctx_switches_per_op,svc_p50_ns,svc_p99_ns,svc_p999_ns"
+else
+    echo "["
+fi
+
+first=1
+for impl in $IMPLS; do
+    for p in $PRODUCERS; do
+        for c in $CONSUMERS; do
+            for b in $BUFFERS; do
+                line=$("$BUILD_DIR/print_system_$impl" --no-sleep --quiet --stats "$FORMAT" \
+                    -p "$p" -c "$c" -b "$b" -d "$DOCUMENTS")
+                if [ "$FORMAT" = json ] && [ $first -eq 0 ]; then
+                    echo ","
+                fi
+                printf '%s' "$line"
+                [ "$FORMAT" = csv ] && echo
+                first=0
+            done
+        done
+    done
+done
+
+if [ "$FORMAT" = json ]; then
+    echo
+    echo "]"
+fi
@@ -0,0 +1,71 @@
+#!/bin/sh
+#
+# Escalabilidade das implementações da fila de impressão
+#
+# Compila as implementações com otimização e executa cada uma sem os atrasos simulados
+# (--no-sleep) e sem mensagens por documento (--quiet) com o mesmo número N de
+# produtores e impressoras, para N de 1 a 64. Compara a fila particionada
+# (print_system_sharded.c) com as versões de buffer único; as colunas são as mesmas
+# de bench_print_queue.sh.
+#
+# Uso:
+#   bench/bench_scaling.sh [csv|json] > escalabilidade.csv
+#
+# Variáveis de ambiente:
+#   IMPLS      Implementações a medir (padrão: "mutex steal sem monitor lockfree sharded")
+#   THREADS    Produtores e impressoras de cada execução (padrão: "1 2 4 8 16 32 64")
+#   BUFFER     Tamanho do buffer; na versão particionada, de cada anel (padrão: 64)
+#   SHARDS     Anéis da versão particionada (padrão: um por processador)
+#   DOCUMENTS  Documentos por produtor (padrão: 20000)
+#   CC, CFLAGS Compilador e opções (padrão: cc, -O2)
+
+set -eu
+
+FORMAT=${1:-csv}
+case "$FORMAT" in
+csv | json) ;;
+*)
+    echo "Uso: $0 [csv|json]" >&2
+    exit 1
+    ;;
+esac
+
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${BUILD_DIR:-"$SRC_DIR/bench/build"}
+IMPLS=${IMPLS:-"mutex steal sem monitor lockfree sharded"}
+THREADS=${THREADS:-"1 2 4 8 16 32 64"}
+BUFFER=${BUFFER:-64}
+SHARDS=${SHARDS:-0}
+DOCUMENTS=${DOCUMENTS:-20000}
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:-"-O2"}
+
+mkdir -p "$BUILD_DIR"
+for impl in $IMPLS; do
+    $CC $CFLAGS -o "$BUILD_DIR/print_system_$impl" "$SRC_DIR/print_system_$impl.c" -pthread -lm
+done
+
+if [ "$FORMAT" = csv ]; then
+    echo "impl,producers,consumers,buffer_size,documents,elapsed_s,ops_per_sec,p50_ns,p99_ns,p999_ns,ctx_switches_per_op,svc_p50_ns,svc_p99_ns,svc_p999_ns"
+else
+    echo "["
+fi
+
+first=1
+for impl in $IMPLS; do
+    for n in $THREADS; do
+        line=$(PRINT_SHARDS="$SHARDS" "$BUILD_DIR/print_system_$impl" --no-sleep --quiet --stats "$FORMAT" \
+            -p "$n" -c "$n" -b "$BUFFER" -d "$DOCUMENTS")
+        if [ "$FORMAT" = json ] && [ $first -eq 0 ]; then
+            echo ","
+        fi
+        printf '%s' "$line"
+        [ "$FORMAT" = csv ] && echo
+        first=0
+    done
+done
+
+if [ "$FORMAT" = json ]; then
+    echo
+    echo "]"
+fi
@@ -0,0 +1,88 @@
+#!/bin/sh
+#
+# Microbenchmark de falso compartilhamento na fila de impressão
+#
+# Compila print_system_mutex.c e print_system_monitor.c duas vezes: com o layout
+# alinhado à linha de cache (padrão) e com o layout compacto original
+# (-DPRINT_PACKED_LAYOUT). Executa cada binário sem atrasos e sem mensagens sob
+# perf stat e informa, por layout, a vazão e as falhas de cache por documento.
+#
+# Uso:
+#   bench/perf_false_sharing.sh > falso_compartilhamento.csv
+#
+# Variáveis de ambiente:
+#   PRODUCERS, CONSUMERS  Threads de cada papel (padrão: 4 e 4)
+#   BUFFER                Capacidade do buffer (padrão: 64)
+#   DOCUMENTS             Documentos por produtor (padrão: 500000)
+#   EVENTS                Eventos do perf (padrão: cache-misses,cache-references,L1-dcache-load-misses)
+#   CC, CFLAGS            Compilador e opções (padrão: cc, -O2)
+#
+# Sem o perf instalado (ou sem permissão para contadores), as colunas de eventos
+# ficam vazias e apenas a vazão é informada.
+
+set -eu
+
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+BUILD_DIR=${BUILD_DIR:-"$SRC_DIR/bench/build"}
+PRODUCERS=${PRODUCERS:-4}
+CONSUMERS=${CONSUMERS:-4}
+BUFFER=${BUFFER:-64}
+DOCUMENTS=${DOCUMENTS:-500000}
+EVENTS=${EVENTS:-"cache-misses,cache-references,L1-dcache-load-misses"}
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:-"-O2"}
+
+mkdir -p "$BUILD_DIR"
+PERF_OUT="$BUILD_DIR/perf_stat.txt"
+
+if command -v perf >/dev/null 2>&1 && perf stat -e cache-misses true >/dev/null 2>&1; then
+    HAVE_PERF=1
+else
+    HAVE_PERF=0
+    echo "perf indisponível: apenas a vazão será medida" >&2
+fi
+
+# Valor de um evento na saída de perf stat -x,
+event_value() {
+    awk -F, -v ev="$1" '$3 == ev || $3 ~ "^" ev "(:|$)" { print $1; exit }' "$PERF_OUT"
+}
+
+echo "impl,layout,ops_per_sec,p99_ns,$(echo "$EVENTS" | tr '-' '_'),misses_per_op"
+
+for impl in mutex monitor; do
+    for layout in aligned packed; do
+        flags=""
+        [ "$layout" = packed ] && flags="-DPRINT_PACKED_LAYOUT"
+        bin="$BUILD_DIR/print_system_${impl}_$layout"
+        $CC $CFLAGS $flags -o "$bin" "$SRC_DIR/print_system_$impl.c" -pthread -lm
+
+        args="--no-sleep --quiet --stats csv -p $PRODUCERS -c $CONSUMERS -b $BUFFER -d $DOCUMENTS"
+        if [ $HAVE_PERF -eq 1 ]; then
+            # shellcheck disable=SC2086
+            line=$(perf stat -x, -o "$PERF_OUT" -e "$EVENTS" "$bin" $args)
+        else
+            # shellcheck disable=SC2086
+            line=$("$bin" $args)
+        fi
+
+        # Colunas de print_stats.h: documents(5), ops_per_sec(7), p99_ns(9)
+        documents=$(echo "$line" | cut -d, -f5)
+        ops=$(echo "$line" | cut -d, -f7)
+        p99=$(echo "$line" | cut -d, -f9)
+
+        values=""
+        misses=""
+        for ev in $(echo "$EVENTS" | tr ',' ' '); do
+            v=""
+            [ $HAVE_PERF -eq 1 ] && v=$(event_value "$ev")
+            values="$values,$v"
+            [ "$ev" = cache-misses ] && misses=$v
+        done
+
+        per_op=""
+        if [ -n "$misses" ] && [ "$documents" -gt 0 ] 2>/dev/null; then
+            per_op=$(awk -v m="$misses" -v d="$documents" 'BEGIN { printf "%.3f", m / d }')
+        fi
+        echo "$impl,$layout,$ops,$p99$values,$per_op"
+    done
+done
@@ -0,0 +1,518 @@
+/**
+ * Posicionamento das Threads e do Buffer nos Nós NUMA
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * Sem fixação, o escalonador migra produtores e impressoras entre soquetes e as
+ * linhas de cache do buffer circular passam a ir e voltar entre nós NUMA. Com
+ * --affinity cada produtor e cada impressora é fixado em uma CPU, e o buffer é
+ * movido para um único nó (--queue-node, por padrão o nó da primeira impressora).
+ *
+ * Modos (--affinity):
+ * - none: não fixa nenhuma thread, apenas mede o tráfego entre nós (referência)
+ * - compact: preenche as CPUs de um nó antes de passar ao seguinte
+ * - scatter: alterna os nós a cada thread
+ * - queue: todas as threads nas CPUs do nó do buffer
+ * - lista de CPUs (ex: "0-3,8"): threads distribuídas pela lista, em ordem
+ * As threads são numeradas produtores primeiro e impressoras depois, e cada modo
+ * atribui as CPUs nessa ordem, voltando ao início quando elas acabam.
+ *
+ * Tráfego entre nós:
+ * Cada documento inserido ou removido conta como local se a CPU da thread estiver
+ * no nó do buffer, e remoto caso contrário (para threads não fixadas, a CPU é lida
+ * a cada PRINT_AFFINITY_SAMPLE documentos, e não em toda operação). Cada thread tem
+ * contadores próprios em uma linha de cache.
+ * O relatório mostra também em que nós estão as páginas do buffer.
+ *
+ * A topologia vem de /sys/devices/system/node e considera só as CPUs permitidas ao
+ * processo; sem NUMA, todas as CPUs formam o nó 0. Afinidade, mbind, move_pages e
+ * getcpu são chamadas de sistema diretas, sem libnuma.
+ *
+ * Uso:
+ *   print_affinity_init(&config, produtores, impressoras);
+ *   print_affinity_bind(buffer, bytes);                    // depois de alocar o buffer
+ *   print_affinity_pin(PRINT_AFFINITY_PRODUCER, i);        // no início de cada thread
+ *   print_affinity_note(PRINT_AFFINITY_PRODUCER, i, 1);    // a cada documento ou lote
+ *   print_affinity_report(stdout);
+ *   print_affinity_cleanup();
+ */
+
+#ifndef PRINT_AFFINITY_H
+#define PRINT_AFFINITY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "print_config.h"
+
+/**
+ * Papéis das threads
+ */
+#define PRINT_AFFINITY_PRODUCER 0 // Produtores
+#define PRINT_AFFINITY_CONSUMER 1 // Impressoras
+#define PRINT_AFFINITY_ROLES 2    // Número de papéis
+
+/**
+ * Parâmetros
+ */
+#define PRINT_AFFINITY_CACHE_LINE 64                              // Tamanho da linha de cache
+#define PRINT_AFFINITY_MASK_WORDS (PRINT_MAX_CPUS / (8 * sizeof(unsigned long))) // Palavras da máscara
+#define PRINT_MPOL_BIND 2                                         // Política de mbind: somente os nós dados
+#define PRINT_MPOL_MF_MOVE (1 << 1)                               // mbind move as páginas já alocadas
+#define PRINT_AFFINITY_MAX_REGIONS 64                             // Buffers registrados para o relatório
+#define PRINT_AFFINITY_SAMPLE 64                                  // Documentos entre leituras da CPU (não fixadas)
+
+/**
+ * Contadores de documentos de uma thread
+ */
+typedef struct
+{
+    _Alignas(PRINT_AFFINITY_CACHE_LINE) unsigned long local; // Documentos em CPU do nó do buffer
+    unsigned long remote;                                     // Documentos em CPU de outro nó
+    int pinned_remote;                                        // Thread fixada fora do nó do buffer (-1 = não fixada)
+    int sampled_remote;                                       // Última leitura da CPU fora do nó do buffer
+    unsigned long next_sample;                                // Total de documentos da próxima leitura
+} PrintAffinityCounter;
+
+/**
+ * Estado global do posicionamento
+ */
+typedef struct
+{
+    int policy;                                          // Modo (PRINT_AFFINITY_*)
+    int num_cpus;                                        // CPUs permitidas ao processo
+    int cpus[PRINT_MAX_CPUS];                            // CPUs permitidas, agrupadas por nó
+    int cpu_node[PRINT_MAX_CPUS];                        // Nó de cada CPU (-1 = desconhecido)
+    int num_nodes;                                       // Nós com CPUs permitidas
+    int node_id[PRINT_MAX_NODES];                        // Número de cada nó no sistema
+    int node_first[PRINT_MAX_NODES];                     // Primeira posição do nó em cpus
+    int node_cpus[PRINT_MAX_NODES];                      // CPUs permitidas de cada nó
+    int list[PRINT_MAX_CPUS];                            // CPUs do modo lista
+    int list_length;                                     // Tamanho de list
+    int queue_node;                                      // Nó do buffer (número do sistema)
+    int threads[PRINT_AFFINITY_ROLES];                   // Threads de cada papel
+    PrintAffinityCounter *counters[PRINT_AFFINITY_ROLES]; // Contadores de cada thread
+    void *queue[PRINT_AFFINITY_MAX_REGIONS];             // Memória de cada buffer
+    size_t queue_length[PRINT_AFFINITY_MAX_REGIONS];     // Bytes de cada buffer
+    int num_queues;                                      // Buffers registrados
+} PrintAffinity;
+
+static PrintAffinity print_affinity;
+
+/**
+ * Lê as CPUs de cada nó e as CPUs permitidas ao processo
+ *
+ * @return 0 em caso de sucesso, -1 se a afinidade do processo não puder ser lida
+ */
+static inline int print_affinity_topology(void)
+{
+    unsigned long allowed[PRINT_AFFINITY_MASK_WORDS];
+    static int node_list[PRINT_MAX_CPUS];
+    int found = 0;
+
+    memset(allowed, 0, sizeof(allowed));
+    if (syscall(SYS_sched_getaffinity, 0, sizeof(allowed), allowed) < 0)
+    {
+        fprintf(stderr, "Falha ao ler a afinidade do processo: %s\n", strerror(errno));
+        return -1;
+    }
+    for (int cpu = 0; cpu < PRINT_MAX_CPUS; cpu++)
+    {
+        print_affinity.cpu_node[cpu] = -1;
+    }
+
+    for (int node = 0; node < PRINT_MAX_NODES; node++)
+    {
+        char path[64];
+        char text[4096];
+        FILE *f;
+        int n;
+
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        if ((f = fopen(path, "r")) == NULL)
+        {
+            continue;
+        }
+        n = fgets(text, sizeof(text), f) != NULL ? print_config_cpu_list(text, node_list, PRINT_MAX_CPUS) : -1;
+        fclose(f);
+        found = 1;
+
+        int d = print_affinity.num_nodes;
+        print_affinity.node_id[d] = node;
+        print_affinity.node_first[d] = print_affinity.num_cpus;
+        print_affinity.node_cpus[d] = 0;
+        for (int i = 0; i < n && i < PRINT_MAX_CPUS; i++)
+        {
+            int cpu = node_list[i];
+            print_affinity.cpu_node[cpu] = node;
+            if (allowed[cpu / (8 * sizeof(unsigned long))] & (1UL << (cpu % (8 * sizeof(unsigned long)))))
+            {
+                print_affinity.cpus[print_affinity.num_cpus++] = cpu;
+                print_affinity.node_cpus[d]++;
+            }
+        }
+        if (print_affinity.node_cpus[d] > 0)
+        {
+            print_affinity.num_nodes++;
+        }
+    }
+
+    // Sem NUMA: todas as CPUs permitidas no nó 0
+    if (!found || print_affinity.num_cpus == 0)
+    {
+        print_affinity.num_cpus = 0;
+        for (int cpu = 0; cpu < PRINT_MAX_CPUS; cpu++)
+        {
+            if (allowed[cpu / (8 * sizeof(unsigned long))] & (1UL << (cpu % (8 * sizeof(unsigned long)))))
+            {
+                print_affinity.cpus[print_affinity.num_cpus++] = cpu;
+                print_affinity.cpu_node[cpu] = 0;
+            }
+        }
+        print_affinity.num_nodes = 1;
+        print_affinity.node_id[0] = 0;
+        print_affinity.node_first[0] = 0;
+        print_affinity.node_cpus[0] = print_affinity.num_cpus;
+    }
+    return 0;
+}
+
+/**
+ * Posição de um nó entre os nós com CPUs permitidas
+ *
+ * @param node Número do nó no sistema
+ * @return Posição do nó, ou -1 se ele não tiver CPUs permitidas
+ */
+static inline int print_affinity_node_index(int node)
+{
+    for (int d = 0; d < print_affinity.num_nodes; d++)
+    {
+        if (print_affinity.node_id[d] == node)
+        {
+            return d;
+        }
+    }
+    return -1;
+}
+
+/**
+ * CPU atribuída a uma thread pelo modo configurado
+ *
+ * @param role Papel da thread (PRINT_AFFINITY_PRODUCER ou PRINT_AFFINITY_CONSUMER)
+ * @param index Índice da thread no papel (a partir de 0)
+ * @return CPU da thread, ou -1 se o modo não fixa threads
+ */
+static inline int print_affinity_cpu(int role, int index)
+{
+    int g = role == PRINT_AFFINITY_PRODUCER ? index : print_affinity.threads[PRINT_AFFINITY_PRODUCER] + index;
+    int d;
+
+    switch (print_affinity.policy)
+    {
+    case PRINT_AFFINITY_COMPACT:
+        return print_affinity.cpus[g % print_affinity.num_cpus];
+    case PRINT_AFFINITY_SCATTER:
+        d = g % print_affinity.num_nodes;
+        return print_affinity.cpus[print_affinity.node_first[d] + (g / print_affinity.num_nodes) % print_affinity.node_cpus[d]];
+    case PRINT_AFFINITY_QUEUE:
+        d = print_affinity_node_index(print_affinity.queue_node);
+        return print_affinity.cpus[print_affinity.node_first[d] + g % print_affinity.node_cpus[d]];
+    case PRINT_AFFINITY_LIST:
+        return print_affinity.list[g % print_affinity.list_length];
+    default:
+        return -1;
+    }
+}
+
+/**
+ * Descobre a topologia, resolve o nó do buffer e aloca os contadores
+ *
+ * @param cfg Configuração (modo, lista de CPUs e nó do buffer)
+ * @param producers Número de produtores
+ * @param consumers Número de impressoras
+ * @return 0 em caso de sucesso, -1 se a configuração não puder ser aplicada
+ */
+static inline int print_affinity_init(const PrintConfig *cfg, int producers, int consumers)
+{
+    memset(&print_affinity, 0, sizeof(print_affinity));
+    print_affinity.policy = cfg->affinity;
+    if (cfg->affinity == PRINT_AFFINITY_OFF)
+    {
+        return 0;
+    }
+    if (print_affinity_topology() != 0)
+    {
+        return -1;
+    }
+
+    if (cfg->affinity == PRINT_AFFINITY_LIST)
+    {
+        print_affinity.list_length = print_config_cpu_list(cfg->affinity_cpus, print_affinity.list, PRINT_MAX_CPUS);
+        for (int i = 0; i < print_affinity.list_length && i < PRINT_MAX_CPUS; i++)
+        {
+            int cpu = print_affinity.list[i];
+            int allowed = 0;
+            for (int j = 0; j < print_affinity.num_cpus; j++)
+            {
+                allowed |= print_affinity.cpus[j] == cpu;
+            }
+            if (!allowed)
+            {
+                fprintf(stderr, "CPU %d não está disponível para o processo\n", cpu);
+                return -1;
+            }
+        }
+        if (print_affinity.list_length > PRINT_MAX_CPUS)
+        {
+            print_affinity.list_length = PRINT_MAX_CPUS;
+        }
+    }
+
+    print_affinity.threads[PRINT_AFFINITY_PRODUCER] = producers;
+    print_affinity.threads[PRINT_AFFINITY_CONSUMER] = consumers;
+    for (int role = 0; role < PRINT_AFFINITY_ROLES; role++)
+    {
+        int n = print_affinity.threads[role];
+        print_affinity.counters[role] = aligned_alloc(PRINT_AFFINITY_CACHE_LINE, n * sizeof(PrintAffinityCounter));
+        if (print_affinity.counters[role] == NULL)
+        {
+            fprintf(stderr, "Falha ao alocar contadores de afinidade: %s\n", strerror(errno));
+            return -1;
+        }
+        memset(print_affinity.counters[role], 0, n * sizeof(PrintAffinityCounter));
+        for (int i = 0; i < n; i++)
+        {
+            print_affinity.counters[role][i].pinned_remote = -1;
+        }
+    }
+
+    // Nó do buffer: o configurado, o primeiro nó no modo queue, ou o da primeira impressora
+    if (cfg->queue_node >= 0)
+    {
+        if (print_affinity_node_index(cfg->queue_node) < 0)
+        {
+            fprintf(stderr, "Nó %d não existe ou não tem CPUs disponíveis\n", cfg->queue_node);
+            return -1;
+        }
+        print_affinity.queue_node = cfg->queue_node;
+    }
+    else if (cfg->affinity == PRINT_AFFINITY_QUEUE)
+    {
+        print_affinity.queue_node = print_affinity.node_id[0];
+    }
+    else if (cfg->affinity == PRINT_AFFINITY_NONE)
+    {
+        unsigned cpu = 0;
+        unsigned node = 0;
+        print_affinity.queue_node = syscall(SYS_getcpu, &cpu, &node, NULL) == 0 ? (int)node : 0;
+    }
+    else
+    {
+        print_affinity.queue_node = print_affinity.cpu_node[print_affinity_cpu(PRINT_AFFINITY_CONSUMER, 0)];
+    }
+    return 0;
+}
+
+/**
+ * Move as páginas de um buffer para o nó do buffer
+ *
+ * Pode ser chamada para cada buffer (filas por impressora, shards). Só as páginas
+ * inteiramente dentro do buffer são movidas; um buffer menor que uma página fica
+ * onde foi alocado. Sem NUMA, apenas registra o buffer para o relatório.
+ *
+ * @param addr Início do buffer
+ * @param length Bytes do buffer
+ */
+static inline void print_affinity_bind(void *addr, size_t length)
+{
+    if (print_affinity.policy == PRINT_AFFINITY_OFF)
+    {
+        return;
+    }
+    if (print_affinity.num_queues < PRINT_AFFINITY_MAX_REGIONS)
+    {
+        print_affinity.queue[print_affinity.num_queues] = addr;
+        print_affinity.queue_length[print_affinity.num_queues++] = length;
+    }
+    if (print_affinity.num_nodes < 2)
+    {
+        return;
+    }
+
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = ((uintptr_t)addr + page - 1) & ~(page - 1);
+    uintptr_t end = ((uintptr_t)addr + length) & ~(page - 1);
+    unsigned long mask[PRINT_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+
+    if (end <= start)
+    {
+        return;
+    }
+    mask[print_affinity.queue_node / (8 * sizeof(unsigned long))] |=
+        1UL << (print_affinity.queue_node % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_mbind, start, end - start, PRINT_MPOL_BIND, mask, PRINT_MAX_NODES + 1, PRINT_MPOL_MF_MOVE) != 0)
+    {
+        fprintf(stderr, "Falha ao mover o buffer para o nó %d: %s\n", print_affinity.queue_node, strerror(errno));
+    }
+}
+
+/**
+ * Fixa a thread atual na CPU do seu papel e índice
+ *
+ * @param role Papel da thread
+ * @param index Índice da thread no papel (a partir de 0)
+ * @return 0 em caso de sucesso (ou se o modo não fixa threads), -1 em caso de erro
+ */
+static inline int print_affinity_pin(int role, int index)
+{
+    unsigned long mask[PRINT_AFFINITY_MASK_WORDS] = {0};
+    int cpu = print_affinity_cpu(role, index);
+
+    if (cpu < 0 || index >= print_affinity.threads[role])
+    {
+        return 0;
+    }
+    mask[cpu / (8 * sizeof(unsigned long))] |= 1UL << (cpu % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_sched_setaffinity, 0, sizeof(mask), mask) != 0)
+    {
+        fprintf(stderr, "Falha ao fixar thread na CPU %d: %s\n", cpu, strerror(errno));
+        return -1;
+    }
+    print_affinity.counters[role][index].pinned_remote = print_affinity.cpu_node[cpu] != print_affinity.queue_node;
+    return 0;
+}
+
+/**
+ * Conta documentos inseridos ou removidos pela thread
+ *
+ * @param role Papel da thread
+ * @param index Índice da thread no papel (a partir de 0)
+ * @param docs Número de documentos
+ */
+static inline void print_affinity_note(int role, int index, unsigned long docs)
+{
+    if (print_affinity.policy == PRINT_AFFINITY_OFF || index >= print_affinity.threads[role] || docs == 0)
+    {
+        return;
+    }
+
+    PrintAffinityCounter *c = &print_affinity.counters[role][index];
+    int remote = c->pinned_remote;
+    if (remote < 0)
+    {
+        // Thread não fixada: getcpu é uma chamada de sistema, então a CPU é amostrada
+        if (c->local + c->remote >= c->next_sample)
+        {
+            unsigned cpu = 0;
+            unsigned node = 0;
+            c->sampled_remote = syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && (int)node != print_affinity.queue_node;
+            c->next_sample = c->local + c->remote + PRINT_AFFINITY_SAMPLE;
+        }
+        remote = c->sampled_remote;
+    }
+    if (remote)
+    {
+        c->remote += docs;
+    }
+    else
+    {
+        c->local += docs;
+    }
+}
+
+/**
+ * Exibe o posicionamento, os nós das páginas do buffer e o tráfego entre nós
+ *
+ * @param out Arquivo de saída
+ */
+static inline void print_affinity_report(FILE *out)
+{
+    static const char *names[] = {"desligado", "none", "compact", "scatter", "queue", "lista"};
+    static const char *roles[] = {"produtores", "impressoras"};
+
+    if (print_affinity.policy == PRINT_AFFINITY_OFF)
+    {
+        return;
+    }
+    fprintf(out, "Afinidade %s: %d CPUs em %d nós, buffer no nó %d", names[print_affinity.policy],
+            print_affinity.num_cpus, print_affinity.num_nodes, print_affinity.queue_node);
+
+    // Nó de cada página dos buffers (move_pages sem destino apenas consulta)
+    if (print_affinity.num_queues > 0)
+    {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        unsigned long per_node[PRINT_MAX_NODES] = {0};
+        void *addrs[256];
+        int status[256];
+
+        for (int q = 0; q < print_affinity.num_queues; q++)
+        {
+            uintptr_t first = (uintptr_t)print_affinity.queue[q] & ~(page - 1);
+            size_t pages = ((uintptr_t)print_affinity.queue[q] + print_affinity.queue_length[q] - first + page - 1) / page;
+
+            for (size_t i = 0; i < pages; i += 256)
+            {
+                size_t n = pages - i < 256 ? pages - i : 256;
+                for (size_t j = 0; j < n; j++)
+                {
+                    addrs[j] = (void *)(first + (i + j) * page);
+                }
+                if (syscall(SYS_move_pages, 0, n, addrs, NULL, status, 0) != 0)
+                {
+                    break;
+                }
+                for (size_t j = 0; j < n; j++)
+                {
+                    if (status[j] >= 0 && status[j] < PRINT_MAX_NODES)
+                    {
+                        per_node[status[j]]++;
+                    }
+                }
+            }
+        }
+        for (int node = 0, shown = 0; node < PRINT_MAX_NODES; node++)
+        {
+            if (per_node[node] > 0)
+            {
+                fprintf(out, "%s nó %d = %lu", shown++ ? "," : " (páginas:", node, per_node[node]);
+            }
+            if (node == PRINT_MAX_NODES - 1 && shown)
+            {
+                fprintf(out, ")");
+            }
+        }
+    }
+    fprintf(out, "\n");
+
+    for (int role = 0; role < PRINT_AFFINITY_ROLES; role++)
+    {
+        unsigned long local = 0;
+        unsigned long remote = 0;
+
+        for (int i = 0; i < print_affinity.threads[role]; i++)
+        {
+            local += print_affinity.counters[role][i].local;
+            remote += print_affinity.counters[role][i].remote;
+        }
+        fprintf(out, "Tráfego entre nós (%s): %lu de %lu documentos em CPU fora do nó do buffer (%.1f%%)\n",
+                roles[role], remote, local + remote, local + remote ? 100.0 * remote / (local + remote) : 0.0);
+    }
+}
+
+/**
+ * Libera os contadores
+ */
+static inline void print_affinity_cleanup(void)
+{
+    for (int role = 0; role < PRINT_AFFINITY_ROLES; role++)
+    {
+        free(print_affinity.counters[role]);
+        print_affinity.counters[role] = NULL;
+    }
+}
+
+#endif // PRINT_AFFINITY_H
@@ -0,0 +1,992 @@
+/**
+ * Configuração em Tempo de Execução do Sistema de Fila de Impressão
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * Em vez de constantes de compilação, o tamanho do buffer, o número de produtores
+ * e consumidores e a quantidade de documentos são lidos na inicialização, a partir
+ * de variáveis de ambiente e da linha de comando (a linha de comando tem prioridade).
+ *
+ * A capacidade do buffer é arredondada para a próxima potência de dois, de modo que
+ * o índice circular é obtido com uma máscara (pos & mask) em vez de uma divisão.
+ *
+ * Opções:
+ *   -b, --buffer-size N   Capacidade do buffer        (PRINT_BUFFER_SIZE)
+ *   -p, --producers N     Número de produtores        (PRINT_PRODUCERS)
+ *   -c, --consumers N     Número de impressoras       (PRINT_CONSUMERS)
+ *   -d, --documents N     Documentos por produtor     (PRINT_DOCUMENTS)
+ *   -B, --batch N         Documentos por lote         (PRINT_BATCH_SIZE, monitor e steal --event-loop)
+ *       --bind            Vincula produtor i à impressora i (monitor)
+ *       --compare         Compara modos de entrega (monitor) ou semáforos (sem)
+ *       --no-sleep        Desativa os atrasos simulados (PRINT_NO_SLEEP=1)
+ *   -q, --quiet           Suprime as mensagens        (PRINT_QUIET=1)
+ *       --stats FORMATO   Resultados em csv ou json   (PRINT_STATS)
+ *       --dispatch MODO   Fila de destino: rr ou hash (PRINT_DISPATCH, steal)
+ *       --payload-kb N    Maior conteúdo por documento  (PRINT_PAYLOAD_KB, mutex e steal)
+ *       --journal ARQUIVO Diário durável dos trabalhos  (PRINT_JOURNAL, mutex e steal)
+ *       --journal-interval-us N  Intervalo do commit em grupo (PRINT_JOURNAL_INTERVAL_US)
+ *       --submit-timeout-ms N    Espera máxima por espaço; -1 bloqueia, 0 não espera
+ *                                (PRINT_SUBMIT_TIMEOUT_MS, mutex, steal, sem e monitor)
+ *       --shards N        Número de anéis independentes (PRINT_SHARDS, sharded)
+ *       --event-loop      Impressoras atendidas por uma thread epoll (PRINT_EVENT_LOOP=1, steal)
+ *       --spool DIR       Grava os documentos em arquivos de spool com io_uring (PRINT_SPOOL, mutex e steal)
+ *       --seed N          Semente do gerador de carga    (PRINT_SEED)
+ *       --job-sizes DIST  Tamanhos: uniform, zipf[:s] ou pareto[:alfa] (PRINT_JOB_SIZES)
+ *       --arrivals MODO   Chegadas: uniform ou bursty[:n]  (PRINT_ARRIVALS)
+ *       --record-trace ARQUIVO  Grava o trace dos documentos criados (PRINT_RECORD_TRACE)
+ *       --replay-trace ARQUIVO  Reproduz um trace gravado (PRINT_REPLAY_TRACE)
+ *       --trace-speed N   Aceleração da reprodução; 0 não espera (PRINT_TRACE_SPEED)
+ *       --stages S,R,P    Threads dos estágios spool, render e print (PRINT_STAGES, pipeline)
+ *       --clients N       Produtores simulados como corrotinas; substitui -p (PRINT_CLIENTS, coro)
+ *       --workers N       Threads que executam as corrotinas (PRINT_WORKERS, coro)
+ *       --coro-stack-kb N Pilha de cada corrotina (PRINT_CORO_STACK_KB, coro)
+ *       --elastic MIN,MAX Impressoras ajustadas à carga entre MIN e MAX (PRINT_ELASTIC, mutex)
+ *       --elastic-target-ms N    Espera na fila que aciona mais impressoras (PRINT_ELASTIC_TARGET_MS)
+ *       --affinity MODO   Fixa as threads: none, compact, scatter, queue ou lista de CPUs (PRINT_AFFINITY)
+ *       --queue-node N    Nó NUMA do buffer; padrão: o nó das impressoras (PRINT_QUEUE_NODE)
+ *   -h, --help            Exibe a ajuda
+ *
+ * As opções específicas (com o programa entre parênteses) são declaradas por cada
+ * programa com as máscaras PRINT_OPT_*; as demais implementações as rejeitam.
+ *
+ * Tamanhos e intervalos dos documentos vêm do gerador de carga (../common/workload.h),
+ * com um gerador por produtor: a mesma semente repete a mesma carga.
+ */
+
+#ifndef PRINT_CONFIG_H
+#define PRINT_CONFIG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+
+#include "../common/workload.h"
+
+/**
+ * Valores padrão e limites
+ */
+#define PRINT_DEFAULT_BUFFER_SIZE 8       // Capacidade padrão do buffer circular
+#define PRINT_DEFAULT_PRODUCERS 3         // Número padrão de produtores (aplicações)
+#define PRINT_DEFAULT_CONSUMERS 2         // Número padrão de consumidores (impressoras)
+#define PRINT_DEFAULT_DOCUMENTS 10        // Documentos padrão por produtor
+#define PRINT_DEFAULT_BATCH_SIZE 4        // Documentos padrão por lote
+#define PRINT_DEFAULT_PAYLOAD_KB 0        // Conteúdo padrão por documento (KB, 0 = só cabeçalho)
+#define PRINT_DEFAULT_JOURNAL_US 1000     // Intervalo padrão do commit em grupo do diário (us)
+#define PRINT_MAX_BUFFER_SIZE (1L << 24)  // Maior capacidade aceita (16M posições)
+#define PRINT_MAX_THREADS 4096            // Maior número de threads por papel
+#define PRINT_MAX_DOCUMENTS 1000000000L   // Maior número de documentos por produtor
+#define PRINT_MAX_BATCH_SIZE 256          // Maior lote aceito
+#define PRINT_MAX_PAYLOAD_KB 65536        // Maior bloco de conteúdo (64 MB)
+#define PRINT_MAX_JOURNAL_US 1000000      // Maior intervalo do commit em grupo (1 s)
+#define PRINT_MAX_TIMEOUT_MS 3600000      // Maior prazo de submissão (1 h)
+#define PRINT_MAX_SHARDS 1024             // Maior número de anéis da fila particionada
+#define PRINT_MIN_DOC_KB 1                // Menor documento gerado (KB)
+#define PRINT_MAX_DOC_KB 100              // Maior documento gerado (KB)
+#define PRINT_MAX_PRODUCE_GAP_US 500000   // Maior intervalo entre documentos de um produtor (us)
+#define PRINT_MAX_TRACE_SPEED 1000000     // Maior aceleração da reprodução de trace
+#define PRINT_PIPELINE_STAGES 3           // Estágios do pipeline: spool, render e print
+#define PRINT_MAX_CLIENTS 1000000         // Maior número de produtores em corrotinas
+#define PRINT_DEFAULT_CORO_STACK_KB 32    // Pilha padrão de cada corrotina (KB)
+#define PRINT_MIN_CORO_STACK_KB 16        // Menor pilha de corrotina (KB)
+#define PRINT_MAX_CORO_STACK_KB 8192      // Maior pilha de corrotina (KB)
+#define PRINT_DEFAULT_ELASTIC_MS 200      // Espera média na fila que aciona mais impressoras (ms)
+#define PRINT_MAX_ELASTIC_MS 3600000      // Maior espera alvo do pool elástico (1 h)
+#define PRINT_MAX_CPUS 1024               // Maior número de CPU aceito em listas de CPUs
+#define PRINT_MAX_NODES 64                // Maior número de nós NUMA
+
+/**
+ * Resultados da leitura da configuração
+ */
+#define PRINT_CONFIG_OK 0     // Configuração válida, programa deve prosseguir
+#define PRINT_CONFIG_EXIT 1   // Ajuda exibida, programa deve encerrar com sucesso
+#define PRINT_CONFIG_ERROR -1 // Opção inválida, programa deve encerrar com erro
+
+/**
+ * Formatos da linha de resultados (print_stats.h)
+ */
+#define PRINT_STATS_NONE 0 // Sem linha de resultados
+#define PRINT_STATS_CSV 1  // Uma linha CSV
+#define PRINT_STATS_JSON 2 // Um objeto JSON por linha
+
+/**
+ * Modos de despacho dos documentos às filas das impressoras (steal)
+ */
+#define PRINT_DISPATCH_RR 0   // Fila de destino escolhida em rodízio (padrão)
+#define PRINT_DISPATCH_HASH 1 // Fila de destino escolhida pelo hash do produtor
+
+/**
+ * Posicionamento das threads nas CPUs (print_affinity.h)
+ */
+#define PRINT_AFFINITY_OFF 0     // Sem fixação nem medição (padrão)
+#define PRINT_AFFINITY_NONE 1    // Sem fixação, apenas mede o tráfego entre nós
+#define PRINT_AFFINITY_COMPACT 2 // Preenche as CPUs de um nó antes do seguinte
+#define PRINT_AFFINITY_SCATTER 3 // Alterna os nós a cada thread
+#define PRINT_AFFINITY_QUEUE 4   // Todas as threads no nó do buffer
+#define PRINT_AFFINITY_LIST 5    // Threads distribuídas pela lista de CPUs
+
+/**
+ * Opções específicas de cada programa (máscara passada a print_config_load)
+ *
+ * As opções comuns (-b, -p, -c, -d, -q, --no-sleep, --stats, --seed, --job-sizes e
+ * --arrivals) valem para todos os programas. As demais só são aceitas na linha de
+ * comando pelos programas que as implementam; as variáveis de ambiente
+ * correspondentes são ignoradas pelos outros, pois o mesmo ambiente costuma ser
+ * compartilhado por todas as implementações (ex: PRINT_SHARDS em bench_scaling.sh).
+ */
+#define PRINT_OPT_BATCH (1u << 0)           // -B, --batch
+#define PRINT_OPT_BIND (1u << 1)            // --bind
+#define PRINT_OPT_COMPARE (1u << 2)         // --compare
+#define PRINT_OPT_DISPATCH (1u << 3)        // --dispatch
+#define PRINT_OPT_PAYLOAD (1u << 4)         // --payload-kb
+#define PRINT_OPT_JOURNAL (1u << 5)         // --journal, --journal-interval-us
+#define PRINT_OPT_SUBMIT_TIMEOUT (1u << 6)  // --submit-timeout-ms
+#define PRINT_OPT_SHARDS (1u << 7)          // --shards
+#define PRINT_OPT_EVENT_LOOP (1u << 8)      // --event-loop
+#define PRINT_OPT_SPOOL (1u << 9)           // --spool
+#define PRINT_OPT_TRACE (1u << 10)          // --record-trace, --replay-trace, --trace-speed
+#define PRINT_OPT_STAGES (1u << 11)         // --stages
+#define PRINT_OPT_CORO (1u << 12)           // --clients, --workers, --coro-stack-kb
+#define PRINT_OPT_ELASTIC (1u << 13)        // --elastic, --elastic-target-ms
+#define PRINT_OPT_AFFINITY (1u << 14)       // --affinity, --queue-node
+
+/**
+ * Configuração do Sistema de Fila de Impressão
+ */
+typedef struct
+{
+    size_t buffer_size;        // Capacidade do buffer (potência de dois)
+    size_t buffer_mask;        // buffer_size - 1, usado no lugar de % buffer_size
+    int num_producers;         // Número de threads produtoras
+    int num_consumers;         // Número de threads consumidoras
+    int max_documents;         // Documentos produzidos por produtor
+    int batch_size;            // Documentos movidos por operação em lote
+    int bind_printers;         // Vincula cada produtor a uma impressora própria
+    int compare;               // Executa a comparação de modos de entrega
+    int simulate_delays;       // Simula tempos de produção e impressão (usleep)
+    int quiet;                 // Suprime as mensagens do programa
+    int stats_format;          // Formato da linha de resultados (PRINT_STATS_*)
+    int dispatch;              // Modo de despacho (PRINT_DISPATCH_*)
+    size_t payload_size;       // Maior conteúdo gravado por documento (bytes)
+    const char *journal;       // Arquivo do diário de trabalhos (NULL = sem diário)
+    long journal_us;           // Intervalo do commit em grupo do diário (us)
+    long submit_timeout;       // Espera máxima por espaço em ms (-1 = sem prazo, 0 = não espera)
+    int shards;                // Anéis da fila particionada (0 = um por processador)
+    int event_loop;            // Filas das impressoras atendidas por um laço epoll
+    const char *spool;         // Diretório dos arquivos de spool (NULL = impressão simulada)
+    uint64_t seed;             // Semente do gerador de carga
+    WorkloadDist job_sizes;    // Distribuição dos tamanhos dos documentos (KB)
+    WorkloadArrivals arrivals; // Processo de chegada dos documentos de cada produtor
+    const char *record_trace;  // Trace a gravar (NULL = sem gravação)
+    const char *replay_trace;  // Trace a reproduzir (NULL = carga sintética)
+    long trace_speed;          // Aceleração da reprodução (0 = sem espera)
+    int stage_threads[PRINT_PIPELINE_STAGES]; // Threads de cada estágio do pipeline (0 = --consumers)
+    int num_clients;           // Produtores em corrotinas (0 = --producers)
+    int num_workers;           // Threads que executam as corrotinas (0 = uma por processador)
+    size_t coro_stack_size;    // Pilha de cada corrotina (bytes)
+    int elastic_min;           // Menor número de impressoras do pool elástico (0 = pool fixo)
+    int elastic_max;           // Maior número de impressoras do pool elástico
+    long elastic_target_ms;    // Espera média na fila acima da qual o pool cresce (ms)
+    int affinity;              // Posicionamento das threads (PRINT_AFFINITY_*)
+    const char *affinity_cpus; // Lista de CPUs de PRINT_AFFINITY_LIST (ex: "0-3,8")
+    int queue_node;            // Nó NUMA do buffer (-1 = nó das impressoras)
+} PrintConfig;
+
+/**
+ * Arredonda um valor para a próxima potência de dois
+ *
+ * @param n Valor a ser arredondado (n >= 1)
+ * @return Menor potência de dois maior ou igual a n
+ */
+static inline size_t print_config_round_pow2(size_t n)
+{
+    size_t p = 1;
+
+    while (p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
+
+/**
+ * Converte um texto em inteiro dentro de um intervalo
+ *
+ * @param text Texto a converter
+ * @param min Menor valor aceito
+ * @param max Maior valor aceito
+ * @param value Recebe o valor convertido
+ * @return 0 em caso de sucesso, -1 se o texto for inválido ou estiver fora do intervalo
+ */
+static inline int print_config_parse_long(const char *text, long min, long max, long *value)
+{
+    char *end;
+
+    errno = 0;
+    long v = strtol(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || v < min || v > max)
+    {
+        return -1;
+    }
+    *value = v;
+    return 0;
+}
+
+/**
+ * Atribui uma opção numérica, informando erro se o valor for inválido
+ *
+ * @param name Nome da opção ou variável (para mensagens de erro)
+ * @param text Valor em texto
+ * @param min Menor valor aceito
+ * @param max Maior valor aceito
+ * @param value Recebe o valor convertido
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_config_set(const char *name, const char *text, long min, long max, long *value)
+{
+    if (print_config_parse_long(text, min, max, value) != 0)
+    {
+        fprintf(stderr, "Valor inválido para %s: '%s' (esperado %ld..%ld)\n", name, text, min, max);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Lê uma variável de ambiente numérica, se definida
+ *
+ * @param name Nome da variável
+ * @param min Menor valor aceito
+ * @param max Maior valor aceito
+ * @param value Recebe o valor convertido (inalterado se a variável não existir)
+ * @return 0 em caso de sucesso ou variável ausente, -1 se o valor for inválido
+ */
+static inline int print_config_env(const char *name, long min, long max, long *value)
+{
+    const char *text = getenv(name);
+
+    if (text == NULL)
+    {
+        return 0;
+    }
+    return print_config_set(name, text, min, max, value);
+}
+
+/**
+ * Converte o nome de um formato de resultados
+ *
+ * @param name Nome do formato ("csv" ou "json")
+ * @param format Recebe o formato (PRINT_STATS_*)
+ * @return 0 em caso de sucesso, -1 se o formato for desconhecido
+ */
+static inline int print_config_stats_format(const char *name, int *format)
+{
+    if (strcmp(name, "csv") == 0)
+    {
+        *format = PRINT_STATS_CSV;
+    }
+    else if (strcmp(name, "json") == 0)
+    {
+        *format = PRINT_STATS_JSON;
+    }
+    else
+    {
+        fprintf(stderr, "Formato de resultados inválido: '%s' (esperado csv ou json)\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Converte o nome de um modo de despacho
+ *
+ * @param name Nome do modo ("rr" ou "hash")
+ * @param dispatch Recebe o modo (PRINT_DISPATCH_*)
+ * @return 0 em caso de sucesso, -1 se o modo for desconhecido
+ */
+static inline int print_config_dispatch(const char *name, int *dispatch)
+{
+    if (strcmp(name, "rr") == 0)
+    {
+        *dispatch = PRINT_DISPATCH_RR;
+    }
+    else if (strcmp(name, "hash") == 0)
+    {
+        *dispatch = PRINT_DISPATCH_HASH;
+    }
+    else
+    {
+        fprintf(stderr, "Modo de despacho inválido: '%s' (esperado rr ou hash)\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Converte a distribuição dos tamanhos dos documentos
+ *
+ * @param name Distribuição (uniform, zipf[:s] ou pareto[:alfa])
+ * @param sizes Recebe a distribuição sobre PRINT_MIN_DOC_KB..PRINT_MAX_DOC_KB
+ * @return 0 em caso de sucesso, -1 se a distribuição for inválida
+ */
+static inline int print_config_job_sizes(const char *name, WorkloadDist *sizes)
+{
+    if (workload_dist_parse(name, PRINT_MIN_DOC_KB, PRINT_MAX_DOC_KB, sizes) != 0)
+    {
+        fprintf(stderr, "Distribuição de tamanhos inválida: '%s' (esperado uniform, zipf[:s] ou pareto[:alfa])\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Converte o processo de chegada dos documentos
+ *
+ * @param name Processo (uniform ou bursty[:n])
+ * @param arrivals Recebe o processo de chegada
+ * @return 0 em caso de sucesso, -1 se o processo for inválido
+ */
+static inline int print_config_arrivals(const char *name, WorkloadArrivals *arrivals)
+{
+    if (workload_arrivals_parse(name, arrivals) != 0)
+    {
+        fprintf(stderr, "Processo de chegada inválido: '%s' (esperado uniform ou bursty[:n])\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Converte o número de threads dos estágios do pipeline
+ *
+ * @param text Threads de cada estágio separadas por vírgula (ex: "1,4,2")
+ * @param threads Recebe as threads de cada estágio
+ * @return 0 em caso de sucesso, -1 se o texto for inválido
+ */
+static inline int print_config_stages(const char *text, int *threads)
+{
+    const char *p = text;
+
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        char *end;
+
+        errno = 0;
+        long n = strtol(p, &end, 10);
+        if (errno != 0 || end == p || n < 1 || n > PRINT_MAX_THREADS ||
+            *end != (i == PRINT_PIPELINE_STAGES - 1 ? '\0' : ','))
+        {
+            fprintf(stderr, "Estágios inválidos: '%s' (esperado spool,render,print, cada um 1..%d)\n", text,
+                    PRINT_MAX_THREADS);
+            return -1;
+        }
+        threads[i] = (int)n;
+        p = end + 1;
+    }
+    return 0;
+}
+
+/**
+ * Converte uma lista de CPUs no formato do kernel (ex: "0-3,8,10-11")
+ *
+ * @param text Lista de CPUs ou intervalos separados por vírgula
+ * @param cpus Recebe as CPUs, na ordem da lista (NULL apenas valida)
+ * @param max Capacidade de cpus
+ * @return Número de CPUs da lista, ou -1 se o texto for inválido
+ */
+static inline int print_config_cpu_list(const char *text, int *cpus, int max)
+{
+    const char *p = text;
+    int n = 0;
+
+    for (;;)
+    {
+        char *end;
+
+        errno = 0;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (errno != 0 || end == p || first < 0 || first >= PRINT_MAX_CPUS)
+        {
+            return -1;
+        }
+        if (*end == '-')
+        {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (errno != 0 || end == p || last < first || last >= PRINT_MAX_CPUS)
+            {
+                return -1;
+            }
+        }
+        for (long cpu = first; cpu <= last; cpu++)
+        {
+            if (cpus != NULL && n < max)
+            {
+                cpus[n] = (int)cpu;
+            }
+            n++;
+        }
+        if (*end == '\0' || *end == '\n')
+        {
+            return n;
+        }
+        if (*end != ',')
+        {
+            return -1;
+        }
+        p = end + 1;
+    }
+}
+
+/**
+ * Converte o modo de posicionamento das threads
+ *
+ * @param text none, compact, scatter, queue ou uma lista de CPUs
+ * @param affinity Recebe o modo (PRINT_AFFINITY_*)
+ * @param cpus Recebe a lista de CPUs no modo PRINT_AFFINITY_LIST
+ * @return 0 em caso de sucesso, -1 se o texto for inválido
+ */
+static inline int print_config_affinity(const char *text, int *affinity, const char **cpus)
+{
+    if (strcmp(text, "none") == 0)
+    {
+        *affinity = PRINT_AFFINITY_NONE;
+    }
+    else if (strcmp(text, "compact") == 0)
+    {
+        *affinity = PRINT_AFFINITY_COMPACT;
+    }
+    else if (strcmp(text, "scatter") == 0)
+    {
+        *affinity = PRINT_AFFINITY_SCATTER;
+    }
+    else if (strcmp(text, "queue") == 0)
+    {
+        *affinity = PRINT_AFFINITY_QUEUE;
+    }
+    else if (print_config_cpu_list(text, NULL, 0) > 0)
+    {
+        *affinity = PRINT_AFFINITY_LIST;
+        *cpus = text;
+    }
+    else
+    {
+        fprintf(stderr, "Afinidade inválida: '%s' (esperado none, compact, scatter, queue ou lista de CPUs)\n", text);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Converte os limites do pool elástico de impressoras
+ *
+ * @param text Limites no formato "MIN,MAX" (ex: "1,16")
+ * @param min Recebe o menor número de impressoras
+ * @param max Recebe o maior número de impressoras
+ * @return 0 em caso de sucesso, -1 se o texto for inválido
+ */
+static inline int print_config_elastic(const char *text, int *min, int *max)
+{
+    char *end;
+
+    errno = 0;
+    long lo = strtol(text, &end, 10);
+    if (errno == 0 && end != text && *end == ',')
+    {
+        const char *p = end + 1;
+        long hi = strtol(p, &end, 10);
+
+        if (errno == 0 && end != p && *end == '\0' && lo >= 1 && hi >= lo && hi <= PRINT_MAX_THREADS)
+        {
+            *min = (int)lo;
+            *max = (int)hi;
+            return 0;
+        }
+    }
+    fprintf(stderr, "Pool elástico inválido: '%s' (esperado MIN,MAX com 1 <= MIN <= MAX <= %d)\n", text,
+            PRINT_MAX_THREADS);
+    return -1;
+}
+
+/**
+ * Exibe a ajuda das opções de linha de comando
+ *
+ * @param program Nome do programa
+ */
+static inline void print_config_usage(const char *program)
+{
+    printf("Uso: %s [opções]\n"
+           "  -b, --buffer-size N   Capacidade do buffer, arredondada para potência de dois (PRINT_BUFFER_SIZE, padrão %d)\n"
+           "  -p, --producers N     Número de produtores (PRINT_PRODUCERS, padrão %d)\n"
+           "  -c, --consumers N     Número de impressoras (PRINT_CONSUMERS, padrão %d)\n"
+           "  -d, --documents N     Documentos por produtor (PRINT_DOCUMENTS, padrão %d)\n"
+           "  -B, --batch N         Documentos por lote, monitor e steal --event-loop (PRINT_BATCH_SIZE, padrão %d)\n"
+           "      --bind            Vincula o produtor i à impressora i, monitor\n"
+           "      --compare         Compara os modos de entrega (monitor) ou sem_t e futex (sem)\n"
+           "      --no-sleep        Desativa os atrasos simulados (PRINT_NO_SLEEP=1)\n"
+           "  -q, --quiet           Suprime as mensagens (PRINT_QUIET=1)\n"
+           "      --stats FORMATO   Escreve os resultados em csv ou json (PRINT_STATS)\n"
+           "      --dispatch MODO   Fila de destino em rodízio (rr) ou pelo hash do produtor (hash), steal (PRINT_DISPATCH, padrão rr)\n"
+           "      --payload-kb N    Maior conteúdo por documento em KB, mutex e steal (PRINT_PAYLOAD_KB, padrão %d)\n"
+           "      --journal ARQUIVO Registra os trabalhos em um diário durável e o reexecuta ao iniciar, mutex e steal (PRINT_JOURNAL)\n"
+           "      --journal-interval-us N  Espera máxima do commit em grupo do diário (PRINT_JOURNAL_INTERVAL_US, padrão %d)\n"
+           "      --submit-timeout-ms N    Espera máxima por espaço; ao vencer, o documento é descartado.\n"
+           "                               -1 bloqueia, 0 não espera (PRINT_SUBMIT_TIMEOUT_MS, padrão -1)\n"
+           "      --shards N        Anéis independentes da fila particionada, sharded (PRINT_SHARDS, padrão: processadores)\n"
+           "      --event-loop      Atende as filas das impressoras em uma única thread epoll, steal (PRINT_EVENT_LOOP=1)\n"
+           "      --spool DIR       Grava cada documento no arquivo de spool da impressora com io_uring, mutex e steal (PRINT_SPOOL)\n"
+           "      --seed N          Semente do gerador de carga; repete os mesmos tamanhos e intervalos (PRINT_SEED, padrão %d)\n"
+           "      --job-sizes DIST  Tamanhos de %d a %d KB: uniform, zipf[:s] ou pareto[:alfa] (PRINT_JOB_SIZES, padrão uniform)\n"
+           "      --arrivals MODO   Intervalos entre documentos: uniform ou bursty[:n] (PRINT_ARRIVALS, padrão uniform)\n"
+           "      --record-trace ARQUIVO  Grava o instante, o produtor, o tamanho e o tipo de cada documento criado (PRINT_RECORD_TRACE)\n"
+           "      --replay-trace ARQUIVO  Produtores reproduzem um trace gravado em vez da carga sintética (PRINT_REPLAY_TRACE)\n"
+           "      --trace-speed N   Reproduz o trace N vezes mais rápido; 0 não espera (PRINT_TRACE_SPEED, padrão 1)\n"
+           "      --stages S,R,P    Threads dos estágios spool, render e print, pipeline (PRINT_STAGES, padrão: -c em cada)\n"
+           "      --clients N       Produtores simulados como corrotinas, até %d; substitui -p, coro (PRINT_CLIENTS)\n"
+           "      --workers N       Threads que executam as corrotinas, coro (PRINT_WORKERS, padrão: processadores)\n"
+           "      --coro-stack-kb N Pilha de cada corrotina em KB, %d a %d, coro (PRINT_CORO_STACK_KB, padrão %d)\n"
+           "      --elastic MIN,MAX Ajusta o número de impressoras à carga entre MIN e MAX, mutex (PRINT_ELASTIC)\n"
+           "      --elastic-target-ms N  Espera média na fila que aciona mais impressoras (PRINT_ELASTIC_TARGET_MS, padrão %d)\n"
+           "      --affinity MODO   Fixa produtores e impressoras: none, compact, scatter, queue ou CPUs (ex: 0-3,8) (PRINT_AFFINITY)\n"
+           "      --queue-node N    Nó NUMA do buffer (PRINT_QUEUE_NODE, padrão: nó da primeira impressora)\n"
+           "  -h, --help            Exibe esta ajuda\n",
+           program, PRINT_DEFAULT_BUFFER_SIZE, PRINT_DEFAULT_PRODUCERS, PRINT_DEFAULT_CONSUMERS,
+           PRINT_DEFAULT_DOCUMENTS, PRINT_DEFAULT_BATCH_SIZE, PRINT_DEFAULT_PAYLOAD_KB,
+           PRINT_DEFAULT_JOURNAL_US, WORKLOAD_DEFAULT_SEED, PRINT_MIN_DOC_KB, PRINT_MAX_DOC_KB, PRINT_MAX_CLIENTS,
+           PRINT_MIN_CORO_STACK_KB, PRINT_MAX_CORO_STACK_KB, PRINT_DEFAULT_CORO_STACK_KB, PRINT_DEFAULT_ELASTIC_MS);
+}
+
+/**
+ * Carrega a configuração a partir do ambiente e da linha de comando
+ *
+ * Ordem de precedência: valores padrão, variáveis de ambiente e, por fim, opções
+ * da linha de comando. Uma opção fora de supported é rejeitada; a variável de
+ * ambiente correspondente é ignorada e o campo mantém o valor padrão.
+ *
+ * @param cfg Configuração a preencher
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos
+ * @param supported Opções específicas implementadas pelo programa (PRINT_OPT_*)
+ * @return PRINT_CONFIG_OK, PRINT_CONFIG_EXIT ou PRINT_CONFIG_ERROR
+ */
+static inline int print_config_load(PrintConfig *cfg, int argc, char *argv[], unsigned supported)
+{
+    enum
+    {
+        OPT_COMPARE = 256,
+        OPT_BIND,
+        OPT_NO_SLEEP,
+        OPT_STATS,
+        OPT_DISPATCH,
+        OPT_PAYLOAD,
+        OPT_JOURNAL,
+        OPT_JOURNAL_US,
+        OPT_SUBMIT_TIMEOUT,
+        OPT_SHARDS,
+        OPT_EVENT_LOOP,
+        OPT_SPOOL,
+        OPT_SEED,
+        OPT_JOB_SIZES,
+        OPT_ARRIVALS,
+        OPT_RECORD_TRACE,
+        OPT_REPLAY_TRACE,
+        OPT_TRACE_SPEED,
+        OPT_STAGES,
+        OPT_CLIENTS,
+        OPT_WORKERS,
+        OPT_CORO_STACK,
+        OPT_ELASTIC,
+        OPT_ELASTIC_TARGET,
+        OPT_AFFINITY,
+        OPT_QUEUE_NODE
+    };
+    static const struct option options[] = {
+        {"buffer-size", required_argument, NULL, 'b'},
+        {"producers", required_argument, NULL, 'p'},
+        {"consumers", required_argument, NULL, 'c'},
+        {"documents", required_argument, NULL, 'd'},
+        {"batch", required_argument, NULL, 'B'},
+        {"bind", no_argument, NULL, OPT_BIND},
+        {"compare", no_argument, NULL, OPT_COMPARE},
+        {"no-sleep", no_argument, NULL, OPT_NO_SLEEP},
+        {"quiet", no_argument, NULL, 'q'},
+        {"stats", required_argument, NULL, OPT_STATS},
+        {"dispatch", required_argument, NULL, OPT_DISPATCH},
+        {"payload-kb", required_argument, NULL, OPT_PAYLOAD},
+        {"journal", required_argument, NULL, OPT_JOURNAL},
+        {"journal-interval-us", required_argument, NULL, OPT_JOURNAL_US},
+        {"submit-timeout-ms", required_argument, NULL, OPT_SUBMIT_TIMEOUT},
+        {"shards", required_argument, NULL, OPT_SHARDS},
+        {"event-loop", no_argument, NULL, OPT_EVENT_LOOP},
+        {"spool", required_argument, NULL, OPT_SPOOL},
+        {"seed", required_argument, NULL, OPT_SEED},
+        {"job-sizes", required_argument, NULL, OPT_JOB_SIZES},
+        {"arrivals", required_argument, NULL, OPT_ARRIVALS},
+        {"record-trace", required_argument, NULL, OPT_RECORD_TRACE},
+        {"replay-trace", required_argument, NULL, OPT_REPLAY_TRACE},
+        {"trace-speed", required_argument, NULL, OPT_TRACE_SPEED},
+        {"stages", required_argument, NULL, OPT_STAGES},
+        {"clients", required_argument, NULL, OPT_CLIENTS},
+        {"workers", required_argument, NULL, OPT_WORKERS},
+        {"coro-stack-kb", required_argument, NULL, OPT_CORO_STACK},
+        {"elastic", required_argument, NULL, OPT_ELASTIC},
+        {"elastic-target-ms", required_argument, NULL, OPT_ELASTIC_TARGET},
+        {"affinity", required_argument, NULL, OPT_AFFINITY},
+        {"queue-node", required_argument, NULL, OPT_QUEUE_NODE},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}};
+    static const struct
+    {
+        int opt;          // Código devolvido por getopt_long
+        unsigned mask;    // Grupo da opção (PRINT_OPT_*)
+        const char *name; // Nome para a mensagem de erro
+    } specific[] = {
+        {'B', PRINT_OPT_BATCH, "--batch"},
+        {OPT_BIND, PRINT_OPT_BIND, "--bind"},
+        {OPT_COMPARE, PRINT_OPT_COMPARE, "--compare"},
+        {OPT_DISPATCH, PRINT_OPT_DISPATCH, "--dispatch"},
+        {OPT_PAYLOAD, PRINT_OPT_PAYLOAD, "--payload-kb"},
+        {OPT_JOURNAL, PRINT_OPT_JOURNAL, "--journal"},
+        {OPT_JOURNAL_US, PRINT_OPT_JOURNAL, "--journal-interval-us"},
+        {OPT_SUBMIT_TIMEOUT, PRINT_OPT_SUBMIT_TIMEOUT, "--submit-timeout-ms"},
+        {OPT_SHARDS, PRINT_OPT_SHARDS, "--shards"},
+        {OPT_EVENT_LOOP, PRINT_OPT_EVENT_LOOP, "--event-loop"},
+        {OPT_SPOOL, PRINT_OPT_SPOOL, "--spool"},
+        {OPT_RECORD_TRACE, PRINT_OPT_TRACE, "--record-trace"},
+        {OPT_REPLAY_TRACE, PRINT_OPT_TRACE, "--replay-trace"},
+        {OPT_TRACE_SPEED, PRINT_OPT_TRACE, "--trace-speed"},
+        {OPT_STAGES, PRINT_OPT_STAGES, "--stages"},
+        {OPT_CLIENTS, PRINT_OPT_CORO, "--clients"},
+        {OPT_WORKERS, PRINT_OPT_CORO, "--workers"},
+        {OPT_CORO_STACK, PRINT_OPT_CORO, "--coro-stack-kb"},
+        {OPT_ELASTIC, PRINT_OPT_ELASTIC, "--elastic"},
+        {OPT_ELASTIC_TARGET, PRINT_OPT_ELASTIC, "--elastic-target-ms"},
+        {OPT_AFFINITY, PRINT_OPT_AFFINITY, "--affinity"},
+        {OPT_QUEUE_NODE, PRINT_OPT_AFFINITY, "--queue-node"}};
+
+    long buffer_size = PRINT_DEFAULT_BUFFER_SIZE;
+    long producers = PRINT_DEFAULT_PRODUCERS;
+    long consumers = PRINT_DEFAULT_CONSUMERS;
+    long documents = PRINT_DEFAULT_DOCUMENTS;
+    long batch = PRINT_DEFAULT_BATCH_SIZE;
+    long payload_kb = PRINT_DEFAULT_PAYLOAD_KB;
+    long journal_us = PRINT_DEFAULT_JOURNAL_US;
+    long submit_timeout = -1;
+    long shards = 0;
+    long event_loop = 0;
+    long seed = WORKLOAD_DEFAULT_SEED;
+    long trace_speed = 1;
+    long clients = 0;
+    long workers = 0;
+    long coro_stack_kb = PRINT_DEFAULT_CORO_STACK_KB;
+    long elastic_target_ms = PRINT_DEFAULT_ELASTIC_MS;
+    long queue_node = -1;
+    long no_sleep = 0;
+    long quiet = 0;
+    const char *stats;
+    const char *dispatch;
+    const char *sizes;
+    const char *arrivals;
+    const char *stages;
+    const char *elastic;
+    const char *affinity;
+    int opt;
+
+    memset(cfg, 0, sizeof(*cfg));
+    workload_dist_init(&cfg->job_sizes, WORKLOAD_UNIFORM, PRINT_MIN_DOC_KB, PRINT_MAX_DOC_KB, 0.0);
+    workload_arrivals_parse("uniform", &cfg->arrivals);
+
+    // Variáveis de ambiente
+    if (print_config_env("PRINT_BUFFER_SIZE", 1, PRINT_MAX_BUFFER_SIZE, &buffer_size) != 0 ||
+        print_config_env("PRINT_PRODUCERS", 1, PRINT_MAX_THREADS, &producers) != 0 ||
+        print_config_env("PRINT_CONSUMERS", 1, PRINT_MAX_THREADS, &consumers) != 0 ||
+        print_config_env("PRINT_DOCUMENTS", 0, PRINT_MAX_DOCUMENTS, &documents) != 0 ||
+        print_config_env("PRINT_BATCH_SIZE", 1, PRINT_MAX_BATCH_SIZE, &batch) != 0 ||
+        print_config_env("PRINT_PAYLOAD_KB", 0, PRINT_MAX_PAYLOAD_KB, &payload_kb) != 0 ||
+        print_config_env("PRINT_JOURNAL_INTERVAL_US", 0, PRINT_MAX_JOURNAL_US, &journal_us) != 0 ||
+        print_config_env("PRINT_SUBMIT_TIMEOUT_MS", -1, PRINT_MAX_TIMEOUT_MS, &submit_timeout) != 0 ||
+        print_config_env("PRINT_SHARDS", 0, PRINT_MAX_SHARDS, &shards) != 0 ||
+        print_config_env("PRINT_EVENT_LOOP", 0, 1, &event_loop) != 0 ||
+        print_config_env("PRINT_SEED", 0, LONG_MAX, &seed) != 0 ||
+        print_config_env("PRINT_TRACE_SPEED", 0, PRINT_MAX_TRACE_SPEED, &trace_speed) != 0 ||
+        print_config_env("PRINT_CLIENTS", 0, PRINT_MAX_CLIENTS, &clients) != 0 ||
+        print_config_env("PRINT_WORKERS", 0, PRINT_MAX_THREADS, &workers) != 0 ||
+        print_config_env("PRINT_CORO_STACK_KB", PRINT_MIN_CORO_STACK_KB, PRINT_MAX_CORO_STACK_KB, &coro_stack_kb) != 0 ||
+        print_config_env("PRINT_ELASTIC_TARGET_MS", 1, PRINT_MAX_ELASTIC_MS, &elastic_target_ms) != 0 ||
+        print_config_env("PRINT_QUEUE_NODE", -1, PRINT_MAX_NODES - 1, &queue_node) != 0 ||
+        print_config_env("PRINT_NO_SLEEP", 0, 1, &no_sleep) != 0 ||
+        print_config_env("PRINT_QUIET", 0, 1, &quiet) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((stats = getenv("PRINT_STATS")) != NULL && print_config_stats_format(stats, &cfg->stats_format) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((dispatch = getenv("PRINT_DISPATCH")) != NULL && print_config_dispatch(dispatch, &cfg->dispatch) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((sizes = getenv("PRINT_JOB_SIZES")) != NULL && print_config_job_sizes(sizes, &cfg->job_sizes) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((arrivals = getenv("PRINT_ARRIVALS")) != NULL && print_config_arrivals(arrivals, &cfg->arrivals) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((stages = getenv("PRINT_STAGES")) != NULL && print_config_stages(stages, cfg->stage_threads) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((elastic = getenv("PRINT_ELASTIC")) != NULL &&
+        print_config_elastic(elastic, &cfg->elastic_min, &cfg->elastic_max) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    if ((affinity = getenv("PRINT_AFFINITY")) != NULL &&
+        print_config_affinity(affinity, &cfg->affinity, &cfg->affinity_cpus) != 0)
+    {
+        return PRINT_CONFIG_ERROR;
+    }
+    cfg->journal = getenv("PRINT_JOURNAL");
+    cfg->spool = getenv("PRINT_SPOOL");
+    cfg->record_trace = getenv("PRINT_RECORD_TRACE");
+    cfg->replay_trace = getenv("PRINT_REPLAY_TRACE");
+
+    // Linha de comando
+    optind = 1;
+    while ((opt = getopt_long(argc, argv, "b:p:c:d:B:qh", options, NULL)) != -1)
+    {
+        int ret = 0;
+
+        for (size_t i = 0; i < sizeof(specific) / sizeof(specific[0]); i++)
+        {
+            if (specific[i].opt == opt && !(supported & specific[i].mask))
+            {
+                fprintf(stderr, "Opção %s não suportada por este programa\n", specific[i].name);
+                return PRINT_CONFIG_ERROR;
+            }
+        }
+
+        switch (opt)
+        {
+        case 'b':
+            ret = print_config_set("--buffer-size", optarg, 1, PRINT_MAX_BUFFER_SIZE, &buffer_size);
+            break;
+        case 'p':
+            ret = print_config_set("--producers", optarg, 1, PRINT_MAX_THREADS, &producers);
+            break;
+        case 'c':
+            ret = print_config_set("--consumers", optarg, 1, PRINT_MAX_THREADS, &consumers);
+            break;
+        case 'd':
+            ret = print_config_set("--documents", optarg, 0, PRINT_MAX_DOCUMENTS, &documents);
+            break;
+        case 'B':
+            ret = print_config_set("--batch", optarg, 1, PRINT_MAX_BATCH_SIZE, &batch);
+            break;
+        case OPT_BIND:
+            cfg->bind_printers = 1;
+            break;
+        case OPT_COMPARE:
+            cfg->compare = 1;
+            break;
+        case OPT_NO_SLEEP:
+            no_sleep = 1;
+            break;
+        case 'q':
+            quiet = 1;
+            break;
+        case OPT_STATS:
+            ret = print_config_stats_format(optarg, &cfg->stats_format);
+            break;
+        case OPT_DISPATCH:
+            ret = print_config_dispatch(optarg, &cfg->dispatch);
+            break;
+        case OPT_PAYLOAD:
+            ret = print_config_set("--payload-kb", optarg, 0, PRINT_MAX_PAYLOAD_KB, &payload_kb);
+            break;
+        case OPT_JOURNAL:
+            cfg->journal = optarg;
+            break;
+        case OPT_JOURNAL_US:
+            ret = print_config_set("--journal-interval-us", optarg, 0, PRINT_MAX_JOURNAL_US, &journal_us);
+            break;
+        case OPT_SUBMIT_TIMEOUT:
+            ret = print_config_set("--submit-timeout-ms", optarg, -1, PRINT_MAX_TIMEOUT_MS, &submit_timeout);
+            break;
+        case OPT_SHARDS:
+            ret = print_config_set("--shards", optarg, 0, PRINT_MAX_SHARDS, &shards);
+            break;
+        case OPT_EVENT_LOOP:
+            event_loop = 1;
+            break;
+        case OPT_SPOOL:
+            cfg->spool = optarg;
+            break;
+        case OPT_SEED:
+            ret = print_config_set("--seed", optarg, 0, LONG_MAX, &seed);
+            break;
+        case OPT_JOB_SIZES:
+            ret = print_config_job_sizes(optarg, &cfg->job_sizes);
+            break;
+        case OPT_ARRIVALS:
+            ret = print_config_arrivals(optarg, &cfg->arrivals);
+            break;
+        case OPT_RECORD_TRACE:
+            cfg->record_trace = optarg;
+            break;
+        case OPT_REPLAY_TRACE:
+            cfg->replay_trace = optarg;
+            break;
+        case OPT_TRACE_SPEED:
+            ret = print_config_set("--trace-speed", optarg, 0, PRINT_MAX_TRACE_SPEED, &trace_speed);
+            break;
+        case OPT_STAGES:
+            ret = print_config_stages(optarg, cfg->stage_threads);
+            break;
+        case OPT_CLIENTS:
+            ret = print_config_set("--clients", optarg, 0, PRINT_MAX_CLIENTS, &clients);
+            break;
+        case OPT_WORKERS:
+            ret = print_config_set("--workers", optarg, 0, PRINT_MAX_THREADS, &workers);
+            break;
+        case OPT_CORO_STACK:
+            ret = print_config_set("--coro-stack-kb", optarg, PRINT_MIN_CORO_STACK_KB, PRINT_MAX_CORO_STACK_KB,
+                                   &coro_stack_kb);
+            break;
+        case OPT_ELASTIC:
+            ret = print_config_elastic(optarg, &cfg->elastic_min, &cfg->elastic_max);
+            break;
+        case OPT_ELASTIC_TARGET:
+            ret = print_config_set("--elastic-target-ms", optarg, 1, PRINT_MAX_ELASTIC_MS, &elastic_target_ms);
+            break;
+        case OPT_AFFINITY:
+            ret = print_config_affinity(optarg, &cfg->affinity, &cfg->affinity_cpus);
+            break;
+        case OPT_QUEUE_NODE:
+            ret = print_config_set("--queue-node", optarg, -1, PRINT_MAX_NODES - 1, &queue_node);
+            break;
+        case 'h':
+            print_config_usage(argv[0]);
+            return PRINT_CONFIG_EXIT;
+        default:
+            print_config_usage(argv[0]);
+            return PRINT_CONFIG_ERROR;
+        }
+
+        if (ret != 0)
+        {
+            return PRINT_CONFIG_ERROR;
+        }
+    }
+
+    // Variáveis de ambiente de opções que o programa não implementa
+    if (!(supported & PRINT_OPT_BATCH))
+    {
+        batch = PRINT_DEFAULT_BATCH_SIZE;
+    }
+    if (!(supported & PRINT_OPT_DISPATCH))
+    {
+        cfg->dispatch = PRINT_DISPATCH_RR;
+    }
+    if (!(supported & PRINT_OPT_PAYLOAD))
+    {
+        payload_kb = PRINT_DEFAULT_PAYLOAD_KB;
+    }
+    if (!(supported & PRINT_OPT_JOURNAL))
+    {
+        cfg->journal = NULL;
+    }
+    if (!(supported & PRINT_OPT_SUBMIT_TIMEOUT))
+    {
+        submit_timeout = -1;
+    }
+    if (!(supported & PRINT_OPT_SHARDS))
+    {
+        shards = 0;
+    }
+    if (!(supported & PRINT_OPT_EVENT_LOOP))
+    {
+        event_loop = 0;
+    }
+    if (!(supported & PRINT_OPT_SPOOL))
+    {
+        cfg->spool = NULL;
+    }
+    if (!(supported & PRINT_OPT_TRACE))
+    {
+        cfg->record_trace = NULL;
+        cfg->replay_trace = NULL;
+    }
+    if (!(supported & PRINT_OPT_STAGES))
+    {
+        memset(cfg->stage_threads, 0, sizeof(cfg->stage_threads));
+    }
+    if (!(supported & PRINT_OPT_CORO))
+    {
+        clients = 0;
+        workers = 0;
+    }
+    if (!(supported & PRINT_OPT_ELASTIC))
+    {
+        cfg->elastic_min = 0;
+        cfg->elastic_max = 0;
+    }
+    if (!(supported & PRINT_OPT_AFFINITY))
+    {
+        cfg->affinity = PRINT_AFFINITY_OFF;
+        cfg->affinity_cpus = NULL;
+        queue_node = -1;
+    }
+
+    // Os identificadores (produtor * documentos + sequência, produtores a partir de 1)
+    // são int em todas as implementações e no diário
+    if ((long long)(producers + 1) * documents - 1 > INT_MAX)
+    {
+        fprintf(stderr, "--documents %ld com --producers %ld excede o maior identificador de documento (%d)\n",
+                documents, producers, INT_MAX);
+        return PRINT_CONFIG_ERROR;
+    }
+
+    if (cfg->record_trace != NULL && cfg->replay_trace != NULL)
+    {
+        fprintf(stderr, "--record-trace e --replay-trace não podem ser usados juntos\n");
+        return PRINT_CONFIG_ERROR;
+    }
+
+    cfg->buffer_size = print_config_round_pow2((size_t)buffer_size);
+    cfg->buffer_mask = cfg->buffer_size - 1;
+    cfg->num_producers = (int)producers;
+    cfg->num_consumers = (int)consumers;
+    cfg->max_documents = (int)documents;
+    cfg->batch_size = (int)batch;
+    cfg->payload_size = (size_t)payload_kb * 1024;
+    cfg->journal_us = journal_us;
+    cfg->submit_timeout = submit_timeout;
+    cfg->shards = (int)shards;
+    cfg->event_loop = (int)event_loop;
+    cfg->seed = (uint64_t)seed;
+    cfg->trace_speed = trace_speed;
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        if (cfg->stage_threads[i] == 0)
+        {
+            cfg->stage_threads[i] = cfg->num_consumers;
+        }
+    }
+    cfg->num_clients = (int)clients;
+    cfg->num_workers = (int)workers;
+    cfg->coro_stack_size = (size_t)coro_stack_kb * 1024;
+    cfg->elastic_target_ms = elastic_target_ms;
+    cfg->queue_node = (int)queue_node;
+    cfg->simulate_delays = !no_sleep;
+    cfg->quiet = (int)quiet;
+
+    return PRINT_CONFIG_OK;
+}
+
+#endif // PRINT_CONFIG_H
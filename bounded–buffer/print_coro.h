@@ -0,0 +1,593 @@
+/**
+ * Corrotinas M:N para Simular Muitos Clientes
+ *
+ * Este cabeçalho é usado pela implementação em corrotinas do produtor-consumidor
+ * (print_system_coro.c). Uma thread do sistema por produtor não escala para dezenas
+ * de milhares de aplicações clientes: cada thread reserva uma pilha de 8 MB e cada
+ * espera bloqueia uma entidade do kernel. Aqui cada cliente é uma corrotina com
+ * pilha própria (ucontext), e um pequeno grupo de threads (workers) as executa.
+ *
+ * Características:
+ * - Cada corrotina pertence a um worker, escolhido em rodízio na criação, e sempre
+ *   executa nele; assim variáveis __thread (como o buffer de print_log.h) continuam
+ *   válidas dentro da corrotina
+ * - As pilhas ficam em uma única região mmap com MAP_NORESERVE, sem páginas de
+ *   guarda (uma página de guarda por pilha esgotaria vm.max_map_count com 100 mil
+ *   corrotinas); só as páginas efetivamente tocadas ocupam memória
+ * - Esperas suspendem a corrotina, não a thread: print_coro_wait funciona como
+ *   pthread_cond_wait, com uma lista de corrotinas no lugar da variável de condição,
+ *   e print_coro_sleep põe a corrotina no heap de temporizadores do seu worker
+ * - Acordar uma corrotina de outro worker apenas a insere na fila de prontas dele;
+ *   um worker sem corrotinas prontas dorme na sua variável de condição até a
+ *   próxima corrotina pronta ou o próximo temporizador
+ * - swapcontext da glibc salva a máscara de sinais, uma chamada de sistema por troca
+ *
+ * Suspensão com mutex:
+ * Em print_coro_wait a corrotina se insere na lista com o mutex adquirido e troca de
+ * contexto; o worker só libera o mutex depois que o contexto da corrotina foi salvo.
+ * Quem a acorda precisa do mesmo mutex, portanto nunca a retoma pela metade.
+ *
+ * Uso:
+ *   print_coro_init(workers, corrotinas, pilha); // antes de criar as corrotinas
+ *   print_coro_spawn(funcao, arg);                // antes de print_coro_run
+ *   print_coro_run();                             // retorna quando todas terminam
+ *   print_coro_cleanup();
+ */
+
+#ifndef PRINT_CORO_H
+#define PRINT_CORO_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+
+/**
+ * Corrotina
+ *
+ * Está em no máximo uma lista por vez (fila de prontas, lista de espera ou heap de
+ * temporizadores), por isso um único campo next basta.
+ */
+typedef struct PrintCoro
+{
+    ucontext_t context;             // Contexto salvo enquanto suspensa
+    void (*fn)(void *arg);          // Função da corrotina
+    void *arg;                      // Argumento da função
+    struct PrintCoroWorker *worker; // Worker dono da corrotina
+    struct PrintCoro *next;         // Próxima na fila de prontas ou lista de espera
+    uint64_t wake_ns;               // Instante de despertar (print_coro_sleep)
+    int done;                       // Função retornou
+} PrintCoro;
+
+/**
+ * Lista de corrotinas esperando uma condição (protegida pelo mutex do usuário)
+ */
+typedef struct
+{
+    PrintCoro *head; // Primeira corrotina a acordar
+    PrintCoro *tail; // Última corrotina inserida
+} PrintCoroWaitList;
+
+/**
+ * Worker: thread do sistema que executa as suas corrotinas
+ */
+typedef struct PrintCoroWorker
+{
+    pthread_t thread;              // Thread do worker
+    pthread_mutex_t mutex;         // Protege a fila de prontas e idle
+    pthread_cond_t wakeup;         // Sinaliza corrotina pronta a um worker ocioso
+    PrintCoro *ready_head;         // Fila de prontas
+    PrintCoro *ready_tail;         // Fim da fila de prontas
+    int idle;                      // Worker dormindo em wakeup
+    PrintCoro **sleepers;          // Heap de temporizadores (apenas o dono acessa)
+    size_t num_sleepers;           // Corrotinas no heap
+    int live;                      // Corrotinas do worker ainda não terminadas
+    ucontext_t scheduler;          // Contexto do laço do worker
+    PrintCoro *current;            // Corrotina em execução
+    pthread_mutex_t *unlock_after; // Mutex liberado após suspender a corrotina
+    unsigned long switches;        // Trocas de contexto para corrotinas
+} PrintCoroWorker;
+
+/**
+ * Estado global das corrotinas
+ */
+typedef struct
+{
+    PrintCoroWorker *workers; // Workers
+    int num_workers;          // Número de workers
+    PrintCoro *coros;         // Blocos de controle das corrotinas
+    int max_coros;            // Capacidade de coros
+    int num_coros;            // Corrotinas criadas
+    char *stacks;             // Região das pilhas (max_coros * stack_size)
+    size_t stack_size;        // Pilha de cada corrotina (múltiplo da página)
+} PrintCoroRuntime;
+
+static PrintCoroRuntime print_coro;
+static __thread PrintCoroWorker *print_coro_self;
+
+/**
+ * Instante atual em nanossegundos (CLOCK_MONOTONIC)
+ */
+static inline uint64_t print_coro_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Reserva os workers, os blocos de controle e a região das pilhas
+ *
+ * @param num_workers Número de workers
+ * @param max_coros Maior número de corrotinas
+ * @param stack_size Pilha de cada corrotina (arredondada para a página)
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_coro_init(int num_workers, int max_coros, size_t stack_size)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    pthread_condattr_t attr;
+
+    memset(&print_coro, 0, sizeof(print_coro));
+    print_coro.stack_size = (stack_size + page - 1) & ~(page - 1);
+    print_coro.max_coros = max_coros;
+    print_coro.num_workers = num_workers;
+
+    print_coro.workers = calloc(num_workers, sizeof(PrintCoroWorker));
+    print_coro.coros = calloc(max_coros, sizeof(PrintCoro));
+    if (print_coro.workers == NULL || print_coro.coros == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar %d corrotinas: %s\n", max_coros, strerror(errno));
+        return -1;
+    }
+
+    print_coro.stacks = mmap(NULL, (size_t)max_coros * print_coro.stack_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (print_coro.stacks == MAP_FAILED)
+    {
+        fprintf(stderr, "Falha ao mapear pilhas de %d corrotinas: %s\n", max_coros, strerror(errno));
+        print_coro.stacks = NULL;
+        return -1;
+    }
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    for (int i = 0; i < num_workers; i++)
+    {
+        PrintCoroWorker *w = &print_coro.workers[i];
+
+        if (pthread_mutex_init(&w->mutex, NULL) != 0 || pthread_cond_init(&w->wakeup, &attr) != 0)
+        {
+            pthread_condattr_destroy(&attr);
+            return -1;
+        }
+    }
+    pthread_condattr_destroy(&attr);
+    return 0;
+}
+
+/**
+ * Insere uma corrotina no fim da fila de prontas do seu worker
+ *
+ * Pode ser chamada de qualquer thread ou corrotina.
+ *
+ * @param c Corrotina suspensa
+ */
+static inline void print_coro_wake(PrintCoro *c)
+{
+    PrintCoroWorker *w = c->worker;
+
+    pthread_mutex_lock(&w->mutex);
+    c->next = NULL;
+    if (w->ready_tail != NULL)
+    {
+        w->ready_tail->next = c;
+    }
+    else
+    {
+        w->ready_head = c;
+    }
+    w->ready_tail = c;
+    if (w->idle)
+    {
+        pthread_cond_signal(&w->wakeup);
+    }
+    pthread_mutex_unlock(&w->mutex);
+}
+
+/**
+ * Ponto de entrada das corrotinas (makecontext)
+ */
+static void print_coro_entry(void)
+{
+    PrintCoroWorker *w = print_coro_self;
+    PrintCoro *c = w->current;
+
+    c->fn(c->arg);
+    c->done = 1;
+    setcontext(&w->scheduler);
+}
+
+/**
+ * Cria uma corrotina, pronta para executar quando print_coro_run iniciar
+ *
+ * @param fn Função da corrotina
+ * @param arg Argumento da função
+ * @return 0 em caso de sucesso, -1 se todas as corrotinas já foram criadas
+ */
+static inline int print_coro_spawn(void (*fn)(void *), void *arg)
+{
+    if (print_coro.num_coros >= print_coro.max_coros)
+    {
+        return -1;
+    }
+
+    int index = print_coro.num_coros++;
+    PrintCoro *c = &print_coro.coros[index];
+
+    if (getcontext(&c->context) != 0)
+    {
+        return -1;
+    }
+    c->context.uc_stack.ss_sp = print_coro.stacks + (size_t)index * print_coro.stack_size;
+    c->context.uc_stack.ss_size = print_coro.stack_size;
+    c->context.uc_link = NULL;
+    makecontext(&c->context, print_coro_entry, 0);
+    c->fn = fn;
+    c->arg = arg;
+    c->worker = &print_coro.workers[index % print_coro.num_workers];
+    c->worker->live++;
+    print_coro_wake(c);
+    return 0;
+}
+
+/**
+ * Suspende a corrotina atual, voltando ao laço do worker
+ *
+ * Quem chama já a inseriu na lista ou heap em que deve esperar.
+ */
+static inline void print_coro_suspend(void)
+{
+    PrintCoroWorker *w = print_coro_self;
+
+    swapcontext(&w->current->context, &w->scheduler);
+}
+
+/**
+ * Cede o worker às demais corrotinas prontas
+ */
+static inline void print_coro_yield(void)
+{
+    print_coro_wake(print_coro_self->current);
+    print_coro_suspend();
+}
+
+/**
+ * Suspende a corrotina atual por um intervalo, sem bloquear o worker
+ *
+ * @param us Intervalo em microssegundos
+ */
+static inline void print_coro_sleep(uint64_t us)
+{
+    PrintCoroWorker *w = print_coro_self;
+    PrintCoro *c = w->current;
+    size_t i = w->num_sleepers++;
+
+    // Inserção no heap mínimo por instante de despertar
+    c->wake_ns = print_coro_now() + us * 1000;
+    while (i > 0 && w->sleepers[(i - 1) / 2]->wake_ns > c->wake_ns)
+    {
+        w->sleepers[i] = w->sleepers[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    w->sleepers[i] = c;
+    print_coro_suspend();
+}
+
+/**
+ * Remove do heap a corrotina com o menor instante de despertar
+ *
+ * @param w Worker dono do heap (não vazio)
+ * @return Corrotina removida
+ */
+static inline PrintCoro *print_coro_pop_sleeper(PrintCoroWorker *w)
+{
+    PrintCoro *top = w->sleepers[0];
+    PrintCoro *last = w->sleepers[--w->num_sleepers];
+    size_t i = 0;
+
+    for (;;)
+    {
+        size_t child = 2 * i + 1;
+        if (child >= w->num_sleepers)
+        {
+            break;
+        }
+        if (child + 1 < w->num_sleepers && w->sleepers[child + 1]->wake_ns < w->sleepers[child]->wake_ns)
+        {
+            child++;
+        }
+        if (w->sleepers[child]->wake_ns >= last->wake_ns)
+        {
+            break;
+        }
+        w->sleepers[i] = w->sleepers[child];
+        i = child;
+    }
+    w->sleepers[i] = last;
+    return top;
+}
+
+/**
+ * Espera em uma lista até ser acordada, como pthread_cond_wait
+ *
+ * Deve ser chamada por uma corrotina com o mutex adquirido; o mutex é liberado
+ * enquanto ela está suspensa e adquirido de novo antes de retornar. Como em
+ * pthread_cond_wait, a condição deve ser verificada novamente.
+ *
+ * @param list Lista de espera protegida pelo mutex
+ * @param mutex Mutex adquirido pela corrotina
+ */
+static inline void print_coro_wait(PrintCoroWaitList *list, pthread_mutex_t *mutex)
+{
+    PrintCoroWorker *w = print_coro_self;
+    PrintCoro *c = w->current;
+
+    c->next = NULL;
+    if (list->tail != NULL)
+    {
+        list->tail->next = c;
+    }
+    else
+    {
+        list->head = c;
+    }
+    list->tail = c;
+
+    w->unlock_after = mutex;
+    print_coro_suspend();
+    pthread_mutex_lock(mutex);
+}
+
+/**
+ * Acorda a corrotina mais antiga da lista (com o mutex da lista adquirido)
+ *
+ * @param list Lista de espera
+ */
+static inline void print_coro_signal(PrintCoroWaitList *list)
+{
+    PrintCoro *c = list->head;
+
+    if (c != NULL)
+    {
+        list->head = c->next;
+        if (list->head == NULL)
+        {
+            list->tail = NULL;
+        }
+        print_coro_wake(c);
+    }
+}
+
+/**
+ * Acorda todas as corrotinas da lista (com o mutex da lista adquirido)
+ *
+ * @param list Lista de espera
+ */
+static inline void print_coro_broadcast(PrintCoroWaitList *list)
+{
+    PrintCoro *c = list->head;
+
+    list->head = NULL;
+    list->tail = NULL;
+    while (c != NULL)
+    {
+        PrintCoro *next = c->next;
+        print_coro_wake(c);
+        c = next;
+    }
+}
+
+/**
+ * Próxima corrotina a executar no worker, dormindo enquanto não houver nenhuma
+ *
+ * @param w Worker
+ * @return Corrotina pronta ou NULL quando todas as corrotinas do worker terminaram
+ */
+static inline PrintCoro *print_coro_next(PrintCoroWorker *w)
+{
+    PrintCoro *c = NULL;
+
+    pthread_mutex_lock(&w->mutex);
+    for (;;)
+    {
+        // Temporizadores vencidos entram no fim da fila de prontas
+        uint64_t now = print_coro_now();
+        while (w->num_sleepers > 0 && w->sleepers[0]->wake_ns <= now)
+        {
+            PrintCoro *s = print_coro_pop_sleeper(w);
+            s->next = NULL;
+            if (w->ready_tail != NULL)
+            {
+                w->ready_tail->next = s;
+            }
+            else
+            {
+                w->ready_head = s;
+            }
+            w->ready_tail = s;
+        }
+
+        if (w->ready_head != NULL)
+        {
+            c = w->ready_head;
+            w->ready_head = c->next;
+            if (w->ready_head == NULL)
+            {
+                w->ready_tail = NULL;
+            }
+            break;
+        }
+        if (w->live == 0)
+        {
+            break;
+        }
+
+        w->idle = 1;
+        if (w->num_sleepers > 0)
+        {
+            uint64_t due = w->sleepers[0]->wake_ns;
+            struct timespec ts = {(time_t)(due / 1000000000ULL), (long)(due % 1000000000ULL)};
+            pthread_cond_timedwait(&w->wakeup, &w->mutex, &ts);
+        }
+        else
+        {
+            pthread_cond_wait(&w->wakeup, &w->mutex);
+        }
+        w->idle = 0;
+    }
+    pthread_mutex_unlock(&w->mutex);
+    return c;
+}
+
+/**
+ * Laço de um worker: executa as suas corrotinas até que todas terminem
+ *
+ * @param arg Worker
+ * @return NULL
+ */
+static void *print_coro_worker_main(void *arg)
+{
+    PrintCoroWorker *w = arg;
+    PrintCoro *c;
+
+    print_coro_self = w;
+    while ((c = print_coro_next(w)) != NULL)
+    {
+        w->current = c;
+        w->switches++;
+        swapcontext(&w->scheduler, &c->context);
+        w->current = NULL;
+
+        // Contexto da corrotina já salvo: quem a acordar pode retomá-la
+        if (w->unlock_after != NULL)
+        {
+            pthread_mutex_unlock(w->unlock_after);
+            w->unlock_after = NULL;
+        }
+        if (c->done)
+        {
+            w->live--;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Inicia os workers e aguarda o término de todas as corrotinas
+ *
+ * @return 0 em caso de sucesso, -1 se algum worker não puder ser criado (os workers
+ *         já iniciados continuam; o programa deve encerrar)
+ */
+static inline int print_coro_run(void)
+{
+    for (int i = 0; i < print_coro.num_workers; i++)
+    {
+        PrintCoroWorker *w = &print_coro.workers[i];
+
+        // Cada corrotina está em no máximo um heap, o do seu worker
+        w->sleepers = calloc(w->live > 0 ? w->live : 1, sizeof(PrintCoro *));
+        if (w->sleepers == NULL)
+        {
+            fprintf(stderr, "Falha ao alocar temporizadores: %s\n", strerror(errno));
+            return -1;
+        }
+    }
+    for (int i = 0; i < print_coro.num_workers; i++)
+    {
+        // Sem um worker, as suas corrotinas nunca executariam e as demais esperariam por elas
+        if (pthread_create(&print_coro.workers[i].thread, NULL, print_coro_worker_main, &print_coro.workers[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar worker %d: %s\n", i, strerror(errno));
+            return -1;
+        }
+    }
+    for (int i = 0; i < print_coro.num_workers; i++)
+    {
+        pthread_join(print_coro.workers[i].thread, NULL);
+    }
+    return 0;
+}
+
+/**
+ * Memória residente das pilhas das corrotinas criadas (mincore)
+ *
+ * @return Bytes das pilhas efetivamente ocupados, ou 0 se não for possível medir
+ */
+static inline size_t print_coro_stack_resident(void)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = (size_t)print_coro.num_coros * print_coro.stack_size;
+    size_t pages = length / page;
+    size_t resident = 0;
+    unsigned char *vec;
+
+    if (pages == 0 || (vec = malloc(pages)) == NULL)
+    {
+        return 0;
+    }
+    if (mincore(print_coro.stacks, length, vec) == 0)
+    {
+        for (size_t i = 0; i < pages; i++)
+        {
+            resident += vec[i] & 1;
+        }
+    }
+    free(vec);
+    return resident * page;
+}
+
+/**
+ * Total de trocas de contexto para corrotinas em todos os workers
+ *
+ * @return Trocas de contexto (chamar depois de print_coro_run)
+ */
+static inline unsigned long print_coro_switches(void)
+{
+    unsigned long total = 0;
+
+    for (int i = 0; i < print_coro.num_workers; i++)
+    {
+        total += print_coro.workers[i].switches;
+    }
+    return total;
+}
+
+/**
+ * Libera os workers, as corrotinas e a região das pilhas
+ */
+static inline void print_coro_cleanup(void)
+{
+    for (int i = 0; i < print_coro.num_workers && print_coro.workers != NULL; i++)
+    {
+        pthread_mutex_destroy(&print_coro.workers[i].mutex);
+        pthread_cond_destroy(&print_coro.workers[i].wakeup);
+        free(print_coro.workers[i].sleepers);
+    }
+    if (print_coro.stacks != NULL)
+    {
+        munmap(print_coro.stacks, (size_t)print_coro.max_coros * print_coro.stack_size);
+    }
+    free(print_coro.workers);
+    free(print_coro.coros);
+    memset(&print_coro, 0, sizeof(print_coro));
+}
+
+#endif // PRINT_CORO_H
@@ -0,0 +1,84 @@
+/**
+ * Prazos para Operações com Espera Limitada
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * As operações *_until da fila recebem um prazo absoluto em CLOCK_REALTIME, o
+ * relógio usado por pthread_cond_timedwait, sem_timedwait e FUTEX_WAIT_BITSET com
+ * FUTEX_CLOCK_REALTIME. Um prazo nulo (NULL) espera indefinidamente; um prazo já
+ * vencido (print_deadline_now) não espera, o que implementa as operações try_*.
+ */
+
+#ifndef PRINT_DEADLINE_H
+#define PRINT_DEADLINE_H
+
+#include <time.h>
+
+/**
+ * Prazo já vencido: a operação só tem sucesso se puder ser feita sem esperar
+ */
+static const struct timespec print_deadline_now = {0, 0};
+
+/**
+ * Calcula o prazo a partir de agora
+ *
+ * @param timeout_ms Espera máxima em milissegundos
+ * @param deadline Recebe o prazo absoluto (CLOCK_REALTIME)
+ * @return deadline, para uso direto como argumento
+ */
+static inline const struct timespec *print_deadline_in(long timeout_ms, struct timespec *deadline)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += timeout_ms / 1000;
+    deadline->tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+/**
+ * Prazo correspondente a uma espera máxima configurada (--submit-timeout-ms)
+ *
+ * @param timeout_ms Espera máxima: negativa espera indefinidamente, 0 não espera
+ * @param deadline Área para o prazo calculado
+ * @return NULL, print_deadline_now ou deadline
+ */
+static inline const struct timespec *print_deadline_for(long timeout_ms, struct timespec *deadline)
+{
+    if (timeout_ms < 0)
+    {
+        return NULL;
+    }
+    if (timeout_ms == 0)
+    {
+        return &print_deadline_now;
+    }
+    return print_deadline_in(timeout_ms, deadline);
+}
+
+/**
+ * Verifica se um prazo venceu
+ *
+ * @param deadline Prazo absoluto (NULL nunca vence)
+ * @return 1 se o prazo venceu, 0 caso contrário
+ */
+static inline int print_deadline_expired(const struct timespec *deadline)
+{
+    struct timespec now;
+
+    if (deadline == NULL)
+    {
+        return 0;
+    }
+    if (deadline->tv_sec == 0 && deadline->tv_nsec == 0)
+    {
+        return 1;
+    }
+    clock_gettime(CLOCK_REALTIME, &now);
+    return now.tv_sec > deadline->tv_sec ||
+           (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+
+#endif // PRINT_DEADLINE_H
@@ -0,0 +1,183 @@
+/**
+ * Semáforo Contador Leve Baseado em Futex
+ *
+ * Este cabeçalho implementa um semáforo contador em espaço de usuário sobre futexes
+ * do Linux, usado por print_system_sem.c no lugar de sem_t quando compilado com
+ * -DUSE_FUTEX_SEM (e sempre disponível para a comparação --compare).
+ *
+ * Características:
+ * - Caminho rápido atômico: wait decrementa o contador com CAS e post o incrementa,
+ *   sem chamada de sistema quando não há disputa
+ * - Contagem de threads em espera: post só chama FUTEX_WAKE se houver alguém
+ *   bloqueado, e wait só chama FUTEX_WAIT com o contador em zero
+ * - Futexes privados ao processo (FUTEX_PRIVATE_FLAG)
+ *
+ * Correção da espera:
+ * A thread que vai dormir incrementa waiters antes de reler o contador; post
+ * incrementa o contador antes de ler waiters. Com ordenação sequencial, ao menos um
+ * dos dois enxerga a escrita do outro: ou wait vê o contador positivo, ou post vê
+ * a thread em espera e a acorda. Se o FUTEX_WAKE chegar antes do FUTEX_WAIT, o
+ * kernel recusa a espera (EAGAIN) porque o contador já não é zero.
+ */
+
+#ifndef PRINT_FUTEX_H
+#define PRINT_FUTEX_H
+
+#include <errno.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/**
+ * Semáforo contador sobre futex
+ */
+typedef struct
+{
+    atomic_int value;   // Contador do semáforo (palavra do futex)
+    atomic_int waiters; // Threads bloqueadas ou prestes a bloquear
+} FutexSem;
+
+/**
+ * Chamada de sistema futex (não há invólucro na glibc)
+ */
+static inline long futex_call(atomic_int *addr, int op, int value)
+{
+    return syscall(SYS_futex, (int *)addr, op | FUTEX_PRIVATE_FLAG, value, NULL, NULL, 0);
+}
+
+/**
+ * Espera no futex até um prazo absoluto em CLOCK_REALTIME
+ *
+ * FUTEX_WAIT mede o tempo de forma relativa; FUTEX_WAIT_BITSET com
+ * FUTEX_CLOCK_REALTIME aceita o prazo absoluto usado por sem_timedwait.
+ */
+static inline long futex_call_until(atomic_int *addr, int value, const struct timespec *deadline)
+{
+    return syscall(SYS_futex, (int *)addr, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG | FUTEX_CLOCK_REALTIME,
+                   value, deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+/**
+ * Inicializa o semáforo
+ *
+ * @param s Semáforo
+ * @param value Valor inicial
+ * @return 0 em caso de sucesso, -1 se o valor exceder INT_MAX
+ */
+static inline int futex_sem_init(FutexSem *s, unsigned value)
+{
+    if (value > INT_MAX)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    atomic_init(&s->value, (int)value);
+    atomic_init(&s->waiters, 0);
+    return 0;
+}
+
+/**
+ * Libera o semáforo (nada a liberar; mantido por simetria com sem_destroy)
+ */
+static inline int futex_sem_destroy(FutexSem *s)
+{
+    (void)s;
+    return 0;
+}
+
+/**
+ * Tenta decrementar o contador sem bloquear
+ *
+ * @return 1 se decrementou, 0 se o contador estava em zero
+ */
+static inline int futex_sem_trywait(FutexSem *s)
+{
+    int v = atomic_load_explicit(&s->value, memory_order_relaxed);
+
+    while (v > 0)
+    {
+        if (atomic_compare_exchange_weak_explicit(&s->value, &v, v - 1,
+                                                  memory_order_acquire, memory_order_relaxed))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Decrementa o contador, bloqueando no futex enquanto ele estiver em zero
+ *
+ * @param s Semáforo
+ * @return 0 (mesma convenção de sem_wait)
+ */
+static inline int futex_sem_wait(FutexSem *s)
+{
+    if (futex_sem_trywait(s))
+    {
+        return 0;
+    }
+
+    atomic_fetch_add(&s->waiters, 1);
+    while (!futex_sem_trywait(s))
+    {
+        // Dorme apenas se o contador ainda for zero; EAGAIN e EINTR repetem o laço
+        futex_call(&s->value, FUTEX_WAIT, 0);
+    }
+    atomic_fetch_sub(&s->waiters, 1);
+    return 0;
+}
+
+/**
+ * Decrementa o contador, bloqueando no futex no máximo até o prazo
+ *
+ * @param s Semáforo
+ * @param deadline Prazo absoluto (CLOCK_REALTIME)
+ * @return 0, ou -1 com errno = ETIMEDOUT se o prazo venceu (mesma convenção de sem_timedwait)
+ */
+static inline int futex_sem_timedwait(FutexSem *s, const struct timespec *deadline)
+{
+    if (futex_sem_trywait(s))
+    {
+        return 0;
+    }
+
+    int ret = 0;
+    atomic_fetch_add(&s->waiters, 1);
+    while (!futex_sem_trywait(s))
+    {
+        // EAGAIN e EINTR repetem o laço; ETIMEDOUT encerra a espera
+        if (futex_call_until(&s->value, 0, deadline) != 0 && errno == ETIMEDOUT)
+        {
+            ret = futex_sem_trywait(s) ? 0 : -1;
+            break;
+        }
+    }
+    atomic_fetch_sub(&s->waiters, 1);
+    if (ret != 0)
+    {
+        errno = ETIMEDOUT;
+    }
+    return ret;
+}
+
+/**
+ * Incrementa o contador e acorda uma thread em espera, se houver
+ *
+ * @param s Semáforo
+ * @return 0 (mesma convenção de sem_post)
+ */
+static inline int futex_sem_post(FutexSem *s)
+{
+    atomic_fetch_add(&s->value, 1);
+    if (atomic_load(&s->waiters) > 0)
+    {
+        futex_call(&s->value, FUTEX_WAKE, 1);
+    }
+    return 0;
+}
+
+#endif // PRINT_FUTEX_H
@@ -0,0 +1,194 @@
+/**
+ * Histograma de Latências no Estilo HDR
+ *
+ * Este cabeçalho é usado por print_stats.h. Em vez de guardar cada amostra, cada
+ * thread conta as latências em um histograma de tamanho fixo com buckets
+ * log-lineares: cada potência de dois é dividida em PRINT_HDR_SUB_BUCKETS partes
+ * iguais, de modo que o erro relativo de qualquer valor registrado é no máximo
+ * 1/PRINT_HDR_SUB_BUCKETS (~1,6%), de nanossegundos a séculos.
+ *
+ * Características:
+ * - Registro em tempo constante, sem alocação e sem locks: cada histograma tem um
+ *   único escritor, que incrementa os contadores com leitura e escrita atômicas
+ *   relaxadas (sem instrução de lock)
+ * - Outra thread pode ler um histograma em uso (relatório por SIGUSR1): os
+ *   contadores lidos são valores recentes, sem corrupção
+ * - Histogramas de várias threads são somados para o cálculo dos percentis
+ */
+
+#ifndef PRINT_HDR_H
+#define PRINT_HDR_H
+
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/**
+ * Parâmetros do histograma (PRINT_HDR_BUCKETS cobre todo o intervalo de uint64_t)
+ */
+#define PRINT_HDR_SUB_BITS 6                            // log2 dos sub-buckets por potência de dois
+#define PRINT_HDR_SUB_BUCKETS (1 << PRINT_HDR_SUB_BITS) // Sub-buckets por potência de dois
+#define PRINT_HDR_BUCKETS ((64 - PRINT_HDR_SUB_BITS + 1) * PRINT_HDR_SUB_BUCKETS)
+
+/**
+ * Histograma de latências em nanossegundos
+ */
+typedef struct
+{
+    _Atomic uint64_t counts[PRINT_HDR_BUCKETS]; // Amostras por bucket
+    _Atomic uint64_t total;                     // Total de amostras
+    _Atomic uint64_t max;                       // Maior valor registrado
+} PrintHdrHistogram;
+
+/**
+ * Bucket de um valor
+ *
+ * Valores menores que PRINT_HDR_SUB_BUCKETS têm bucket próprio; os demais usam os
+ * PRINT_HDR_SUB_BITS bits após o bit mais significativo.
+ *
+ * @param value Valor em nanossegundos
+ */
+static inline int print_hdr_index(uint64_t value)
+{
+    if (value < PRINT_HDR_SUB_BUCKETS)
+    {
+        return (int)value;
+    }
+
+    int msb = 63 - __builtin_clzll(value);
+    int shift = msb - PRINT_HDR_SUB_BITS;
+    return (msb - PRINT_HDR_SUB_BITS + 1) * PRINT_HDR_SUB_BUCKETS +
+           (int)((value >> shift) - PRINT_HDR_SUB_BUCKETS);
+}
+
+/**
+ * Maior valor representado por um bucket
+ *
+ * @param index Bucket
+ */
+static inline uint64_t print_hdr_value(int index)
+{
+    if (index < PRINT_HDR_SUB_BUCKETS)
+    {
+        return (uint64_t)index;
+    }
+
+    int shift = index / PRINT_HDR_SUB_BUCKETS - 1;
+    uint64_t mantissa = (uint64_t)(index % PRINT_HDR_SUB_BUCKETS + PRINT_HDR_SUB_BUCKETS);
+    return (mantissa << shift) + ((1ULL << shift) - 1);
+}
+
+/**
+ * Incrementa um contador de escritor único sem instrução atômica de leitura-escrita
+ */
+static inline void print_hdr_bump(_Atomic uint64_t *counter)
+{
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+/**
+ * Registra um valor
+ *
+ * Chamada apenas pela thread dona do histograma.
+ *
+ * @param h Histograma
+ * @param value Valor em nanossegundos
+ */
+static inline void print_hdr_record(PrintHdrHistogram *h, uint64_t value)
+{
+    print_hdr_bump(&h->counts[print_hdr_index(value)]);
+    print_hdr_bump(&h->total);
+    if (value > atomic_load_explicit(&h->max, memory_order_relaxed))
+    {
+        atomic_store_explicit(&h->max, value, memory_order_relaxed);
+    }
+}
+
+/**
+ * Soma um histograma a outro
+ *
+ * A origem pode estar em uso pela thread dona.
+ *
+ * @param dst Histograma acumulador (não compartilhado)
+ * @param src Histograma somado
+ */
+static inline void print_hdr_merge(PrintHdrHistogram *dst, const PrintHdrHistogram *src)
+{
+    uint64_t total = 0;
+
+    for (int i = 0; i < PRINT_HDR_BUCKETS; i++)
+    {
+        uint64_t n = atomic_load_explicit(&src->counts[i], memory_order_relaxed);
+        if (n)
+        {
+            atomic_store_explicit(&dst->counts[i],
+                                  atomic_load_explicit(&dst->counts[i], memory_order_relaxed) + n,
+                                  memory_order_relaxed);
+            total += n;
+        }
+    }
+
+    // O total é recalculado pelos buckets para ser coerente com eles
+    atomic_store_explicit(&dst->total, atomic_load_explicit(&dst->total, memory_order_relaxed) + total,
+                          memory_order_relaxed);
+    uint64_t max = atomic_load_explicit(&src->max, memory_order_relaxed);
+    if (max > atomic_load_explicit(&dst->max, memory_order_relaxed))
+    {
+        atomic_store_explicit(&dst->max, max, memory_order_relaxed);
+    }
+}
+
+/**
+ * Percentil de um histograma (método do posto mais próximo)
+ *
+ * O resultado é o maior valor do bucket que contém a amostra do posto, limitado
+ * ao maior valor registrado.
+ *
+ * @param h Histograma
+ * @param percentile Percentil desejado (0-100)
+ * @return Valor em nanossegundos (0 se o histograma estiver vazio)
+ */
+static inline uint64_t print_hdr_percentile(const PrintHdrHistogram *h, double percentile)
+{
+    uint64_t total = atomic_load_explicit(&h->total, memory_order_relaxed);
+    uint64_t max = atomic_load_explicit(&h->max, memory_order_relaxed);
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)(percentile / 100.0 * total + 0.999999);
+    rank = rank == 0 ? 1 : rank > total ? total : rank;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < PRINT_HDR_BUCKETS; i++)
+    {
+        seen += atomic_load_explicit(&h->counts[i], memory_order_relaxed);
+        if (seen >= rank)
+        {
+            uint64_t value = print_hdr_value(i);
+            return value < max ? value : max;
+        }
+    }
+    return max;
+}
+
+/**
+ * Total de amostras de um histograma
+ */
+static inline uint64_t print_hdr_count(const PrintHdrHistogram *h)
+{
+    return atomic_load_explicit(&h->total, memory_order_relaxed);
+}
+
+/**
+ * Zera um histograma
+ */
+static inline void print_hdr_reset(PrintHdrHistogram *h)
+{
+    memset(h, 0, sizeof(*h));
+}
+
+#endif // PRINT_HDR_H
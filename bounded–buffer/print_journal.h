@@ -0,0 +1,486 @@
+/**
+ * Diário Durável dos Trabalhos de Impressão com Commit em Grupo
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * Sem o diário, todo documento no buffer se perde se o servidor de impressão cair.
+ * Com ele, cada submissão é registrada em um arquivo somente de acréscimo antes de
+ * ser aceita, cada impressão concluída é registrada depois, e na inicialização os
+ * trabalhos submetidos e não concluídos são reexecutados.
+ *
+ * Commit em Grupo:
+ * - As threads acrescentam registros a um buffer em memória e recebem um número de
+ *   sequência (LSN); quem precisa de durabilidade espera o LSN se tornar durável
+ * - Uma thread de commit grava o buffer inteiro com um único write e um único
+ *   fdatasync, e acorda todos os registros do grupo de uma vez
+ * - O commit espera até o intervalo configurado para juntar mais registros, mas
+ *   grava imediatamente se o buffer encher ou se todas as threads que submetem
+ *   trabalhos já estiverem esperando (não chegarão mais submissões)
+ * - Dois buffers alternados: enquanto um é gravado, o outro recebe novos registros
+ *
+ * Formato:
+ * - Registros de tamanho fixo com marca e soma de verificação; na leitura, um
+ *   registro incompleto ou corrompido no final (queda durante a escrita) encerra a
+ *   reexecução
+ * - Na abertura, os trabalhos pendentes são regravados em um arquivo temporário que
+ *   substitui o diário com rename, de modo que o diário não cresce entre execuções
+ *
+ * Uso:
+ *   print_journal_replay(caminho, &pendentes, &n);          // trabalhos a reexecutar
+ *   print_journal_open(caminho, intervalo_us, escritores, pendentes, n);
+ *   lsn = print_journal_append(&registro);                   // qualquer thread
+ *   print_journal_wait(lsn);                                  // espera durabilidade
+ *   print_journal_close();
+ */
+
+#ifndef PRINT_JOURNAL_H
+#define PRINT_JOURNAL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stddef.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Parâmetros do diário
+ */
+#define PRINT_JOURNAL_BATCH 1024        // Registros por buffer (maior grupo por commit)
+#define PRINT_JOURNAL_TYPE_LENGTH 20    // Tamanho do tipo do documento no registro
+#define PRINT_JOURNAL_MAGIC 0x4c4e524au // Marca de registro válido ("JRNL")
+
+/**
+ * Tipos de registro
+ */
+#define PRINT_JOURNAL_SUBMIT 1 // Trabalho aceito na fila
+#define PRINT_JOURNAL_DONE 2   // Trabalho impresso
+
+/**
+ * Registro do diário
+ */
+typedef struct
+{
+    uint32_t magic;                       // PRINT_JOURNAL_MAGIC
+    uint32_t kind;                        // PRINT_JOURNAL_SUBMIT ou PRINT_JOURNAL_DONE
+    uint64_t job;                         // Número do trabalho (atribuído na submissão)
+    int32_t doc_id;                       // Identificador do documento
+    int32_t size;                         // Tamanho do documento em KB
+    int32_t producer_id;                  // Produtor que submeteu o documento
+    char type[PRINT_JOURNAL_TYPE_LENGTH]; // Tipo do documento
+    uint32_t checksum;                    // FNV-1a dos campos anteriores
+} PrintJournalRecord;
+
+/**
+ * Estado do diário
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;         // Protege os campos abaixo
+    pthread_cond_t work;           // Acorda a thread de commit
+    pthread_cond_t durable;        // Sinaliza commit concluído ou buffer liberado
+    PrintJournalRecord *pending;   // Buffer que recebe registros
+    PrintJournalRecord *flushing;  // Buffer em gravação
+    size_t count;                  // Registros em pending
+    uint64_t appended;             // LSN do último registro acrescentado
+    uint64_t durable_lsn;          // LSN do último registro durável
+    int waiters;                   // Threads esperando durabilidade
+    int writers;                   // Threads que submetem trabalhos
+    int stop;                      // Encerra a thread de commit
+    int failed;                    // Falha de escrita: o diário não é mais durável
+    int fd;                        // Arquivo do diário
+    long interval_us;              // Espera máxima para juntar registros
+    pthread_t committer;           // Thread de commit
+    atomic_uint_fast64_t next_job; // Próximo número de trabalho
+    unsigned long commits;         // Chamadas a fdatasync
+    unsigned long records;         // Registros gravados
+} PrintJournal;
+
+static PrintJournal print_journal;
+
+/**
+ * Soma de verificação de um registro (FNV-1a de 32 bits)
+ *
+ * @param rec Registro
+ */
+static inline uint32_t print_journal_checksum(const PrintJournalRecord *rec)
+{
+    const unsigned char *bytes = (const unsigned char *)rec;
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < offsetof(PrintJournalRecord, checksum); i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Escreve um bloco inteiro, repetindo escritas parciais
+ *
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_journal_write_all(int fd, const void *data, size_t length)
+{
+    const char *p = data;
+
+    while (length > 0)
+    {
+        ssize_t n = write(fd, p, length);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        length -= (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * Compara números de trabalho (qsort/bsearch)
+ */
+static inline int print_journal_compare_jobs(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Lê o diário e obtém os trabalhos submetidos e não concluídos
+ *
+ * Também ajusta o próximo número de trabalho para depois do maior encontrado.
+ *
+ * @param path Arquivo do diário (inexistente = nenhum trabalho pendente)
+ * @param jobs Recebe os registros de submissão pendentes, em ordem de submissão (liberar com free)
+ * @param num_jobs Recebe o número de trabalhos pendentes
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_journal_replay(const char *path, PrintJournalRecord **jobs, size_t *num_jobs)
+{
+    PrintJournalRecord rec;
+    PrintJournalRecord *submits = NULL;
+    uint64_t *done = NULL;
+    size_t num_submits = 0, num_done = 0, capacity = 0, done_capacity = 0;
+    uint64_t max_job = 0;
+
+    *jobs = NULL;
+    *num_jobs = 0;
+    atomic_init(&print_journal.next_job, 1);
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return errno == ENOENT ? 0 : -1;
+    }
+
+    while (fread(&rec, sizeof(rec), 1, file) == 1)
+    {
+        // Registro parcial ou corrompido: fim da parte durável do diário
+        if (rec.magic != PRINT_JOURNAL_MAGIC || rec.checksum != print_journal_checksum(&rec))
+        {
+            fprintf(stderr, "Diário %s: registro inválido na posição %ld, ignorando o restante\n",
+                    path, ftell(file) - (long)sizeof(rec));
+            break;
+        }
+        max_job = rec.job > max_job ? rec.job : max_job;
+
+        if (rec.kind == PRINT_JOURNAL_SUBMIT)
+        {
+            if (num_submits == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 64;
+                PrintJournalRecord *grown = realloc(submits, capacity * sizeof(rec));
+                if (grown == NULL)
+                {
+                    goto fail;
+                }
+                submits = grown;
+            }
+            submits[num_submits++] = rec;
+        }
+        else if (rec.kind == PRINT_JOURNAL_DONE)
+        {
+            if (num_done == done_capacity)
+            {
+                done_capacity = done_capacity ? done_capacity * 2 : 64;
+                uint64_t *grown = realloc(done, done_capacity * sizeof(uint64_t));
+                if (grown == NULL)
+                {
+                    goto fail;
+                }
+                done = grown;
+            }
+            done[num_done++] = rec.job;
+        }
+    }
+    fclose(file);
+
+    // Mantém apenas as submissões sem registro de conclusão
+    if (num_done > 0)
+    {
+        qsort(done, num_done, sizeof(uint64_t), print_journal_compare_jobs);
+    }
+    for (size_t i = 0; i < num_submits; i++)
+    {
+        if (num_done == 0 ||
+            bsearch(&submits[i].job, done, num_done, sizeof(uint64_t), print_journal_compare_jobs) == NULL)
+        {
+            submits[(*num_jobs)++] = submits[i];
+        }
+    }
+
+    free(done);
+    *jobs = submits;
+    atomic_store(&print_journal.next_job, max_job + 1);
+    return 0;
+
+fail:
+    fprintf(stderr, "Falha ao alocar memória para reexecutar o diário %s\n", path);
+    fclose(file);
+    free(submits);
+    free(done);
+    return -1;
+}
+
+/**
+ * Thread de commit: grava os registros acumulados com um fdatasync por grupo
+ */
+static inline void *print_journal_committer(void *arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&print_journal.mutex);
+
+    for (;;)
+    {
+        while (print_journal.count == 0 && !print_journal.stop)
+        {
+            pthread_cond_wait(&print_journal.work, &print_journal.mutex);
+        }
+        if (print_journal.count == 0)
+        {
+            break;
+        }
+
+        // Junta mais registros até o intervalo, o buffer encher ou todos os
+        // escritores estarem esperando
+        if (print_journal.interval_us > 0)
+        {
+            struct timespec deadline;
+
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += print_journal.interval_us * 1000;
+            deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+            while (print_journal.count < PRINT_JOURNAL_BATCH && !print_journal.stop &&
+                   print_journal.waiters < print_journal.writers &&
+                   pthread_cond_timedwait(&print_journal.work, &print_journal.mutex, &deadline) != ETIMEDOUT)
+            {
+            }
+        }
+
+        // Troca os buffers: novos registros seguem para o outro enquanto este é gravado
+        PrintJournalRecord *batch = print_journal.pending;
+        size_t n = print_journal.count;
+        uint64_t lsn = print_journal.appended;
+        print_journal.pending = print_journal.flushing;
+        print_journal.flushing = batch;
+        print_journal.count = 0;
+        pthread_cond_broadcast(&print_journal.durable);
+        pthread_mutex_unlock(&print_journal.mutex);
+
+        int ret = print_journal_write_all(print_journal.fd, batch, n * sizeof(PrintJournalRecord));
+        if (ret == 0)
+        {
+            ret = fdatasync(print_journal.fd);
+        }
+
+        pthread_mutex_lock(&print_journal.mutex);
+        if (ret != 0)
+        {
+            fprintf(stderr, "Falha ao gravar o diário: %s\n", strerror(errno));
+            print_journal.failed = 1;
+        }
+        else
+        {
+            print_journal.durable_lsn = lsn;
+            print_journal.commits++;
+            print_journal.records += n;
+        }
+        pthread_cond_broadcast(&print_journal.durable);
+    }
+
+    pthread_mutex_unlock(&print_journal.mutex);
+    return NULL;
+}
+
+/**
+ * Abre o diário para acréscimo e inicia a thread de commit
+ *
+ * Os trabalhos pendentes da execução anterior são regravados em um diário novo,
+ * que substitui o antigo atomicamente.
+ *
+ * @param path Arquivo do diário
+ * @param interval_us Espera máxima para juntar registros em um commit
+ * @param writers Número de threads que submetem trabalhos
+ * @param jobs Trabalhos pendentes (de print_journal_replay)
+ * @param num_jobs Número de trabalhos pendentes
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_journal_open(const char *path, long interval_us, int writers,
+                                     const PrintJournalRecord *jobs, size_t num_jobs)
+{
+    char tmp_path[4096];
+    char dir_path[4096];
+
+    // Diário compactado: apenas os trabalhos pendentes
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 ||
+        print_journal_write_all(fd, jobs, num_jobs * sizeof(PrintJournalRecord)) != 0 ||
+        fdatasync(fd) != 0 ||
+        rename(tmp_path, path) != 0)
+    {
+        fprintf(stderr, "Falha ao criar o diário %s: %s\n", path, strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+    close(fd);
+
+    // Torna o rename durável
+    snprintf(dir_path, sizeof(dir_path), "%s", path);
+    int dir_fd = open(dirname(dir_path), O_RDONLY | O_DIRECTORY);
+    if (dir_fd >= 0)
+    {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+
+    print_journal.fd = open(path, O_WRONLY | O_APPEND);
+    print_journal.pending = malloc(PRINT_JOURNAL_BATCH * sizeof(PrintJournalRecord));
+    print_journal.flushing = malloc(PRINT_JOURNAL_BATCH * sizeof(PrintJournalRecord));
+    if (print_journal.fd < 0 || print_journal.pending == NULL || print_journal.flushing == NULL)
+    {
+        fprintf(stderr, "Falha ao abrir o diário %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    print_journal.count = 0;
+    print_journal.appended = 0;
+    print_journal.durable_lsn = 0;
+    print_journal.waiters = 0;
+    print_journal.writers = writers;
+    print_journal.stop = 0;
+    print_journal.failed = 0;
+    print_journal.interval_us = interval_us;
+    print_journal.commits = 0;
+    print_journal.records = 0;
+    if (pthread_mutex_init(&print_journal.mutex, NULL) != 0 ||
+        pthread_cond_init(&print_journal.work, NULL) != 0 ||
+        pthread_cond_init(&print_journal.durable, NULL) != 0 ||
+        pthread_create(&print_journal.committer, NULL, print_journal_committer, NULL) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar a thread do diário\n");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Próximo número de trabalho
+ */
+static inline uint64_t print_journal_next_job(void)
+{
+    return atomic_fetch_add(&print_journal.next_job, 1);
+}
+
+/**
+ * Acrescenta um registro ao diário
+ *
+ * Não espera a gravação; use print_journal_wait com o LSN retornado para isso. Se
+ * os dois buffers estiverem ocupados, espera a thread de commit liberar um deles.
+ *
+ * @param rec Registro (marca e soma de verificação são preenchidas aqui)
+ * @return LSN do registro, ou 0 se o diário falhou
+ */
+static inline uint64_t print_journal_append(PrintJournalRecord *rec)
+{
+    rec->magic = PRINT_JOURNAL_MAGIC;
+    rec->checksum = print_journal_checksum(rec);
+
+    pthread_mutex_lock(&print_journal.mutex);
+    while (print_journal.count == PRINT_JOURNAL_BATCH && !print_journal.failed)
+    {
+        pthread_cond_wait(&print_journal.durable, &print_journal.mutex);
+    }
+    if (print_journal.failed)
+    {
+        pthread_mutex_unlock(&print_journal.mutex);
+        return 0;
+    }
+
+    print_journal.pending[print_journal.count++] = *rec;
+    uint64_t lsn = ++print_journal.appended;
+    if (print_journal.count == 1 || print_journal.count == PRINT_JOURNAL_BATCH)
+    {
+        pthread_cond_signal(&print_journal.work);
+    }
+    pthread_mutex_unlock(&print_journal.mutex);
+    return lsn;
+}
+
+/**
+ * Espera um registro se tornar durável
+ *
+ * @param lsn LSN retornado por print_journal_append
+ * @return 0 quando o registro estiver gravado, -1 se o diário falhou
+ */
+static inline int print_journal_wait(uint64_t lsn)
+{
+    pthread_mutex_lock(&print_journal.mutex);
+    print_journal.waiters++;
+    pthread_cond_signal(&print_journal.work);
+    while (print_journal.durable_lsn < lsn && !print_journal.failed)
+    {
+        pthread_cond_wait(&print_journal.durable, &print_journal.mutex);
+    }
+    print_journal.waiters--;
+    int ret = print_journal.durable_lsn >= lsn ? 0 : -1;
+    pthread_mutex_unlock(&print_journal.mutex);
+    return ret;
+}
+
+/**
+ * Grava os registros restantes, encerra a thread de commit e fecha o diário
+ */
+static inline void print_journal_close(void)
+{
+    pthread_mutex_lock(&print_journal.mutex);
+    print_journal.stop = 1;
+    pthread_cond_signal(&print_journal.work);
+    pthread_mutex_unlock(&print_journal.mutex);
+    pthread_join(print_journal.committer, NULL);
+
+    close(print_journal.fd);
+    free(print_journal.pending);
+    free(print_journal.flushing);
+    pthread_mutex_destroy(&print_journal.mutex);
+    pthread_cond_destroy(&print_journal.work);
+    pthread_cond_destroy(&print_journal.durable);
+}
+
+#endif // PRINT_JOURNAL_H
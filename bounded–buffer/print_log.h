@@ -0,0 +1,441 @@
+/**
+ * Registro Assíncrono de Mensagens (log) sem Locks
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * Em vez de chamar printf (ou um mutex de impressão) dentro das regiões críticas,
+ * cada thread formata suas mensagens em um buffer circular próprio (um produtor,
+ * um consumidor) e uma thread escritora dedicada drena todos os buffers, acumula
+ * o texto e o envia ao terminal com write(2) em blocos grandes.
+ *
+ * Características:
+ * - Registrar uma mensagem não adquire nenhum lock: apenas formata o texto e
+ *   publica o índice de escrita com semântica release
+ * - A thread escritora intercala as mensagens de todas as threads pela marca de
+ *   tempo (CLOCK_MONOTONIC) de cada mensagem
+ * - A marca de tempo pode ser capturada dentro da região crítica (print_log_now) e
+ *   a mensagem registrada depois de liberar o lock (print_log_at), preservando a
+ *   ordem real dos eventos sem estender a região crítica
+ * - Mensagens mais novas que PRINT_LOG_REORDER_NS são retidas brevemente para que
+ *   threads mais lentas publiquem mensagens anteriores antes da intercalação
+ * - Quando uma thread termina, seu buffer é liberado (destrutor de pthread_key) e
+ *   reaproveitado pela próxima thread que registrar mensagens, de modo que threads
+ *   criadas e encerradas durante a execução (pool elástico) não acumulam buffers
+ *
+ * Uso:
+ *   print_log_start();           // inicia a thread escritora
+ *   print_log("texto %d\n", x);  // qualquer thread
+ *   print_log_stop();            // drena os buffers e encerra a escritora
+ */
+
+#ifndef PRINT_LOG_H
+#define PRINT_LOG_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Parâmetros do registro
+ */
+#define PRINT_LOG_RING_SIZE 1024          // Mensagens por thread (potência de dois)
+#define PRINT_LOG_MESSAGE_SIZE 116        // Tamanho máximo de uma mensagem
+#define PRINT_LOG_OUTPUT_SIZE (64 * 1024) // Buffer da thread escritora
+#define PRINT_LOG_IDLE_SLEEP_NS 500000    // Sono da escritora quando não há mensagens
+#define PRINT_LOG_REORDER_NS 1000000      // Janela de espera por mensagens atrasadas
+#define PRINT_LOG_CACHE_LINE 64           // Tamanho da linha de cache
+
+/**
+ * Mensagem registrada por uma thread
+ */
+typedef struct
+{
+    uint64_t timestamp;                 // Momento do evento (CLOCK_MONOTONIC, ns)
+    uint32_t length;                    // Tamanho do texto
+    char text[PRINT_LOG_MESSAGE_SIZE];  // Texto já formatado
+} PrintLogEntry;
+
+/**
+ * Buffer circular de mensagens de uma thread
+ *
+ * A thread dona escreve apenas tail; a escritora escreve apenas head. Um buffer
+ * liberado mantém as mensagens pendentes, que a escritora drena normalmente.
+ */
+typedef struct PrintLogRing
+{
+    _Alignas(PRINT_LOG_CACHE_LINE) atomic_size_t tail; // Próxima mensagem a registrar (dona)
+    atomic_int owned;                                  // Buffer em uso por uma thread
+    _Alignas(PRINT_LOG_CACHE_LINE) atomic_size_t head; // Próxima mensagem a escrever (escritora)
+    struct PrintLogRing *next;                         // Próximo buffer registrado
+    PrintLogEntry entries[PRINT_LOG_RING_SIZE];        // Mensagens
+} PrintLogRing;
+
+/**
+ * Estado global do registro
+ */
+typedef struct
+{
+    _Atomic(PrintLogRing *) rings; // Lista de buffers registrados (inserção sem lock)
+    atomic_int running;            // Thread escritora ativa
+    atomic_int muted;              // Descarta as mensagens (modo silencioso)
+    atomic_ulong full_waits;       // Vezes em que uma thread esperou buffer cheio
+    pthread_t writer;              // Thread escritora
+    int fd;                        // Descritor de saída
+    size_t used;                   // Bytes acumulados em output
+    char output[PRINT_LOG_OUTPUT_SIZE];
+} PrintLog;
+
+static PrintLog print_log_state;
+static __thread PrintLogRing *print_log_ring;
+static pthread_key_t print_log_key;                  // Libera o buffer quando a thread termina
+static pthread_once_t print_log_key_once = PTHREAD_ONCE_INIT;
+static int print_log_key_ready;                      // print_log_key foi criada
+
+/**
+ * Instante atual em nanossegundos (CLOCK_MONOTONIC)
+ *
+ * Pode ser chamada dentro de uma região crítica para registrar o momento exato do
+ * evento; a mensagem é registrada depois, com print_log_at.
+ */
+static inline uint64_t print_log_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Destrutor da chave: libera o buffer da thread que terminou para reaproveitamento
+ *
+ * @param ring Buffer da thread
+ */
+static inline void print_log_release(void *ring)
+{
+    atomic_store_explicit(&((PrintLogRing *)ring)->owned, 0, memory_order_release);
+}
+
+/**
+ * Cria a chave cujo destrutor libera o buffer de cada thread
+ */
+static inline void print_log_key_create(void)
+{
+    print_log_key_ready = pthread_key_create(&print_log_key, print_log_release) == 0;
+}
+
+/**
+ * Obtém (reaproveitando ou criando na primeira chamada) o buffer da thread atual
+ *
+ * Um buffer liberado pode ter mensagens ainda não drenadas: a nova dona continua
+ * a partir de tail, e a escritora segue drenando a partir de head.
+ *
+ * @return Buffer da thread ou NULL se a alocação falhar
+ */
+static inline PrintLogRing *print_log_thread_ring(void)
+{
+    PrintLogRing *ring = print_log_ring;
+
+    if (ring != NULL)
+    {
+        return ring;
+    }
+    pthread_once(&print_log_key_once, print_log_key_create);
+
+    // Reaproveita o buffer de uma thread encerrada
+    for (ring = atomic_load_explicit(&print_log_state.rings, memory_order_acquire); ring != NULL; ring = ring->next)
+    {
+        int free_ring = 0;
+        if (atomic_compare_exchange_strong_explicit(&ring->owned, &free_ring, 1, memory_order_acquire,
+                                                    memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    if (ring == NULL)
+    {
+        ring = aligned_alloc(PRINT_LOG_CACHE_LINE, sizeof(PrintLogRing));
+        if (ring == NULL)
+        {
+            return NULL;
+        }
+        atomic_init(&ring->tail, 0);
+        atomic_init(&ring->head, 0);
+        atomic_init(&ring->owned, 1);
+
+        // Publica o buffer na lista global
+        ring->next = atomic_load_explicit(&print_log_state.rings, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&print_log_state.rings, &ring->next, ring,
+                                                      memory_order_release, memory_order_relaxed))
+        {
+        }
+    }
+
+    // Sem a chave, o buffer apenas não é reaproveitado
+    if (print_log_key_ready)
+    {
+        pthread_setspecific(print_log_key, ring);
+    }
+    print_log_ring = ring;
+    return ring;
+}
+
+/**
+ * Registra uma mensagem com marca de tempo explícita (lista de argumentos)
+ *
+ * @param timestamp Momento do evento (print_log_now)
+ * @param format String de formato
+ * @param args Argumentos do formato
+ */
+static inline void print_logv_at(uint64_t timestamp, const char *format, va_list args)
+{
+    if (atomic_load_explicit(&print_log_state.muted, memory_order_relaxed))
+    {
+        return;
+    }
+
+    PrintLogRing *ring = print_log_thread_ring();
+    if (ring == NULL)
+    {
+        return;
+    }
+
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    // Buffer cheio: aguarda a escritora (fora de qualquer região crítica)
+    if (tail - atomic_load_explicit(&ring->head, memory_order_acquire) == PRINT_LOG_RING_SIZE)
+    {
+        atomic_fetch_add_explicit(&print_log_state.full_waits, 1, memory_order_relaxed);
+        while (tail - atomic_load_explicit(&ring->head, memory_order_acquire) == PRINT_LOG_RING_SIZE)
+        {
+            sched_yield();
+        }
+    }
+
+    PrintLogEntry *entry = &ring->entries[tail & (PRINT_LOG_RING_SIZE - 1)];
+    int length = vsnprintf(entry->text, PRINT_LOG_MESSAGE_SIZE, format, args);
+
+    if (length < 0)
+    {
+        return;
+    }
+    if (length >= PRINT_LOG_MESSAGE_SIZE)
+    {
+        // Mensagem truncada: mantém a quebra de linha final
+        length = PRINT_LOG_MESSAGE_SIZE - 1;
+        entry->text[length - 1] = '\n';
+    }
+    entry->length = (uint32_t)length;
+    entry->timestamp = timestamp;
+
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * Registra uma mensagem com marca de tempo explícita
+ *
+ * @param timestamp Momento do evento (print_log_now)
+ * @param format String de formato (igual ao printf)
+ * @param ... Argumentos variáveis
+ */
+static inline void print_log_at(uint64_t timestamp, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    print_logv_at(timestamp, format, args);
+    va_end(args);
+}
+
+/**
+ * Registra uma mensagem com o instante atual
+ *
+ * @param format String de formato (igual ao printf)
+ * @param ... Argumentos variáveis
+ */
+static inline void print_log(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    print_logv_at(print_log_now(), format, args);
+    va_end(args);
+}
+
+/**
+ * Envia o texto acumulado pela escritora com write(2)
+ */
+static inline void print_log_flush(void)
+{
+    size_t written = 0;
+
+    while (written < print_log_state.used)
+    {
+        ssize_t n = write(print_log_state.fd, print_log_state.output + written,
+                          print_log_state.used - written);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        written += (size_t)n;
+    }
+    print_log_state.used = 0;
+}
+
+/**
+ * Copia para a saída as mensagens prontas, em ordem de marca de tempo
+ *
+ * A cada passo escolhe o buffer cuja mensagem mais antiga é a menor e copia dele
+ * todas as mensagens anteriores à mais antiga dos demais buffers.
+ *
+ * @param limit Copia apenas mensagens com marca de tempo menor que limit
+ * @return Número de mensagens copiadas
+ */
+static inline size_t print_log_drain(uint64_t limit)
+{
+    size_t drained = 0;
+
+    for (;;)
+    {
+        PrintLogRing *best = NULL;
+        uint64_t best_ts = limit;
+        uint64_t second_ts = limit;
+
+        // Encontra o buffer com a mensagem mais antiga e a segunda menor marca de tempo
+        for (PrintLogRing *r = atomic_load_explicit(&print_log_state.rings, memory_order_acquire);
+             r != NULL; r = r->next)
+        {
+            size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+            if (head == atomic_load_explicit(&r->tail, memory_order_acquire))
+            {
+                continue;
+            }
+
+            uint64_t ts = r->entries[head & (PRINT_LOG_RING_SIZE - 1)].timestamp;
+            if (ts < best_ts)
+            {
+                second_ts = best_ts;
+                best_ts = ts;
+                best = r;
+            }
+            else if (ts < second_ts)
+            {
+                second_ts = ts;
+            }
+        }
+
+        if (best == NULL)
+        {
+            return drained;
+        }
+
+        // Copia as mensagens do buffer escolhido até alcançar a próxima de outro buffer
+        size_t head = atomic_load_explicit(&best->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&best->tail, memory_order_acquire);
+        while (head != tail)
+        {
+            PrintLogEntry *entry = &best->entries[head & (PRINT_LOG_RING_SIZE - 1)];
+            if (entry->timestamp > second_ts)
+            {
+                break;
+            }
+            if (print_log_state.used + entry->length > PRINT_LOG_OUTPUT_SIZE)
+            {
+                print_log_flush();
+            }
+            memcpy(print_log_state.output + print_log_state.used, entry->text, entry->length);
+            print_log_state.used += entry->length;
+            head++;
+            drained++;
+        }
+        atomic_store_explicit(&best->head, head, memory_order_release);
+    }
+}
+
+/**
+ * Thread escritora: drena os buffers, acumula o texto e o escreve em blocos
+ *
+ * @param arg Não utilizado
+ * @return NULL
+ */
+static inline void *print_log_writer(void *arg)
+{
+    const struct timespec idle = {0, PRINT_LOG_IDLE_SLEEP_NS};
+    (void)arg;
+
+    while (atomic_load_explicit(&print_log_state.running, memory_order_acquire))
+    {
+        if (print_log_drain(print_log_now() - PRINT_LOG_REORDER_NS) == 0)
+        {
+            // Nada novo: escreve o que foi acumulado e dorme
+            print_log_flush();
+            nanosleep(&idle, NULL);
+        }
+    }
+
+    // Desligamento: escreve todas as mensagens restantes
+    print_log_drain(UINT64_MAX);
+    print_log_flush();
+    return NULL;
+}
+
+/**
+ * Ativa ou desativa o descarte de mensagens (modo silencioso)
+ *
+ * @param muted 1 para descartar as mensagens, 0 para registrá-las
+ */
+static inline void print_log_mute(int muted)
+{
+    atomic_store(&print_log_state.muted, muted);
+}
+
+/**
+ * Inicia a thread escritora
+ *
+ * Esvazia o buffer do stdio antes, para que mensagens impressas com printf antes
+ * do início do registro apareçam na ordem correta.
+ *
+ * @return 0 em caso de sucesso, -1 se a thread não puder ser criada
+ */
+static inline int print_log_start(void)
+{
+    fflush(stdout);
+    print_log_state.fd = STDOUT_FILENO;
+    print_log_state.used = 0;
+    atomic_store(&print_log_state.running, 1);
+
+    if (pthread_create(&print_log_state.writer, NULL, print_log_writer, NULL) != 0)
+    {
+        atomic_store(&print_log_state.running, 0);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Encerra a thread escritora após escrever todas as mensagens pendentes
+ *
+ * Deve ser chamada depois que as threads que registram mensagens terminaram.
+ * Os buffers continuam registrados e podem ser drenados por um novo print_log_start.
+ */
+static inline void print_log_stop(void)
+{
+    if (!atomic_exchange(&print_log_state.running, 0))
+    {
+        return;
+    }
+    pthread_join(print_log_state.writer, NULL);
+}
+
+#endif // PRINT_LOG_H
@@ -0,0 +1,272 @@
+/**
+ * Pool de Blocos (slab) para o Conteúdo dos Documentos
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * O conteúdo de um trabalho de impressão pode ter megabytes; em vez de copiá-lo
+ * para dentro e para fora do buffer circular, o produtor o escreve em um bloco de
+ * uma área pré-alocada e o buffer transporta apenas o identificador (handle) do
+ * bloco. A impressora lê o conteúdo diretamente do bloco e o devolve ao pool.
+ *
+ * Características:
+ * - Uma única alocação na inicialização; alocar e liberar blocos nunca chama malloc
+ * - Cada thread mantém uma lista local de blocos livres (sem sincronização)
+ * - A lista local troca blocos com a lista global em lotes: os produtores retiram
+ *   lotes que as impressoras devolveram, com uma operação atômica por bloco ao
+ *   retirar e uma por lote ao devolver
+ * - A lista global é uma pilha de Treiber sem locks, com contador de versão no
+ *   topo para evitar o problema ABA
+ *
+ * Uso:
+ *   print_slab_init(blocos, tamanho);
+ *   PrintSlabHandle h = print_slab_alloc();   // produtor
+ *   memcpy(print_slab_ptr(h), dados, n);
+ *   ... h atravessa a fila ...
+ *   print_slab_free(h);                       // impressora
+ *   print_slab_thread_flush();                // ao final de cada thread
+ *   print_slab_destroy();
+ */
+
+#ifndef PRINT_SLAB_H
+#define PRINT_SLAB_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/**
+ * Parâmetros do pool
+ */
+#define PRINT_SLAB_CACHE_SIZE 32   // Blocos na lista local de cada thread
+#define PRINT_SLAB_BATCH 16        // Blocos trocados com a lista global por vez
+#define PRINT_SLAB_ALIGN 64        // Alinhamento dos blocos (linha de cache)
+#define PRINT_SLAB_NONE UINT32_MAX // Handle inválido (pool esgotado)
+
+/**
+ * Identificador de um bloco do pool
+ */
+typedef uint32_t PrintSlabHandle;
+
+/**
+ * Estado global do pool
+ */
+typedef struct
+{
+    _Alignas(PRINT_SLAB_ALIGN) _Atomic uint64_t top; // Topo da lista global: versão << 32 | bloco
+    atomic_ulong refills;                            // Lotes retirados da lista global
+    atomic_ulong flushes;                            // Lotes devolvidos à lista global
+
+    _Alignas(PRINT_SLAB_ALIGN) unsigned char *arena; // Área com todos os blocos
+    _Atomic uint32_t *next;                          // Próximo bloco livre na lista global
+    size_t block_size;                               // Tamanho de cada bloco (múltiplo de 64)
+    uint32_t num_blocks;                             // Número de blocos
+} PrintSlab;
+
+/**
+ * Lista local de blocos livres de uma thread
+ */
+typedef struct
+{
+    uint32_t count;                                // Blocos na lista
+    PrintSlabHandle blocks[PRINT_SLAB_CACHE_SIZE]; // Blocos livres
+} PrintSlabCache;
+
+static PrintSlab print_slab;
+static __thread PrintSlabCache print_slab_cache;
+
+/**
+ * Inicializa o pool com todos os blocos na lista global
+ *
+ * @param num_blocks Número de blocos
+ * @param block_size Tamanho mínimo de cada bloco em bytes
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_slab_init(size_t num_blocks, size_t block_size)
+{
+    if (num_blocks == 0 || num_blocks >= PRINT_SLAB_NONE)
+    {
+        fprintf(stderr, "Número de blocos inválido: %zu\n", num_blocks);
+        return -1;
+    }
+
+    block_size = (block_size + PRINT_SLAB_ALIGN - 1) & ~(size_t)(PRINT_SLAB_ALIGN - 1);
+    print_slab.arena = aligned_alloc(PRINT_SLAB_ALIGN, num_blocks * block_size);
+    print_slab.next = malloc(num_blocks * sizeof(print_slab.next[0]));
+    if (print_slab.arena == NULL || print_slab.next == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar pool de %zu blocos de %zu bytes\n", num_blocks, block_size);
+        free(print_slab.arena);
+        free(print_slab.next);
+        return -1;
+    }
+
+    print_slab.block_size = block_size;
+    print_slab.num_blocks = (uint32_t)num_blocks;
+    for (uint32_t i = 0; i < print_slab.num_blocks; i++)
+    {
+        atomic_init(&print_slab.next[i], i + 1 < print_slab.num_blocks ? i + 1 : PRINT_SLAB_NONE);
+    }
+    atomic_init(&print_slab.top, 0);
+    atomic_init(&print_slab.refills, 0);
+    atomic_init(&print_slab.flushes, 0);
+    return 0;
+}
+
+/**
+ * Libera a área do pool
+ */
+static inline void print_slab_destroy(void)
+{
+    free(print_slab.arena);
+    free(print_slab.next);
+    print_slab.arena = NULL;
+    print_slab.next = NULL;
+}
+
+/**
+ * Endereço do conteúdo de um bloco
+ *
+ * @param handle Bloco
+ */
+static inline void *print_slab_ptr(PrintSlabHandle handle)
+{
+    return print_slab.arena + (size_t)handle * print_slab.block_size;
+}
+
+/**
+ * Retira um bloco da lista global
+ *
+ * @return Bloco retirado ou PRINT_SLAB_NONE se a lista estiver vazia
+ */
+static inline PrintSlabHandle print_slab_pop(void)
+{
+    uint64_t top = atomic_load_explicit(&print_slab.top, memory_order_acquire);
+
+    for (;;)
+    {
+        uint32_t block = (uint32_t)top;
+        if (block == PRINT_SLAB_NONE)
+        {
+            return PRINT_SLAB_NONE;
+        }
+
+        // next pode estar desatualizado se outro thread retirou o bloco; a versão
+        // do topo faz o CAS falhar nesse caso
+        uint32_t next = atomic_load_explicit(&print_slab.next[block], memory_order_relaxed);
+        uint64_t new_top = ((top >> 32) + 1) << 32 | next;
+        if (atomic_compare_exchange_weak_explicit(&print_slab.top, &top, new_top,
+                                                  memory_order_acquire, memory_order_acquire))
+        {
+            return block;
+        }
+    }
+}
+
+/**
+ * Devolve uma cadeia de blocos à lista global com uma única troca do topo
+ *
+ * @param blocks Blocos a devolver
+ * @param n Número de blocos (n >= 1)
+ */
+static inline void print_slab_push(const PrintSlabHandle *blocks, uint32_t n)
+{
+    // Encadeia os blocos entre si; apenas o último aponta para o topo atual
+    for (uint32_t i = 0; i + 1 < n; i++)
+    {
+        atomic_store_explicit(&print_slab.next[blocks[i]], blocks[i + 1], memory_order_relaxed);
+    }
+
+    uint64_t top = atomic_load_explicit(&print_slab.top, memory_order_relaxed);
+    uint64_t new_top;
+    do
+    {
+        atomic_store_explicit(&print_slab.next[blocks[n - 1]], (uint32_t)top, memory_order_relaxed);
+        new_top = ((top >> 32) + 1) << 32 | blocks[0];
+    } while (!atomic_compare_exchange_weak_explicit(&print_slab.top, &top, new_top,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+/**
+ * Aloca um bloco
+ *
+ * Usa a lista local da thread; se estiver vazia, retira um lote da lista global.
+ *
+ * @return Bloco alocado ou PRINT_SLAB_NONE se o pool estiver esgotado
+ */
+static inline PrintSlabHandle print_slab_alloc(void)
+{
+    PrintSlabCache *cache = &print_slab_cache;
+
+    if (cache->count == 0)
+    {
+        while (cache->count < PRINT_SLAB_BATCH)
+        {
+            PrintSlabHandle block = print_slab_pop();
+            if (block == PRINT_SLAB_NONE)
+            {
+                break;
+            }
+            cache->blocks[cache->count++] = block;
+        }
+        if (cache->count == 0)
+        {
+            return PRINT_SLAB_NONE;
+        }
+        atomic_fetch_add_explicit(&print_slab.refills, 1, memory_order_relaxed);
+    }
+    return cache->blocks[--cache->count];
+}
+
+/**
+ * Libera um bloco
+ *
+ * Guarda o bloco na lista local da thread; se ela estiver cheia, devolve um lote à
+ * lista global.
+ *
+ * @param handle Bloco a liberar
+ */
+static inline void print_slab_free(PrintSlabHandle handle)
+{
+    PrintSlabCache *cache = &print_slab_cache;
+
+    if (cache->count == PRINT_SLAB_CACHE_SIZE)
+    {
+        cache->count -= PRINT_SLAB_BATCH;
+        print_slab_push(&cache->blocks[cache->count], PRINT_SLAB_BATCH);
+        atomic_fetch_add_explicit(&print_slab.flushes, 1, memory_order_relaxed);
+    }
+    cache->blocks[cache->count++] = handle;
+}
+
+/**
+ * Devolve à lista global todos os blocos da lista local da thread
+ *
+ * Deve ser chamada ao final de cada thread que usou o pool.
+ */
+static inline void print_slab_thread_flush(void)
+{
+    PrintSlabCache *cache = &print_slab_cache;
+
+    if (cache->count > 0)
+    {
+        print_slab_push(cache->blocks, cache->count);
+        cache->count = 0;
+    }
+}
+
+/**
+ * Número de blocos necessários para que o pool não se esgote
+ *
+ * Cada documento na fila ocupa um bloco e cada thread pode reter até uma lista
+ * local cheia.
+ *
+ * @param queued Maior número de documentos na fila
+ * @param threads Número de threads que usam o pool
+ */
+static inline size_t print_slab_blocks_for(size_t queued, int threads)
+{
+    return queued + (size_t)threads * (PRINT_SLAB_CACHE_SIZE + 1);
+}
+
+#endif // PRINT_SLAB_H
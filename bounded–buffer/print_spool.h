@@ -0,0 +1,590 @@
+/**
+ * Saída das Impressoras em Arquivos de Spool com io_uring
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * Em vez de simular a impressão com usleep, cada impressora grava o conteúdo dos
+ * documentos no seu arquivo de spool. Com write(2) a impressora ficaria bloqueada em
+ * cada gravação; aqui as gravações são enviadas por um anel io_uring próprio da
+ * impressora, que mantém até PRINT_SPOOL_DEPTH gravações em andamento enquanto a
+ * impressora continua retirando documentos da fila.
+ *
+ * Características:
+ * - Chamadas de sistema diretas (io_uring_setup/enter/register), sem liburing
+ * - Buffers registrados: a área do pool de blocos (print_slab.h) é registrada uma
+ *   vez e as gravações usam IORING_OP_WRITE_FIXED direto do bloco do documento, sem
+ *   cópia; se o registro falhar (limite de memória travada), usa IORING_OP_WRITE
+ * - Submissão em lote: as entradas são acumuladas e enviadas com uma única chamada
+ *   io_uring_enter a cada PRINT_SPOOL_BATCH gravações, ou antes de a impressora esperar
+ * - Sem io_uring no kernel (ou bloqueado por seccomp), grava com pwrite de forma síncrona
+ * - Gravações parciais são reenviadas a partir do ponto em que pararam; a conclusão
+ *   só é entregue quando o documento inteiro foi gravado ou a gravação falhou
+ * - Se io_uring_enter falhar (exceto EINTR), o anel é desativado: as entradas ainda
+ *   não submetidas são gravadas com pwrite, as submetidas são esperadas (ou dadas
+ *   como falhas) e o spool passa a gravar com pwrite
+ *
+ * Cada spool é usado por uma única thread. A conclusão de uma gravação é entregue a
+ * uma função do chamador com o índice (slot) que a identificou na submissão.
+ *
+ * Uso:
+ *   print_spool_open(&sp, caminho, area, tamanho);
+ *   slot = print_spool_slot(&sp, concluida, ctx);       // espera se todos em uso
+ *   ... guarda o estado do documento em estado[slot] ...
+ *   print_spool_write(&sp, slot, dados, n, concluida, ctx);
+ *   print_spool_flush(&sp, concluida, ctx);             // antes de esperar trabalho
+ *   print_spool_drain(&sp, concluida, ctx);             // espera todas as gravações
+ *   print_spool_close(&sp);
+ */
+
+#ifndef PRINT_SPOOL_H
+#define PRINT_SPOOL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/**
+ * Parâmetros do spool
+ */
+#define PRINT_SPOOL_DEPTH 32 // Gravações em andamento por impressora (entradas do anel)
+#define PRINT_SPOOL_BATCH 8  // Entradas acumuladas antes de uma chamada io_uring_enter
+
+/**
+ * Função chamada na conclusão de uma gravação
+ *
+ * @param ctx Contexto do chamador
+ * @param slot Índice da gravação
+ * @param result Tamanho da gravação (gravada por inteiro), ou -errno em caso de falha
+ */
+typedef void (*PrintSpoolDone)(void *ctx, int slot, int result);
+
+/**
+ * Gravação em andamento em um slot
+ */
+typedef struct
+{
+    const char *data; // Dados da gravação
+    size_t length;    // Tamanho da gravação
+    size_t written;   // Bytes já gravados (gravações parciais)
+    off_t offset;     // Posição da gravação no arquivo
+} PrintSpoolWrite;
+
+/**
+ * Spool de uma impressora
+ */
+typedef struct
+{
+    int fd;           // Arquivo de spool
+    off_t offset;     // Próxima posição de gravação
+    int ring_fd;      // Anel io_uring (-1 = pwrite síncrono)
+    int fixed;        // Área do pool registrada como buffer fixo
+    const char *base; // Início da área registrada
+
+    // Fila de submissão (SQ), mapeada do kernel
+    unsigned *sq_head;         // Primeira entrada ainda não consumida pelo kernel
+    unsigned *sq_tail;         // Próxima entrada a preencher
+    unsigned sq_mask;          // Máscara dos índices da SQ
+    unsigned *sq_array;        // Índices das entradas submetidas
+    struct io_uring_sqe *sqes; // Entradas de submissão
+
+    // Fila de conclusão (CQ), mapeada do kernel
+    unsigned *cq_head;         // Próxima conclusão a consumir
+    unsigned *cq_tail;         // Fim das conclusões publicadas pelo kernel
+    unsigned cq_mask;          // Máscara dos índices da CQ
+    struct io_uring_cqe *cqes; // Conclusões
+
+    // Mapeamentos do anel
+    void *sq_ring;       // Anel de submissão
+    void *cq_ring;       // Anel de conclusão (igual a sq_ring com IORING_FEAT_SINGLE_MMAP)
+    size_t sq_ring_size; // Tamanho do mapeamento da SQ
+    size_t cq_ring_size; // Tamanho do mapeamento da CQ
+    size_t sqes_size;    // Tamanho do mapeamento das entradas
+
+    unsigned queued;                            // Entradas preenchidas e ainda não submetidas
+    unsigned inflight;                          // Gravações submetidas e não concluídas
+    PrintSpoolWrite pending[PRINT_SPOOL_DEPTH]; // Gravação de cada slot
+    int free_slots[PRINT_SPOOL_DEPTH];          // Slots livres
+    int num_free;                               // Número de slots livres
+    unsigned long writes;                       // Gravações concluídas
+    unsigned long enters;                       // Chamadas io_uring_enter
+    int error;                                  // errno da falha que desativou o anel (0 = nenhuma)
+} PrintSpool;
+
+/**
+ * Chamadas de sistema do io_uring (a glibc não oferece funções para elas)
+ */
+static inline int print_spool_setup(unsigned entries, struct io_uring_params *p)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static inline int print_spool_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static inline int print_spool_register(int fd, unsigned opcode, void *arg, unsigned nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/**
+ * Desfaz os mapeamentos e fecha o anel io_uring (o spool passa a usar pwrite)
+ *
+ * Aceita um anel mapeado só em parte, quando a criação falhou no meio.
+ */
+static inline void print_spool_ring_close(PrintSpool *sp)
+{
+    if (sp->fixed)
+    {
+        print_spool_register(sp->ring_fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+        sp->fixed = 0;
+    }
+    if (sp->sqes != NULL && sp->sqes != MAP_FAILED)
+    {
+        munmap(sp->sqes, sp->sqes_size);
+    }
+    if (sp->cq_ring != NULL && sp->cq_ring != MAP_FAILED && sp->cq_ring != sp->sq_ring)
+    {
+        munmap(sp->cq_ring, sp->cq_ring_size);
+    }
+    if (sp->sq_ring != NULL && sp->sq_ring != MAP_FAILED)
+    {
+        munmap(sp->sq_ring, sp->sq_ring_size);
+    }
+    sp->sqes = NULL;
+    sp->cq_ring = NULL;
+    sp->sq_ring = NULL;
+    close(sp->ring_fd);
+    sp->ring_fd = -1;
+}
+
+/**
+ * Cria e mapeia o anel io_uring do spool
+ *
+ * @param sp Spool
+ * @param base Área a registrar como buffer fixo (NULL para não registrar)
+ * @param length Tamanho da área
+ * @return 0 em caso de sucesso, -1 se io_uring não estiver disponível
+ */
+static inline int print_spool_ring_init(PrintSpool *sp, const void *base, size_t length)
+{
+    struct io_uring_params p;
+
+    memset(&p, 0, sizeof(p));
+    sp->ring_fd = print_spool_setup(PRINT_SPOOL_DEPTH, &p);
+    if (sp->ring_fd < 0)
+    {
+        return -1;
+    }
+
+    sp->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    sp->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (sp->cq_ring_size > sp->sq_ring_size)
+        {
+            sp->sq_ring_size = sp->cq_ring_size;
+        }
+        sp->cq_ring_size = sp->sq_ring_size;
+    }
+
+    sp->sq_ring = mmap(NULL, sp->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       sp->ring_fd, IORING_OFF_SQ_RING);
+    sp->cq_ring = (p.features & IORING_FEAT_SINGLE_MMAP)
+                      ? sp->sq_ring
+                      : mmap(NULL, sp->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             sp->ring_fd, IORING_OFF_CQ_RING);
+    sp->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    sp->sqes = mmap(NULL, sp->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    sp->ring_fd, IORING_OFF_SQES);
+    if (sp->sq_ring == MAP_FAILED || sp->cq_ring == MAP_FAILED || sp->sqes == MAP_FAILED)
+    {
+        print_spool_ring_close(sp);
+        return -1;
+    }
+
+    char *sq = sp->sq_ring;
+    char *cq = sp->cq_ring;
+    sp->sq_head = (unsigned *)(sq + p.sq_off.head);
+    sp->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    sp->sq_mask = *(unsigned *)(sq + p.sq_off.ring_mask);
+    sp->sq_array = (unsigned *)(sq + p.sq_off.array);
+    sp->cq_head = (unsigned *)(cq + p.cq_off.head);
+    sp->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    sp->cq_mask = *(unsigned *)(cq + p.cq_off.ring_mask);
+    sp->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    // Buffers registrados: evita mapear as páginas do usuário a cada gravação
+    if (base != NULL)
+    {
+        struct iovec iov = {.iov_base = (void *)base, .iov_len = length};
+        sp->fixed = print_spool_register(sp->ring_fd, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+        sp->base = base;
+    }
+    return 0;
+}
+
+/**
+ * Abre o spool de uma impressora
+ *
+ * @param sp Spool
+ * @param path Arquivo de spool (truncado)
+ * @param base Área de onde sairão os dados gravados, registrada no anel (pode ser NULL)
+ * @param length Tamanho da área
+ * @return 0 em caso de sucesso, -1 se o arquivo não puder ser criado
+ */
+static inline int print_spool_open(PrintSpool *sp, const char *path, const void *base, size_t length)
+{
+    memset(sp, 0, sizeof(*sp));
+    sp->ring_fd = -1;
+    sp->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (sp->fd < 0)
+    {
+        fprintf(stderr, "Falha ao criar spool %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    for (int i = 0; i < PRINT_SPOOL_DEPTH; i++)
+    {
+        sp->free_slots[i] = PRINT_SPOOL_DEPTH - 1 - i;
+    }
+    sp->num_free = PRINT_SPOOL_DEPTH;
+
+    print_spool_ring_init(sp, base, length);
+    return 0;
+}
+
+/**
+ * Descrição do mecanismo de gravação em uso
+ */
+static inline const char *print_spool_mode(const PrintSpool *sp)
+{
+    if (sp->error != 0)
+    {
+        return "pwrite, após falha de io_uring_enter";
+    }
+    return sp->ring_fd < 0 ? "pwrite" : sp->fixed ? "io_uring, buffers registrados" : "io_uring";
+}
+
+/**
+ * Conclui a gravação de um slot e o devolve aos slots livres
+ */
+static inline void print_spool_complete(PrintSpool *sp, int slot, int result, PrintSpoolDone done, void *ctx)
+{
+    sp->free_slots[sp->num_free++] = slot;
+    sp->writes++;
+    done(ctx, slot, result);
+}
+
+/**
+ * Grava com pwrite o que falta da gravação de um slot
+ *
+ * @return Tamanho da gravação, ou -errno em caso de falha
+ */
+static inline int print_spool_pwrite(PrintSpool *sp, int slot)
+{
+    PrintSpoolWrite *w = &sp->pending[slot];
+
+    while (w->written < w->length)
+    {
+        ssize_t n = pwrite(sp->fd, w->data + w->written, w->length - w->written, w->offset + (off_t)w->written);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return n < 0 ? -errno : -EIO;
+        }
+        w->written += (size_t)n;
+    }
+    return (int)w->length;
+}
+
+/**
+ * Preenche uma entrada da SQ com o que falta da gravação de um slot
+ *
+ * Cada slot tem no máximo uma entrada na SQ ou em andamento, então sempre há espaço.
+ */
+static inline void print_spool_queue(PrintSpool *sp, int slot)
+{
+    const PrintSpoolWrite *w = &sp->pending[slot];
+    unsigned tail = *sp->sq_tail;
+    unsigned index = tail & sp->sq_mask;
+    struct io_uring_sqe *sqe = &sp->sqes[index];
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = sp->fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = sp->fd;
+    sqe->off = (uint64_t)(w->offset + (off_t)w->written);
+    sqe->addr = (uint64_t)(uintptr_t)(w->data + w->written);
+    sqe->len = (uint32_t)(w->length - w->written);
+    sqe->buf_index = 0;
+    sqe->user_data = (uint64_t)slot;
+    sp->sq_array[index] = index;
+    __atomic_store_n(sp->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    sp->queued++;
+}
+
+/**
+ * Consome as conclusões disponíveis, sem esperar
+ *
+ * @return Número de gravações concluídas
+ */
+static inline int print_spool_reap(PrintSpool *sp, PrintSpoolDone done, void *ctx)
+{
+    unsigned head = *sp->cq_head;
+    unsigned tail = __atomic_load_n(sp->cq_tail, __ATOMIC_ACQUIRE);
+    int n = 0;
+
+    for (; head != tail; head++)
+    {
+        const struct io_uring_cqe *cqe = &sp->cqes[head & sp->cq_mask];
+        int slot = (int)cqe->user_data;
+        int res = cqe->res;
+        PrintSpoolWrite *w = &sp->pending[slot];
+
+        sp->inflight--;
+        if (res > 0 && (size_t)res < w->length - w->written)
+        {
+            // Gravação parcial: reenvia o restante (com pwrite se o anel falhou)
+            w->written += (size_t)res;
+            if (sp->error == 0)
+            {
+                print_spool_queue(sp, slot);
+                continue;
+            }
+            res = print_spool_pwrite(sp, slot);
+        }
+        else if (res >= 0)
+        {
+            res = res > 0 ? (int)w->length : -EIO;
+        }
+        print_spool_complete(sp, slot, res, done, ctx);
+        n++;
+    }
+    __atomic_store_n(sp->cq_head, head, __ATOMIC_RELEASE);
+    return n;
+}
+
+/**
+ * Desativa o anel após uma falha de io_uring_enter
+ *
+ * As entradas ainda na SQ são retiradas dela e gravadas com pwrite. As gravações
+ * submetidas são esperadas enquanto o kernel entregar conclusões; as que restarem
+ * são concluídas com a falha. Depois disso, o spool grava com pwrite.
+ *
+ * @param sp Spool
+ * @param err errno da falha
+ * @param done Função de conclusão
+ * @param ctx Contexto da função de conclusão
+ */
+static inline void print_spool_fail(PrintSpool *sp, int err, PrintSpoolDone done, void *ctx)
+{
+    unsigned head = __atomic_load_n(sp->sq_head, __ATOMIC_ACQUIRE);
+    unsigned tail = *sp->sq_tail;
+
+    fprintf(stderr, "Falha em io_uring_enter no spool: %s; gravando com pwrite\n", strerror(err));
+    sp->error = err;
+
+    // Sem SQPOLL, o kernel só lê a SQ dentro de io_uring_enter: recuar tail a retira
+    __atomic_store_n(sp->sq_tail, head, __ATOMIC_RELEASE);
+    sp->queued = 0;
+    for (; head != tail; head++)
+    {
+        int slot = (int)sp->sqes[sp->sq_array[head & sp->sq_mask]].user_data;
+        print_spool_complete(sp, slot, print_spool_pwrite(sp, slot), done, ctx);
+    }
+
+    while (sp->inflight > 0)
+    {
+        if (print_spool_enter(sp->ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+        {
+            break;
+        }
+        print_spool_reap(sp, done, ctx);
+    }
+
+    // Gravações cuja conclusão não pode mais ser obtida: os slots fora da lista livre
+    if (sp->inflight > 0)
+    {
+        int busy[PRINT_SPOOL_DEPTH];
+
+        for (int i = 0; i < PRINT_SPOOL_DEPTH; i++)
+        {
+            busy[i] = 1;
+        }
+        for (int i = 0; i < sp->num_free; i++)
+        {
+            busy[sp->free_slots[i]] = 0;
+        }
+        for (int slot = 0; slot < PRINT_SPOOL_DEPTH; slot++)
+        {
+            if (busy[slot])
+            {
+                print_spool_complete(sp, slot, -err, done, ctx);
+            }
+        }
+        sp->inflight = 0;
+    }
+    print_spool_ring_close(sp);
+}
+
+/**
+ * Submete as entradas acumuladas e, opcionalmente, espera conclusões
+ *
+ * @param sp Spool
+ * @param min_complete Conclusões a esperar (0 não espera)
+ * @param done Função de conclusão
+ * @param ctx Contexto da função de conclusão
+ * @return 0 em caso de sucesso, -errno se io_uring_enter falhou (o spool passa a usar pwrite)
+ */
+static inline int print_spool_submit(PrintSpool *sp, unsigned min_complete, PrintSpoolDone done, void *ctx)
+{
+    if (sp->ring_fd < 0 || (sp->queued == 0 && min_complete == 0))
+    {
+        return 0;
+    }
+
+    int ret;
+    do
+    {
+        ret = print_spool_enter(sp->ring_fd, sp->queued, min_complete,
+                                min_complete ? IORING_ENTER_GETEVENTS : 0);
+    } while (ret < 0 && errno == EINTR);
+    sp->enters++;
+    if (ret < 0)
+    {
+        int err = errno;
+        print_spool_fail(sp, err, done, ctx);
+        return -err;
+    }
+    sp->inflight += (unsigned)ret;
+    sp->queued -= (unsigned)ret;
+    print_spool_reap(sp, done, ctx);
+    return 0;
+}
+
+/**
+ * Obtém um slot livre, esperando uma conclusão se todos estiverem em uso
+ *
+ * @return Índice do slot
+ */
+static inline int print_spool_slot(PrintSpool *sp, PrintSpoolDone done, void *ctx)
+{
+    while (sp->num_free == 0)
+    {
+        print_spool_submit(sp, 1, done, ctx);
+    }
+    return sp->free_slots[--sp->num_free];
+}
+
+/**
+ * Grava dados no final do spool
+ *
+ * Com io_uring, a gravação é apenas enfileirada (submetida em lote) e os dados devem
+ * permanecer válidos até a conclusão. Sem io_uring, grava e conclui imediatamente.
+ *
+ * @param sp Spool
+ * @param slot Slot obtido com print_spool_slot
+ * @param data Dados (dentro da área registrada, se houver)
+ * @param length Tamanho dos dados
+ * @param done Função de conclusão
+ * @param ctx Contexto da função de conclusão
+ */
+static inline void print_spool_write(PrintSpool *sp, int slot, const void *data, size_t length,
+                                     PrintSpoolDone done, void *ctx)
+{
+    PrintSpoolWrite *w = &sp->pending[slot];
+
+    w->data = data;
+    w->length = length;
+    w->written = 0;
+    w->offset = sp->offset;
+    sp->offset += (off_t)length;
+
+    if (sp->ring_fd < 0)
+    {
+        print_spool_complete(sp, slot, print_spool_pwrite(sp, slot), done, ctx);
+        return;
+    }
+
+    print_spool_queue(sp, slot);
+    if (sp->queued >= PRINT_SPOOL_BATCH)
+    {
+        print_spool_submit(sp, 0, done, ctx);
+    }
+}
+
+/**
+ * Submete as entradas acumuladas e consome as conclusões disponíveis
+ *
+ * Chamada antes de a impressora esperar por documentos, para que nenhuma gravação
+ * fique parada na fila de submissão (nem o restante de uma gravação parcial).
+ *
+ * @return 0 em caso de sucesso, -errno se io_uring_enter falhou
+ */
+static inline int print_spool_flush(PrintSpool *sp, PrintSpoolDone done, void *ctx)
+{
+    int ret = 0;
+
+    while (ret == 0 && sp->ring_fd >= 0 && sp->queued > 0)
+    {
+        ret = print_spool_submit(sp, 0, done, ctx);
+    }
+    if (sp->ring_fd >= 0)
+    {
+        print_spool_reap(sp, done, ctx);
+    }
+    return ret;
+}
+
+/**
+ * Espera todas as gravações do spool
+ *
+ * @return 0 em caso de sucesso, -errno se io_uring_enter falhou (as gravações
+ *         restantes foram feitas com pwrite ou concluídas com a falha)
+ */
+static inline int print_spool_drain(PrintSpool *sp, PrintSpoolDone done, void *ctx)
+{
+    int ret = 0;
+
+    while (ret == 0 && sp->ring_fd >= 0 && sp->queued + sp->inflight > 0)
+    {
+        ret = print_spool_submit(sp, 1, done, ctx);
+    }
+    return ret;
+}
+
+/**
+ * Descritor a monitorar (epoll) para saber que há conclusões, ou -1 sem io_uring
+ */
+static inline int print_spool_poll_fd(const PrintSpool *sp)
+{
+    return sp->ring_fd;
+}
+
+/**
+ * Fecha o spool (as gravações devem ter sido esperadas com print_spool_drain)
+ */
+static inline void print_spool_close(PrintSpool *sp)
+{
+    if (sp->ring_fd >= 0)
+    {
+        print_spool_ring_close(sp);
+    }
+    if (sp->fd >= 0)
+    {
+        close(sp->fd);
+        sp->fd = -1;
+    }
+}
+
+#endif // PRINT_SPOOL_H
@@ -0,0 +1,218 @@
+/**
+ * Canal SPSC sem Locks (um produtor, um consumidor)
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * O produtor escreve somente tail e o consumidor somente head, cada um em sua
+ * própria linha de cache. Cada lado mantém uma cópia do índice do outro e só a
+ * recarrega quando a cópia indica canal cheio (produtor) ou vazio (consumidor), de
+ * modo que inserir e remover nunca bloqueiam um mutex nem fazem chamada de sistema.
+ *
+ * Características:
+ * - Elementos de tamanho fixo copiados com memcpy, para servir ao Document de cada
+ *   programa; o buffer é alocado pelo chamador (por exemplo, no nó NUMA do buffer)
+ * - print_spsc_claim/print_spsc_publish escrevem direto na posição livre, para quem
+ *   precisa completar o elemento no momento da inserção
+ * - Fechamento: o produtor fecha o canal depois de publicar o último elemento; um
+ *   consumidor que viu o canal fechado antes de encontrá-lo vazio pode encerrar
+ * - Espera progressiva (print_spsc_backoff): gira, cede a CPU e por fim dorme
+ *
+ * Uso:
+ *   print_spsc_init(&canal, buffer, capacidade, sizeof(Document));
+ *   while (!print_spsc_try_insert(&canal, &doc, &pos))     // produtor
+ *       print_spsc_backoff(&tentativas);
+ *   print_spsc_close(&canal);                              // produtor, ao terminar
+ *   fechado = print_spsc_closed(&canal);                   // consumidor
+ *   if (!print_spsc_try_remove(&canal, &doc, &pos) && fechado)
+ *       ...                                                // canal esgotado
+ */
+
+#ifndef PRINT_SPSC_H
+#define PRINT_SPSC_H
+
+#include <stddef.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+/**
+ * Parâmetros do canal
+ */
+#define PRINT_SPSC_CACHE_LINE 64       // Tamanho da linha de cache
+#define PRINT_SPSC_SPIN_ITERATIONS 64  // Iterações com pausa de CPU
+#define PRINT_SPSC_YIELD_ITERATIONS 64 // Iterações com sched_yield
+#define PRINT_SPSC_SLEEP_US 100        // Sono entre verificações após esgotar as anteriores
+
+/**
+ * Canal SPSC
+ */
+typedef struct
+{
+    // Lado do produtor
+    _Alignas(PRINT_SPSC_CACHE_LINE) atomic_size_t tail; // Próxima posição de inserção
+    size_t cached_head;                                 // Última cópia conhecida de head
+
+    // Lado do consumidor
+    _Alignas(PRINT_SPSC_CACHE_LINE) atomic_size_t head; // Próxima posição de remoção
+    size_t cached_tail;                                 // Última cópia conhecida de tail
+
+    // Estado compartilhado
+    _Alignas(PRINT_SPSC_CACHE_LINE) atomic_int closed; // Produtor finalizou
+    char *buffer;                                      // Buffer circular do canal
+    size_t size;                                       // Tamanho de cada elemento
+    size_t capacity;                                   // Capacidade do canal (potência de dois)
+    size_t mask;                                       // capacity - 1
+} PrintSpscChannel;
+
+/**
+ * Inicializa um canal sobre um buffer do chamador
+ *
+ * @param c Canal
+ * @param buffer Buffer com capacity elementos (liberado pelo chamador)
+ * @param capacity Capacidade (potência de dois)
+ * @param size Tamanho de cada elemento
+ */
+static inline void print_spsc_init(PrintSpscChannel *c, void *buffer, size_t capacity, size_t size)
+{
+    atomic_init(&c->tail, 0);
+    atomic_init(&c->head, 0);
+    atomic_init(&c->closed, 0);
+    c->cached_head = 0;
+    c->cached_tail = 0;
+    c->buffer = buffer;
+    c->size = size;
+    c->capacity = capacity;
+    c->mask = capacity - 1;
+}
+
+/**
+ * Posição livre para o próximo elemento, sem publicá-lo (somente o produtor)
+ *
+ * @param c Canal
+ * @param pos Recebe o índice da posição
+ * @return Posição a preencher, ou NULL se o canal estiver cheio
+ */
+static inline void *print_spsc_claim(PrintSpscChannel *c, size_t *pos)
+{
+    size_t tail = atomic_load_explicit(&c->tail, memory_order_relaxed);
+
+    if (tail - c->cached_head == c->capacity)
+    {
+        c->cached_head = atomic_load_explicit(&c->head, memory_order_acquire);
+        if (tail - c->cached_head == c->capacity)
+        {
+            return NULL;
+        }
+    }
+    *pos = tail & c->mask;
+    return c->buffer + *pos * c->size;
+}
+
+/**
+ * Publica o elemento preenchido na posição obtida com print_spsc_claim
+ */
+static inline void print_spsc_publish(PrintSpscChannel *c)
+{
+    size_t tail = atomic_load_explicit(&c->tail, memory_order_relaxed);
+
+    atomic_store_explicit(&c->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * Tenta inserir um elemento sem bloquear (somente o produtor)
+ *
+ * @param c Canal
+ * @param elem Elemento a copiar
+ * @param pos Recebe a posição ocupada pelo elemento
+ * @return 1 se o elemento foi inserido, 0 se o canal estava cheio
+ */
+static inline int print_spsc_try_insert(PrintSpscChannel *c, const void *elem, size_t *pos)
+{
+    void *slot = print_spsc_claim(c, pos);
+
+    if (slot == NULL)
+    {
+        return 0;
+    }
+    memcpy(slot, elem, c->size);
+    print_spsc_publish(c);
+    return 1;
+}
+
+/**
+ * Tenta remover um elemento sem bloquear (somente o consumidor)
+ *
+ * @param c Canal
+ * @param elem Recebe o elemento removido
+ * @param pos Recebe a posição liberada (pode ser NULL)
+ * @return 1 se um elemento foi removido, 0 se o canal estava vazio
+ */
+static inline int print_spsc_try_remove(PrintSpscChannel *c, void *elem, size_t *pos)
+{
+    size_t head = atomic_load_explicit(&c->head, memory_order_relaxed);
+
+    if (head == c->cached_tail)
+    {
+        c->cached_tail = atomic_load_explicit(&c->tail, memory_order_acquire);
+        if (head == c->cached_tail)
+        {
+            return 0;
+        }
+    }
+
+    memcpy(elem, c->buffer + (head & c->mask) * c->size, c->size);
+    if (pos != NULL)
+    {
+        *pos = head & c->mask;
+    }
+    atomic_store_explicit(&c->head, head + 1, memory_order_release);
+    return 1;
+}
+
+/**
+ * Fecha o canal depois de publicar o último elemento (somente o produtor)
+ */
+static inline void print_spsc_close(PrintSpscChannel *c)
+{
+    atomic_store_explicit(&c->closed, 1, memory_order_release);
+}
+
+/**
+ * Indica se o produtor fechou o canal
+ *
+ * Lido antes de uma tentativa de remoção: se o canal já estava fechado e a remoção
+ * falhou, não haverá mais elementos.
+ */
+static inline int print_spsc_closed(PrintSpscChannel *c)
+{
+    return atomic_load_explicit(&c->closed, memory_order_acquire);
+}
+
+/**
+ * Espera progressiva: gira, cede a CPU e por fim dorme
+ *
+ * @param attempt Número de tentativas já realizadas (incrementado pela função)
+ */
+static inline void print_spsc_backoff(int *attempt)
+{
+    if (*attempt < PRINT_SPSC_SPIN_ITERATIONS)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+    else if (*attempt < PRINT_SPSC_SPIN_ITERATIONS + PRINT_SPSC_YIELD_ITERATIONS)
+    {
+        sched_yield();
+    }
+    else
+    {
+        usleep(PRINT_SPSC_SLEEP_US);
+        return;
+    }
+    (*attempt)++;
+}
+
+#endif // PRINT_SPSC_H
@@ -0,0 +1,351 @@
+/**
+ * Estatísticas de Vazão e Latência do Sistema de Fila de Impressão
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor e pelo
+ * script de benchmark (bench/bench_print_queue.sh). Cada documento recebe a marca de
+ * tempo do momento em que foi inserido no buffer; cada impressora registra, em
+ * histogramas próprios no estilo HDR (print_hdr.h, sem locks), o tempo de espera na
+ * fila (inserção → remoção) e o tempo de serviço (remoção → fim da impressão).
+ *
+ * Ao final da execução os histogramas são somados e o programa informa, em uma linha
+ * CSV ou JSON:
+ * - Vazão (documentos por segundo)
+ * - Espera na fila nos percentis 50, 99 e 99,9 (ns)
+ * - Trocas de contexto (voluntárias + involuntárias) por documento
+ * - Tempo de serviço nos percentis 50, 99 e 99,9 (ns)
+ *
+ * Relatório sob demanda:
+ * - Com print_stats_watch_start, o sinal SIGUSR1 escreve em stderr os percentis
+ *   acumulados até o momento, sem interromper a execução (kill -USR1 <pid>)
+ */
+
+#ifndef PRINT_STATS_H
+#define PRINT_STATS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <sys/resource.h>
+
+#include "print_config.h"
+#include "print_hdr.h"
+
+/**
+ * Latências registradas por uma impressora
+ */
+typedef struct
+{
+    PrintHdrHistogram queue_wait; // Inserção → remoção (ns)
+    PrintHdrHistogram service;    // Remoção → fim da impressão (ns)
+} PrintLatencyRecorder;
+
+/**
+ * Medições globais de uma execução
+ */
+typedef struct
+{
+    uint64_t start_ns;   // Início da execução (CLOCK_MONOTONIC)
+    uint64_t end_ns;     // Fim da execução
+    long start_switches; // Trocas de contexto do processo no início
+    long end_switches;   // Trocas de contexto do processo no fim
+} PrintStats;
+
+/**
+ * Instante atual em nanossegundos (CLOCK_MONOTONIC)
+ */
+static inline uint64_t print_stats_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Total de trocas de contexto do processo (todas as threads)
+ */
+static inline long print_stats_context_switches(void)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+/**
+ * Registra o tempo de espera de um documento na fila
+ *
+ * Chamada apenas pela impressora dona do registro.
+ *
+ * @param r Latências da impressora
+ * @param latency_ns Tempo entre a inserção e a remoção em nanossegundos
+ */
+static inline void print_latency_record(PrintLatencyRecorder *r, uint64_t latency_ns)
+{
+    print_hdr_record(&r->queue_wait, latency_ns);
+}
+
+/**
+ * Registra o tempo de serviço de um documento
+ *
+ * Chamada apenas pela impressora dona do registro.
+ *
+ * @param r Latências da impressora
+ * @param service_ns Tempo entre a remoção e o fim da impressão em nanossegundos
+ */
+static inline void print_service_record(PrintLatencyRecorder *r, uint64_t service_ns)
+{
+    print_hdr_record(&r->service, service_ns);
+}
+
+/**
+ * Zera os registros de latência
+ *
+ * Os histogramas não alocam memória; o vetor em si é liberado pelo chamador.
+ *
+ * @param recorders Latências das impressoras
+ * @param n Número de impressoras
+ */
+static inline void print_latency_free(PrintLatencyRecorder *recorders, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        print_hdr_reset(&recorders[i].queue_wait);
+        print_hdr_reset(&recorders[i].service);
+    }
+}
+
+/**
+ * Soma as latências de todas as impressoras
+ *
+ * @param recorders Latências das impressoras
+ * @param n Número de impressoras
+ * @return Registro somado (liberar com free) ou NULL em caso de falha
+ */
+static inline PrintLatencyRecorder *print_latency_merge(const PrintLatencyRecorder *recorders, int n)
+{
+    PrintLatencyRecorder *all = calloc(1, sizeof(PrintLatencyRecorder));
+
+    if (all == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar memória para estatísticas\n");
+        return NULL;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        print_hdr_merge(&all->queue_wait, &recorders[i].queue_wait);
+        print_hdr_merge(&all->service, &recorders[i].service);
+    }
+    return all;
+}
+
+/**
+ * Marca o início de uma execução
+ */
+static inline void print_stats_begin(PrintStats *s)
+{
+    s->start_switches = print_stats_context_switches();
+    s->start_ns = print_stats_now();
+}
+
+/**
+ * Marca o fim de uma execução
+ */
+static inline void print_stats_end(PrintStats *s)
+{
+    s->end_ns = print_stats_now();
+    s->end_switches = print_stats_context_switches();
+}
+
+/**
+ * Soma os histogramas e escreve a linha de resultados
+ *
+ * Colunas (CSV): impl,producers,consumers,buffer_size,documents,elapsed_s,ops_per_sec,
+ * p50_ns,p99_ns,p999_ns,ctx_switches_per_op,svc_p50_ns,svc_p99_ns,svc_p999_ns
+ *
+ * @param impl Nome da implementação
+ * @param cfg Configuração da execução
+ * @param s Medições globais
+ * @param recorders Latências das impressoras
+ * @param n Número de impressoras
+ */
+static inline void print_stats_report(const char *impl, const PrintConfig *cfg, const PrintStats *s,
+                                      const PrintLatencyRecorder *recorders, int n)
+{
+    PrintLatencyRecorder *all = print_latency_merge(recorders, n);
+    if (all == NULL)
+    {
+        return;
+    }
+
+    size_t total = (size_t)print_hdr_count(&all->queue_wait);
+    double elapsed = (s->end_ns - s->start_ns) / 1e9;
+    double ops = elapsed > 0 ? total / elapsed : 0;
+    double switches = total ? (double)(s->end_switches - s->start_switches) / total : 0;
+    uint64_t p50 = print_hdr_percentile(&all->queue_wait, 50.0);
+    uint64_t p99 = print_hdr_percentile(&all->queue_wait, 99.0);
+    uint64_t p999 = print_hdr_percentile(&all->queue_wait, 99.9);
+    uint64_t svc50 = print_hdr_percentile(&all->service, 50.0);
+    uint64_t svc99 = print_hdr_percentile(&all->service, 99.0);
+    uint64_t svc999 = print_hdr_percentile(&all->service, 99.9);
+
+    if (cfg->stats_format == PRINT_STATS_JSON)
+    {
+        printf("{\"impl\":\"%s\",\"producers\":%d,\"consumers\":%d,\"buffer_size\":%zu,"
+               "\"documents\":%zu,\"elapsed_s\":%.6f,\"ops_per_sec\":%.1f,\"p50_ns\":%llu,"
+               "\"p99_ns\":%llu,\"p999_ns\":%llu,\"ctx_switches_per_op\":%.4f,"
+               "\"svc_p50_ns\":%llu,\"svc_p99_ns\":%llu,\"svc_p999_ns\":%llu}\n",
+               impl, cfg->num_producers, cfg->num_consumers, cfg->buffer_size, total, elapsed, ops,
+               (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)p999, switches,
+               (unsigned long long)svc50, (unsigned long long)svc99, (unsigned long long)svc999);
+    }
+    else
+    {
+        printf("%s,%d,%d,%zu,%zu,%.6f,%.1f,%llu,%llu,%llu,%.4f,%llu,%llu,%llu\n",
+               impl, cfg->num_producers, cfg->num_consumers, cfg->buffer_size, total, elapsed, ops,
+               (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)p999, switches,
+               (unsigned long long)svc50, (unsigned long long)svc99, (unsigned long long)svc999);
+    }
+    fflush(stdout);
+
+    free(all);
+}
+
+/**
+ * Escreve um resumo legível dos percentis acumulados
+ *
+ * Pode ser chamada com as impressoras em execução (relatório por SIGUSR1).
+ *
+ * @param out Destino (stdout ao final, stderr sob demanda)
+ * @param impl Nome da implementação
+ * @param recorders Latências das impressoras
+ * @param n Número de impressoras
+ */
+static inline void print_stats_summary(FILE *out, const char *impl, const PrintLatencyRecorder *recorders, int n)
+{
+    static const char *names[] = {"espera na fila", "serviço"};
+    PrintLatencyRecorder *all = print_latency_merge(recorders, n);
+
+    if (all == NULL)
+    {
+        return;
+    }
+
+    const PrintHdrHistogram *histograms[] = {&all->queue_wait, &all->service};
+    for (int i = 0; i < 2; i++)
+    {
+        const PrintHdrHistogram *h = histograms[i];
+        fprintf(out, "Latência %s (%s): %llu documentos, p50 %llu ns, p90 %llu ns, p99 %llu ns, "
+                     "p99,9 %llu ns, máx %llu ns\n",
+                names[i], impl, (unsigned long long)print_hdr_count(h),
+                (unsigned long long)print_hdr_percentile(h, 50.0),
+                (unsigned long long)print_hdr_percentile(h, 90.0),
+                (unsigned long long)print_hdr_percentile(h, 99.0),
+                (unsigned long long)print_hdr_percentile(h, 99.9),
+                (unsigned long long)atomic_load_explicit(&h->max, memory_order_relaxed));
+    }
+    fflush(out);
+
+    free(all);
+}
+
+/**
+ * Relatório de latências sob demanda (SIGUSR1)
+ *
+ * O tratador do sinal apenas incrementa um semáforo (sem_post é seguro em
+ * tratadores); uma thread própria espera o semáforo, soma os histogramas e escreve o
+ * resumo. Assim o sinal pode chegar a qualquer thread do processo.
+ */
+typedef struct
+{
+    const char *impl;                      // Nome da implementação
+    const PrintLatencyRecorder *recorders; // Latências das impressoras
+    int n;                                 // Número de impressoras
+    sem_t requests;                        // Pedidos de relatório
+    atomic_int stop;                       // Encerra a thread de relatório
+    pthread_t thread;                      // Thread de relatório
+    struct sigaction previous;             // Tratamento anterior de SIGUSR1
+} PrintStatsWatch;
+
+static PrintStatsWatch print_stats_watch;
+
+/**
+ * Tratador de SIGUSR1: pede um relatório
+ */
+static inline void print_stats_on_signal(int sig)
+{
+    (void)sig;
+    sem_post(&print_stats_watch.requests);
+}
+
+/**
+ * Thread de relatório: escreve o resumo a cada SIGUSR1
+ */
+static inline void *print_stats_watcher(void *arg)
+{
+    (void)arg;
+    for (;;)
+    {
+        while (sem_wait(&print_stats_watch.requests) != 0 && errno == EINTR)
+        {
+        }
+        if (atomic_load(&print_stats_watch.stop))
+        {
+            return NULL;
+        }
+        print_stats_summary(stderr, print_stats_watch.impl, print_stats_watch.recorders, print_stats_watch.n);
+    }
+}
+
+/**
+ * Instala o tratador de SIGUSR1 e inicia a thread de relatório
+ *
+ * @param impl Nome da implementação
+ * @param recorders Latências das impressoras (válidas até print_stats_watch_stop)
+ * @param n Número de impressoras
+ * @return 0 em caso de sucesso, -1 em caso de erro
+ */
+static inline int print_stats_watch_start(const char *impl, const PrintLatencyRecorder *recorders, int n)
+{
+    struct sigaction action;
+
+    print_stats_watch.impl = impl;
+    print_stats_watch.recorders = recorders;
+    print_stats_watch.n = n;
+    atomic_init(&print_stats_watch.stop, 0);
+    if (sem_init(&print_stats_watch.requests, 0, 0) != 0 ||
+        pthread_create(&print_stats_watch.thread, NULL, print_stats_watcher, NULL) != 0)
+    {
+        return -1;
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = print_stats_on_signal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    return sigaction(SIGUSR1, &action, &print_stats_watch.previous);
+}
+
+/**
+ * Restaura o tratamento anterior de SIGUSR1 e encerra a thread de relatório
+ */
+static inline void print_stats_watch_stop(void)
+{
+    sigaction(SIGUSR1, &print_stats_watch.previous, NULL);
+    atomic_store(&print_stats_watch.stop, 1);
+    sem_post(&print_stats_watch.requests);
+    pthread_join(print_stats_watch.thread, NULL);
+    sem_destroy(&print_stats_watch.requests);
+}
+
+#endif // PRINT_STATS_H
@@ -0,0 +1,461 @@
+/**
+ * Sistema de Fila de Impressão - Implementação com Corrotinas (M:N)
+ *
+ * Nas demais versões cada produtor é uma thread do sistema, o que não representa
+ * dezenas de milhares de aplicações clientes enviando documentos. Aqui produtores
+ * e impressoras são corrotinas (print_coro.h) executadas por um pequeno grupo de
+ * threads (workers), e esperar por espaço ou por documentos suspende apenas a
+ * corrotina.
+ *
+ * Características Principais:
+ * - Número de clientes configurável com --clients (até PRINT_MAX_CLIENTS); sem a
+ *   opção, -p clientes
+ * - Workers configuráveis com --workers (padrão: um por processador)
+ * - Pilha de cada corrotina configurável com --coro-stack-kb
+ * - Buffer circular único protegido por mutex, como na versão com mutex, com listas
+ *   de corrotinas (print_coro_wait) no lugar das variáveis de condição
+ * - Atrasos simulados com print_coro_sleep, sem bloquear o worker
+ *
+ * Memória por cliente:
+ * Ao final são exibidos o bloco de controle de cada corrotina, a memória residente
+ * das pilhas (mincore) e o aumento do pico de RSS do processo, todos divididos pelo
+ * número de corrotinas.
+ *
+ * Desligamento: o mesmo protocolo da versão com mutex. O último produtor acorda
+ * todas as impressoras, que drenam o buffer e encerram.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <sys/resource.h>
+
+#include "print_config.h"
+#include "print_coro.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_trace.h"
+
+/**
+ * Constantes de Configuração do Sistema
+ *
+ * Capacidade do buffer, número de clientes, impressoras, workers e documentos por
+ * cliente são definidos em tempo de execução (veja print_config.h).
+ */
+#define MAX_TYPE_LENGTH 20 // Tamanho máximo para o tipo do documento
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_CORO | PRINT_OPT_TRACE)
+
+/**
+ * Códigos de Erro do Sistema
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_MUTEX -1   // Falha na inicialização do mutex
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_EMPTY -5   // Buffer vazio e sem produtores ativos
+#define PRINT_ERR_NOMEM -6   // Falha na alocação do buffer
+
+/**
+ * Estrutura do Documento
+ */
+typedef struct
+{
+    long id;                    // Identificador único do documento
+    char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "PDF", "DOC")
+    int size;                   // Tamanho do documento em KB
+    int producer_id;            // ID da aplicação produtora
+    uint64_t enqueue_ns;        // Momento da inserção no buffer (CLOCK_MONOTONIC)
+} Document;
+
+/**
+ * Estrutura da Fila de Impressão
+ *
+ * As listas de espera têm o papel das variáveis de condição da versão com mutex e
+ * são protegidas pelo mesmo mutex do buffer.
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;       // Exclusão mútua do buffer
+    PrintCoroWaitList not_full;  // Produtores esperando espaço livre
+    PrintCoroWaitList not_empty; // Impressoras esperando documentos
+    size_t in;                   // Próxima posição de inserção
+    size_t out;                  // Próxima posição de remoção
+    size_t count;                // Documentos no buffer
+    int active_producers;        // Produtores que ainda não terminaram
+    atomic_int should_stop;      // Flag para desligamento do sistema
+    Document *buffer;            // Buffer circular
+} PrintQueue;
+
+// Instância global da fila de impressão
+PrintQueue print_queue;
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências inserção → remoção registradas por cada impressora
+PrintLatencyRecorder *latency;
+
+/**
+ * Inicializa a fila de impressão
+ *
+ * @param num_producers Número de produtores
+ * @return PRINT_SUCCESS, PRINT_ERR_NOMEM ou PRINT_ERR_MUTEX
+ */
+int init_print_queue(int num_producers)
+{
+    print_queue.buffer = calloc(config.buffer_size, sizeof(Document));
+    if (print_queue.buffer == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar buffer de %zu posições: %s\n", config.buffer_size, strerror(errno));
+        return PRINT_ERR_NOMEM;
+    }
+    if (pthread_mutex_init(&print_queue.mutex, NULL) != 0)
+    {
+        return PRINT_ERR_MUTEX;
+    }
+    print_queue.in = 0;
+    print_queue.out = 0;
+    print_queue.count = 0;
+    print_queue.active_producers = num_producers;
+    atomic_init(&print_queue.should_stop, 0);
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Libera recursos da fila de impressão
+ */
+void cleanup_print_queue(void)
+{
+    pthread_mutex_destroy(&print_queue.mutex);
+    free(print_queue.buffer);
+    print_queue.buffer = NULL;
+}
+
+/**
+ * Insere um documento no buffer, suspendendo a corrotina enquanto ele estiver cheio
+ *
+ * @param doc Documento a ser inserido
+ * @param pos Recebe a posição ocupada no buffer
+ * @return PRINT_SUCCESS ou PRINT_ERR_STOPPED se o sistema estiver em desligamento
+ */
+int print_queue_insert(Document *doc, size_t *pos)
+{
+    pthread_mutex_lock(&print_queue.mutex);
+    while (print_queue.count == config.buffer_size && !atomic_load(&print_queue.should_stop))
+    {
+        print_coro_wait(&print_queue.not_full, &print_queue.mutex);
+    }
+    if (atomic_load(&print_queue.should_stop))
+    {
+        pthread_mutex_unlock(&print_queue.mutex);
+        return PRINT_ERR_STOPPED;
+    }
+
+    *pos = print_queue.in;
+    doc->enqueue_ns = print_stats_now();
+    print_queue.buffer[*pos] = *doc;
+    print_queue.in = (print_queue.in + 1) & config.buffer_mask;
+    print_queue.count++;
+    print_coro_signal(&print_queue.not_empty);
+    pthread_mutex_unlock(&print_queue.mutex);
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Remove um documento do buffer, suspendendo a corrotina enquanto ele estiver vazio
+ *
+ * @param doc Recebe o documento removido
+ * @param pos Recebe a posição liberada no buffer
+ * @return PRINT_SUCCESS ou PRINT_ERR_EMPTY se o buffer estiver vazio e sem produtores
+ */
+int print_queue_remove(Document *doc, size_t *pos)
+{
+    pthread_mutex_lock(&print_queue.mutex);
+    while (print_queue.count == 0 && print_queue.active_producers > 0 && !atomic_load(&print_queue.should_stop))
+    {
+        print_coro_wait(&print_queue.not_empty, &print_queue.mutex);
+    }
+    if (print_queue.count == 0 || atomic_load(&print_queue.should_stop))
+    {
+        print_coro_signal(&print_queue.not_empty); // Repassa o fim à próxima impressora (cascata)
+        pthread_mutex_unlock(&print_queue.mutex);
+        return PRINT_ERR_EMPTY;
+    }
+
+    *pos = print_queue.out;
+    *doc = print_queue.buffer[*pos];
+    print_queue.out = (print_queue.out + 1) & config.buffer_mask;
+    print_queue.count--;
+    print_coro_signal(&print_queue.not_full);
+    pthread_mutex_unlock(&print_queue.mutex);
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Corrotina Produtora
+ *
+ * Simula uma aplicação cliente enviando documentos para a fila de impressão.
+ *
+ * @param arg Ponteiro para o ID do produtor (int)
+ */
+void producer(void *arg)
+{
+    int producer_id = *(int *)arg;
+    int docs_produced = 0;
+    size_t pos;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+
+    while (docs_produced < config.max_documents && !atomic_load(&print_queue.should_stop))
+    {
+        // Cria novo documento com propriedades simuladas
+        Document doc = {
+            .id = ((long)producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
+            .producer_id = producer_id};
+        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH);
+
+        if (print_queue_insert(&doc, &pos) != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        print_log("[Cliente %d] Adicionou documento %ld (%s, %dKB) na posição %zu\n",
+                  producer_id, doc.id, doc.type, doc.size, pos);
+
+        docs_produced++;
+        if (config.simulate_delays)
+        {
+            print_coro_sleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
+    }
+
+    // Remove registro do produtor; o último acorda uma única impressora, e cada
+    // impressora que encontra o fim acorda a seguinte
+    pthread_mutex_lock(&print_queue.mutex);
+    if (--print_queue.active_producers == 0)
+    {
+        print_coro_signal(&print_queue.not_empty);
+    }
+    pthread_mutex_unlock(&print_queue.mutex);
+
+    print_log("[Cliente %d] Finalizou a produção de documentos\n", producer_id);
+}
+
+/**
+ * Corrotina Consumidora
+ *
+ * Simula uma impressora processando documentos do buffer até que não haja
+ * mais produtores ativos nem documentos pendentes.
+ *
+ * @param arg Ponteiro para o ID do consumidor (int)
+ */
+void consumer(void *arg)
+{
+    int consumer_id = *(int *)arg;
+    Document doc;
+    size_t pos;
+
+    while (print_queue_remove(&doc, &pos) == PRINT_SUCCESS)
+    {
+        uint64_t timestamp = print_stats_now();
+        print_latency_record(&latency[consumer_id - 1], timestamp - doc.enqueue_ns);
+        print_log("[Consumidor %d] Imprimindo documento %ld (%s, %dKB) da posição %zu\n",
+                  consumer_id, doc.id, doc.type, doc.size, pos);
+
+        // Simula tempo de impressão proporcional ao tamanho do documento
+        if (config.simulate_delays)
+        {
+            print_coro_sleep((uint64_t)doc.size * 10000);
+        }
+        print_service_record(&latency[consumer_id - 1], print_stats_now() - timestamp);
+    }
+
+    print_log("[Consumidor %d] Não há mais documentos para imprimir, encerrando\n", consumer_id);
+}
+
+/**
+ * Pico de memória residente do processo
+ *
+ * @return Pico de RSS em bytes
+ */
+static size_t peak_rss(void)
+{
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    return (size_t)usage.ru_maxrss * 1024;
+}
+
+/**
+ * Exibe a memória usada por corrotina
+ *
+ * @param rss_before Pico de RSS antes de criar as corrotinas
+ */
+void memory_report(size_t rss_before)
+{
+    int coros = print_coro.num_coros;
+    size_t rss_after = peak_rss();
+    size_t stacks = print_coro_stack_resident();
+    size_t rss_growth = rss_after > rss_before ? rss_after - rss_before : 0;
+
+    printf("Corrotinas: %d em %d workers, %lu trocas de contexto, pilha reservada de %zu KB\n",
+           coros, print_coro.num_workers, print_coro_switches(), print_coro.stack_size / 1024);
+    printf("Memória por cliente: controle %zu B, pilha residente %.1f KB, pico de RSS %.1f KB\n",
+           sizeof(PrintCoro), (double)stacks / coros / 1024, (double)rss_growth / coros / 1024);
+}
+
+/**
+ * Função Principal
+ *
+ * Inicializa o sistema, cria as corrotinas produtoras e consumidoras, executa-as
+ * nos workers até a conclusão e finaliza.
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
+ * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
+ */
+int main(int argc, char *argv[])
+{
+    int *producer_ids;
+    int *consumer_ids;
+    PrintStats stats;
+    size_t rss_before;
+    int num_workers;
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (config.replay_trace != NULL)
+    {
+        // A reprodução espera com clock_nanosleep, o que bloquearia o worker inteiro
+        fprintf(stderr, "--replay-trace não é suportado com corrotinas\n");
+        return EXIT_FAILURE;
+    }
+    if (config.num_clients > 0)
+    {
+        config.num_producers = config.num_clients;
+    }
+
+    // Abre o trace a gravar
+    if (print_trace_init(&config) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    num_workers = config.num_workers;
+    if (num_workers == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cpus < 1 ? 1 : cpus > PRINT_MAX_THREADS ? PRINT_MAX_THREADS : (int)cpus;
+    }
+
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    consumer_ids = calloc(config.num_consumers, sizeof(int));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producer_ids || !consumer_ids || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de corrotinas\n");
+        return EXIT_FAILURE;
+    }
+
+    if (init_print_queue(config.num_producers) != PRINT_SUCCESS)
+    {
+        fprintf(stderr, "Falha ao inicializar a fila de impressão\n");
+        return EXIT_FAILURE;
+    }
+
+    rss_before = peak_rss();
+    if (print_coro_init(num_workers, config.num_producers + config.num_consumers, config.coro_stack_size) != 0)
+    {
+        fprintf(stderr, "Falha ao inicializar as corrotinas\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: buffer de %zu posições, %d clientes, %d impressoras, %d workers\n",
+               config.buffer_size, config.num_producers, config.num_consumers, num_workers);
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+
+    if (print_stats_watch_start("coro", latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar relatório de latências\n");
+        return EXIT_FAILURE;
+    }
+
+    // Cria as corrotinas produtoras e consumidoras, distribuídas entre os workers
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        producer_ids[i] = i + 1;
+        print_coro_spawn(producer, &producer_ids[i]);
+    }
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        consumer_ids[i] = i + 1;
+        print_coro_spawn(consumer, &consumer_ids[i]);
+    }
+
+    // Executa as corrotinas até a conclusão
+    print_stats_begin(&stats);
+    print_trace_start();
+    if (print_coro_run() != 0)
+    {
+        fprintf(stderr, "Falha ao executar as corrotinas\n");
+        return EXIT_FAILURE;
+    }
+
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report("coro", &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, "coro", latency, config.num_consumers);
+        memory_report(rss_before);
+    }
+    print_coro_cleanup();
+    cleanup_print_queue();
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(producer_ids);
+    free(consumer_ids);
+    if (!config.quiet)
+    {
+        printf("Sistema de fila de impressão finalizado com sucesso\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,589 @@
+/**
+ * Sistema de Fila de Impressão - Implementação Lock-Free (MPMC)
+ *
+ * Este programa implementa o mesmo sistema de fila de impressão das versões com mutex,
+ * semáforos e monitor, mas substitui o mutex e as variáveis de condição por um buffer
+ * circular lock-free com múltiplos produtores e múltiplos consumidores (MPMC).
+ *
+ * Cada posição do buffer possui um número de sequência próprio. Produtores e consumidores
+ * reservam posições com uma operação atômica (compare-and-swap) sobre os índices globais
+ * e publicam o resultado atualizando o número de sequência da posição. Sem contenção,
+ * entregar um documento custa poucas operações atômicas, sem mutex e sem chamada de sistema.
+ *
+ * Características Principais:
+ * - Buffer circular com números de sequência por posição
+ * - Índices de inserção e remoção em linhas de cache separadas
+ * - Mesma semântica de inserção/remoção das demais versões (bloqueia se cheio/vazio)
+ * - Mesmo protocolo de desligamento: consumidores drenam o buffer e encerram
+ *   quando não há mais produtores ativos
+ *
+ * Espera:
+ * - Quando o buffer está cheio (ou vazio) a thread gira brevemente, depois cede a CPU
+ *   (sched_yield) e, persistindo a espera, dorme por intervalos curtos
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_trace.h"
+#include "print_affinity.h"
+
+/**
+ * Constantes de Configuração do Sistema
+ *
+ * Capacidade do buffer, número de produtores e consumidores e documentos por produtor
+ * são definidos em tempo de execução (veja print_config.h). A capacidade é sempre
+ * potência de dois: o índice da posição é obtido com uma máscara em vez de divisão.
+ */
+#define MAX_TYPE_LENGTH 20 // Tamanho máximo para o tipo do documento
+#define CACHE_LINE_SIZE 64 // Tamanho da linha de cache
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_TRACE | PRINT_OPT_AFFINITY)
+
+/**
+ * Parâmetros da espera ativa
+ *
+ * Número de iterações girando e cedendo a CPU antes de dormir, e duração do sono.
+ */
+#define SPIN_ITERATIONS 64   // Iterações com pausa de CPU
+#define YIELD_ITERATIONS 64  // Iterações com sched_yield
+#define BACKOFF_SLEEP_US 100 // Sono entre verificações após esgotar as anteriores
+#define MIN_CAPACITY 2       // Com uma posição, a sequência pos + 1 significa "cheia" e "livre"
+
+/**
+ * Códigos de Erro do Sistema
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_EMPTY -5   // Buffer vazio e sem produtores ativos
+#define PRINT_ERR_NOMEM -6   // Falha na alocação do buffer
+#define PRINT_ERR_INVALID -7 // Capacidade não suportada
+
+/**
+ * Estrutura do Documento
+ */
+typedef struct
+{
+    int id;                     // Identificador único do documento
+    char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "PDF", "DOC")
+    int size;                   // Tamanho do documento em KB
+    int producer_id;            // ID da aplicação produtora
+    uint64_t enqueue_ns;        // Momento da inserção no buffer (CLOCK_MONOTONIC)
+} Document;
+
+/**
+ * Posição do Buffer
+ *
+ * O número de sequência indica o estado da posição:
+ * - seq == pos:     livre para o produtor que reservar a posição pos
+ * - seq == pos + 1: contém um documento para o consumidor que reservar pos
+ */
+typedef struct
+{
+    atomic_size_t seq; // Número de sequência da posição
+    Document doc;      // Documento armazenado
+} Slot;
+
+/**
+ * Estrutura da Fila de Impressão Lock-Free
+ *
+ * Os índices de inserção e remoção ficam em linhas de cache distintas para que
+ * produtores e consumidores não invalidem a linha uns dos outros.
+ */
+typedef struct
+{
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t in;  // Próxima posição a ser reservada por produtores
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t out; // Próxima posição a ser reservada por consumidores
+
+    // Estado do Sistema
+    _Alignas(CACHE_LINE_SIZE) atomic_int active_producers; // Número de threads produtoras ativas
+    atomic_int should_stop;                                // Flag para desligamento do sistema
+
+    // Gerenciamento do Buffer (somente leitura após a inicialização)
+    _Alignas(CACHE_LINE_SIZE) Slot *buffer; // Buffer circular de documentos
+    size_t capacity;                        // Capacidade do buffer (potência de dois)
+    size_t mask;                            // capacity - 1, aplicada às posições
+} PrintQueue;
+
+// Instância global da fila de impressão
+PrintQueue print_queue;
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências inserção → remoção registradas por cada consumidor
+PrintLatencyRecorder *latency;
+
+/**
+ * Pausa curta usada dentro de laços de espera ativa
+ */
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Espera progressiva: gira, cede a CPU e por fim dorme
+ *
+ * @param attempt Número de tentativas já realizadas (incrementado pela função)
+ */
+static void backoff(int *attempt)
+{
+    if (*attempt < SPIN_ITERATIONS)
+    {
+        cpu_relax();
+    }
+    else if (*attempt < SPIN_ITERATIONS + YIELD_ITERATIONS)
+    {
+        sched_yield();
+    }
+    else
+    {
+        usleep(BACKOFF_SLEEP_US);
+        return;
+    }
+    (*attempt)++;
+}
+
+/**
+ * Inicializa o sistema de fila de impressão
+ *
+ * Cada posição começa com número de sequência igual ao seu índice (livre). O anel
+ * precisa de ao menos duas posições: com uma só, a sequência pos + 1 indicaria ao
+ * mesmo tempo "ocupada em pos" e "livre em pos + 1", e produtores sobrescreveriam
+ * documentos ainda não lidos.
+ *
+ * O número de produtores ativos é definido antes da criação das threads para que
+ * nenhum consumidor encerre antes de os produtores começarem.
+ *
+ * @param capacity Capacidade do buffer (potência de dois)
+ * @param num_producers Número de produtores
+ * @return PRINT_SUCCESS, PRINT_ERR_INVALID ou PRINT_ERR_NOMEM
+ */
+int init_print_queue(size_t capacity, int num_producers)
+{
+    if (capacity < MIN_CAPACITY)
+    {
+        fprintf(stderr, "O buffer lock-free precisa de ao menos %d posições (--buffer-size %zu)\n", MIN_CAPACITY,
+                capacity);
+        return PRINT_ERR_INVALID;
+    }
+    print_queue.buffer = calloc(capacity, sizeof(Slot));
+    if (print_queue.buffer == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar buffer de %zu posições: %s\n", capacity, strerror(errno));
+        return PRINT_ERR_NOMEM;
+    }
+    print_affinity_bind(print_queue.buffer, capacity * sizeof(Slot));
+    print_queue.capacity = capacity;
+    print_queue.mask = capacity - 1;
+
+    atomic_init(&print_queue.in, 0);
+    atomic_init(&print_queue.out, 0);
+    atomic_init(&print_queue.active_producers, num_producers);
+    atomic_init(&print_queue.should_stop, 0);
+
+    for (size_t i = 0; i < capacity; i++)
+    {
+        atomic_init(&print_queue.buffer[i].seq, i);
+    }
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Libera recursos da fila de impressão
+ */
+void cleanup_print_queue(void)
+{
+    free(print_queue.buffer);
+    print_queue.buffer = NULL;
+}
+
+/**
+ * Tenta inserir um documento sem bloquear
+ *
+ * @param doc Documento a ser inserido
+ * @param pos Recebe a posição lógica ocupada pelo documento
+ * @return 1 se o documento foi inserido, 0 se o buffer estava cheio
+ */
+int print_queue_try_insert(const Document *doc, size_t *pos)
+{
+    size_t p = atomic_load_explicit(&print_queue.in, memory_order_relaxed);
+
+    for (;;)
+    {
+        Slot *slot = &print_queue.buffer[p & print_queue.mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)p;
+
+        if (diff == 0)
+        {
+            // Posição livre: tenta reservá-la
+            if (atomic_compare_exchange_weak_explicit(&print_queue.in, &p, p + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                slot->doc = *doc;
+                slot->doc.enqueue_ns = print_stats_now();
+                atomic_store_explicit(&slot->seq, p + 1, memory_order_release);
+                *pos = p;
+                return 1;
+            }
+            // Falha do CAS já recarregou p
+        }
+        else if (diff < 0)
+        {
+            // Posição ainda ocupada por um documento de uma volta anterior: buffer cheio
+            return 0;
+        }
+        else
+        {
+            // Outro produtor reservou a posição: recarrega o índice
+            p = atomic_load_explicit(&print_queue.in, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Tenta remover um documento sem bloquear
+ *
+ * @param doc Recebe o documento removido
+ * @param pos Recebe a posição lógica de onde o documento foi removido
+ * @return 1 se um documento foi removido, 0 se o buffer estava vazio
+ */
+int print_queue_try_remove(Document *doc, size_t *pos)
+{
+    size_t p = atomic_load_explicit(&print_queue.out, memory_order_relaxed);
+
+    for (;;)
+    {
+        Slot *slot = &print_queue.buffer[p & print_queue.mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)seq - (ptrdiff_t)(p + 1);
+
+        if (diff == 0)
+        {
+            // Posição contém documento: tenta reservá-la
+            if (atomic_compare_exchange_weak_explicit(&print_queue.out, &p, p + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                *doc = slot->doc;
+                // Libera a posição para a próxima volta do buffer
+                atomic_store_explicit(&slot->seq, p + print_queue.capacity, memory_order_release);
+                *pos = p;
+                return 1;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Nenhum documento publicado nesta posição: buffer vazio
+            return 0;
+        }
+        else
+        {
+            // Outro consumidor reservou a posição: recarrega o índice
+            p = atomic_load_explicit(&print_queue.out, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Insere um documento, aguardando enquanto o buffer estiver cheio
+ *
+ * @param doc Documento a ser inserido
+ * @param pos Recebe a posição lógica ocupada pelo documento
+ * @return PRINT_SUCCESS ou PRINT_ERR_STOPPED se o sistema estiver em desligamento
+ */
+int print_queue_insert(const Document *doc, size_t *pos)
+{
+    int attempt = 0;
+
+    while (!print_queue_try_insert(doc, pos))
+    {
+        if (atomic_load_explicit(&print_queue.should_stop, memory_order_relaxed))
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        backoff(&attempt);
+    }
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Remove um documento, aguardando enquanto o buffer estiver vazio
+ *
+ * Retorna PRINT_ERR_EMPTY somente quando o buffer está vazio e não há mais produtores
+ * ativos. Como cada produtor só se desregistra após publicar seu último documento,
+ * uma nova tentativa após observar zero produtores encontra todos os documentos restantes.
+ *
+ * @param doc Recebe o documento removido
+ * @param pos Recebe a posição lógica de onde o documento foi removido
+ * @return PRINT_SUCCESS, PRINT_ERR_EMPTY ou PRINT_ERR_STOPPED
+ */
+int print_queue_remove(Document *doc, size_t *pos)
+{
+    int attempt = 0;
+
+    while (!print_queue_try_remove(doc, pos))
+    {
+        if (atomic_load_explicit(&print_queue.should_stop, memory_order_relaxed))
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        if (atomic_load_explicit(&print_queue.active_producers, memory_order_acquire) == 0)
+        {
+            return print_queue_try_remove(doc, pos) ? PRINT_SUCCESS : PRINT_ERR_EMPTY;
+        }
+        backoff(&attempt);
+    }
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Função da Thread Produtora
+ *
+ * Simula uma aplicação enviando documentos para a fila de impressão.
+ *
+ * @param arg Ponteiro para o ID do produtor (int)
+ * @return NULL
+ */
+void *producer(void *arg)
+{
+    int producer_id = *(int *)arg;
+    int docs_produced = 0;
+    size_t pos;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+    print_affinity_pin(PRINT_AFFINITY_PRODUCER, producer_id - 1);
+
+    while (docs_produced < config.max_documents && !atomic_load(&print_queue.should_stop))
+    {
+        // Cria novo documento com propriedades simuladas
+        Document doc = {
+            .id = (producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
+            .producer_id = producer_id};
+        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        if (print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH) != 0)
+        {
+            break; // Fim do trace deste produtor
+        }
+
+        if (print_queue_insert(&doc, &pos) != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        print_affinity_note(PRINT_AFFINITY_PRODUCER, producer_id - 1, 1);
+        print_log("[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                  producer_id, doc.id, doc.type, doc.size, pos & print_queue.mask);
+
+        docs_produced++;
+        if (config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
+    }
+
+    // Remove registro do produtor após publicar o último documento
+    atomic_fetch_sub_explicit(&print_queue.active_producers, 1, memory_order_release);
+
+    print_log("[Produtor %d] Finalizou a produção de documentos\n", producer_id);
+    return NULL;
+}
+
+/**
+ * Função da Thread Consumidora
+ *
+ * Simula uma impressora processando documentos da fila até que não haja
+ * mais produtores ativos e o buffer esteja vazio.
+ *
+ * @param arg Ponteiro para o ID do consumidor (int)
+ * @return NULL
+ */
+void *consumer(void *arg)
+{
+    int consumer_id = *(int *)arg;
+    Document doc;
+    size_t pos;
+    int ret;
+
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, consumer_id - 1);
+    while ((ret = print_queue_remove(&doc, &pos)) == PRINT_SUCCESS)
+    {
+        uint64_t timestamp = print_stats_now();
+        print_latency_record(&latency[consumer_id - 1], timestamp - doc.enqueue_ns);
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, consumer_id - 1, 1);
+        print_log("[Consumidor %d] Imprimindo documento %d (%s, %dKB) da posição %zu\n",
+                  consumer_id, doc.id, doc.type, doc.size, pos & print_queue.mask);
+
+        // Simula tempo de impressão proporcional ao tamanho do documento
+        if (config.simulate_delays)
+        {
+            usleep(doc.size * 10000);
+        }
+        print_service_record(&latency[consumer_id - 1], print_stats_now() - timestamp);
+    }
+
+    if (ret == PRINT_ERR_EMPTY)
+    {
+        print_log("[Consumidor %d] Não há mais documentos para imprimir, encerrando\n", consumer_id);
+    }
+    return NULL;
+}
+
+/**
+ * Função Principal
+ *
+ * Inicializa o sistema, cria threads produtoras e consumidoras,
+ * aguarda conclusão e finaliza.
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
+ * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
+ */
+int main(int argc, char *argv[])
+{
+    pthread_t *producers;
+    pthread_t *consumers;
+    int *producer_ids;
+    int *consumer_ids;
+    PrintStats stats;
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    producers = calloc(config.num_producers, sizeof(pthread_t));
+    consumers = calloc(config.num_consumers, sizeof(pthread_t));
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    consumer_ids = calloc(config.num_consumers, sizeof(int));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !consumers || !producer_ids || !consumer_ids || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de threads\n");
+        return EXIT_FAILURE;
+    }
+
+    // Topologia e nó do buffer, antes de alocá-lo
+    if (print_affinity_init(&config, config.num_producers, config.num_consumers) != 0 ||
+        init_print_queue(config.buffer_size, config.num_producers) != PRINT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: buffer de %zu posições, %d produtores, %d impressoras\n",
+               config.buffer_size, config.num_producers, config.num_consumers);
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+
+    if (print_stats_watch_start("lockfree", latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar relatório de latências\n");
+        return EXIT_FAILURE;
+    }
+    print_stats_begin(&stats);
+
+    // Cria threads produtoras
+    print_trace_start();
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        producer_ids[i] = i + 1;
+        if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread produtora %d: %s\n", i, strerror(errno));
+            atomic_store(&print_queue.should_stop, 1);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Cria threads consumidoras
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        consumer_ids[i] = i + 1;
+        if (pthread_create(&consumers[i], NULL, consumer, &consumer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread consumidora %d: %s\n", i, strerror(errno));
+            atomic_store(&print_queue.should_stop, 1);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Aguarda conclusão das threads
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        pthread_join(consumers[i], NULL);
+    }
+
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report("lockfree", &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, "lockfree", latency, config.num_consumers);
+        print_affinity_report(stdout);
+    }
+    print_affinity_cleanup();
+    cleanup_print_queue();
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(producers);
+    free(consumers);
+    free(producer_ids);
+    free(consumer_ids);
+    if (!config.quiet)
+    {
+        printf("Sistema de fila de impressão finalizado com sucesso\n");
+    }
+
+    return EXIT_SUCCESS;
+}
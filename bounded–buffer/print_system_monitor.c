@@ -13,6 +13,41 @@
  * - Exclusão mútua automática
  * - Variáveis de condição para sincronização
  * - Gerenciamento de buffer circular
+ *
+ * Modo SPSC (produtor único / consumidor único):
+ * Quando há exatamente um produtor e uma impressora, ou quando cada produtor está
+ * vinculado a uma impressora própria (--bind), o monitor troca o
+ * mutex e as variáveis de condição por canais SPSC sem locks (print_spsc.h). Cada
+ * canal usa apenas índices com semântica acquire/release e uma cópia local do índice
+ * do outro lado, de modo que inserir e remover nunca bloqueiam um mutex nem fazem
+ * chamada de sistema.
+ *
+ * Operações em lote:
+ * monitor_insert_batch e monitor_remove_batch movem vários documentos por seção
+ * crítica e emitem um único sinal por lote, reduzindo aquisições do mutex e
+ * chamadas de futex para produtores que enviam documentos em rajadas.
+ *
+ * Espera adaptativa:
+ * Antes de dormir na variável de condição, uma thread que encontra o buffer cheio
+ * (ou vazio) libera o mutex e gira com pausa de CPU por um número limitado de
+ * iterações. O limite se ajusta sozinho a partir da duração das esperas recentes
+ * resolvidas girando, e encolhe quando girar não resolve. Contadores mostram com que
+ * frequência girar evitou dormir.
+ *
+ * Espera limitada:
+ * monitor_insert_until/monitor_remove_until recebem um prazo absoluto e esperam com
+ * pthread_cond_timedwait; monitor_try_insert/monitor_try_remove não esperam. Com
+ * --submit-timeout-ms, produtores descartam o documento quando o buffer (ou o seu
+ * canal SPSC) continua cheio até o prazo.
+ *
+ * Mensagens:
+ * Nenhuma mensagem é formatada ou impressa com o mutex do monitor adquirido. A marca
+ * de tempo e a posição são capturadas na região crítica e a mensagem é registrada
+ * depois, no log assíncrono sem locks (print_log.h).
+ *
+ * Ao final, o programa informa a vazão obtida. Com o argumento --compare, executa o
+ * cenário 1 produtor → 1 impressora sem atrasos simulados (monitor unitário, monitor
+ * em lotes e SPSC) e imprime a vazão de cada um lado a lado.
  */
 
 #include <stdio.h>
@@ -21,76 +56,310 @@
 #include <pthread.h>
 #include <unistd.h>
 #include <stdarg.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <errno.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_deadline.h"
+#include "print_trace.h"
+#include "print_affinity.h"
+#include "print_waitlist.h"
+#include "print_spsc.h"
 
 /**
  * Configurações do sistema
+ *
+ * Capacidade do buffer, número de produtores e consumidores, documentos por produtor,
+ * tamanho do lote e vínculo produtor → impressora (--bind) são definidos em tempo de
+ * execução (veja print_config.h).
  */
-#define BUFFER_SIZE 5      // Tamanho do buffer circular
-#define NUM_PRODUCERS 3    // Número de threads produtoras (aplicações)
-#define NUM_CONSUMERS 2    // Número de threads consumidoras (impressoras)
-#define MAX_DOCUMENTS 10   // Máximo de documentos por produtor
 #define MAX_TYPE_LENGTH 20 // Tamanho máximo do tipo do documento
+#define CACHE_LINE_SIZE 64 // Tamanho da linha de cache
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_BATCH | PRINT_OPT_BIND | PRINT_OPT_COMPARE | PRINT_OPT_SUBMIT_TIMEOUT | PRINT_OPT_TRACE | \
+                         PRINT_OPT_AFFINITY)
+
+/**
+ * Layout em memória do monitor
+ *
+ * Por padrão, campos do produtor, do consumidor e compartilhados ficam em linhas de
+ * cache separadas e cada documento ocupa uma linha própria. Compilando com
+ * -DPRINT_PACKED_LAYOUT, o layout compacto original é mantido para comparação
+ * (veja bench/perf_false_sharing.sh).
+ */
+#ifdef PRINT_PACKED_LAYOUT
+#define LINE_ALIGNED
+#else
+#define LINE_ALIGNED _Alignas(CACHE_LINE_SIZE)
+#endif
+
+/**
+ * Resultados das operações do monitor
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_EMPTY -5   // Buffer vazio e sem produtores ativos
+#define PRINT_ERR_TIMEOUT -8 // Prazo vencido (buffer cheio ou vazio nas operações try_*)
+
+/**
+ * Parâmetros do modo de comparação (--compare)
+ */
+#define COMPARE_DOCUMENTS 200000 // Documentos produzidos em cada execução da comparação
+
+/**
+ * Parâmetros da espera adaptativa do monitor
+ */
+#define ADAPTIVE_SPIN_MIN 16      // Menor limite de iterações
+#define ADAPTIVE_SPIN_MAX 16384   // Maior limite de iterações
+#define ADAPTIVE_SPIN_INITIAL 256 // Limite inicial
 
 /**
  * Estrutura que representa um documento na fila de impressão
  */
 typedef struct
 {
-    int id;                     // Identificador único do documento
+    LINE_ALIGNED int id;        // Identificador único do documento
     char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "Doc1", "Doc2")
     int size;                   // Tamanho do documento em KB
     int producer_id;            // ID do produtor que criou o documento
+    uint64_t enqueue_ns;        // Momento da inserção no buffer (CLOCK_MONOTONIC)
 } Document;
 
+/**
+ * Modo de entrega dos documentos
+ */
+typedef enum
+{
+    CHANNEL_MONITOR, // Buffer compartilhado protegido pelo monitor
+    CHANNEL_SPSC     // Canais SPSC sem locks, um por par produtor → impressora
+} ChannelMode;
+
+/**
+ * Política de espera adaptativa de uma condição do monitor
+ *
+ * O limite é compartilhado pelas threads que esperam a mesma condição; atualizações
+ * concorrentes podem se perder, o que apenas atrasa o ajuste.
+ */
+typedef struct
+{
+    _Alignas(CACHE_LINE_SIZE) atomic_int limit; // Iterações de giro antes de dormir
+    atomic_ulong waits;                         // Esperas iniciadas (condição falsa)
+    atomic_ulong spin_hits;                     // Esperas resolvidas sem dormir
+} SpinPolicy;
+
 /**
  * Monitor da fila de impressão
  *
  * Esta estrutura encapsula:
  * 1. Dados compartilhados (buffer e contadores)
- * 2. Mecanismos de sincronização (mutex e variáveis de condição)
+ * 2. Mecanismos de sincronização (mutex e listas de espera)
  * 3. Estado do sistema
+ *
+ * Os campos são agrupados por quem os escreve, cada grupo em sua própria linha de
+ * cache: parâmetros somente leitura, lado do produtor (in, not_full), lado do
+ * consumidor (out, not_empty) e estado compartilhado (mutex, contagem, estado).
  */
 typedef struct
 {
-    // Dados compartilhados
-    Document buffer[BUFFER_SIZE]; // Buffer circular de documentos
-    int count;                    // Número atual de documentos no buffer
-    int in;                       // Índice para inserção
-    int out;                      // Índice para remoção
-    int active_producers;         // Número de produtores ativos
-
-    // Mecanismos de sincronização
-    pthread_mutex_t mutex;       // Mutex principal do monitor
-    pthread_cond_t not_full;     // Condição: buffer não está cheio
-    pthread_cond_t not_empty;    // Condição: buffer não está vazio
-    pthread_mutex_t print_mutex; // Mutex para impressão thread-safe
-
-    // Estado do sistema
-    int should_stop; // Flag para controle de finalização
+    // Parâmetros (somente leitura após a inicialização)
+    LINE_ALIGNED Document *buffer; // Buffer circular de documentos
+    size_t capacity;               // Capacidade do buffer (potência de dois)
+    size_t mask;                   // capacity - 1, aplicada aos índices
+    ChannelMode mode;              // Monitor ou canais SPSC
+    PrintSpscChannel *channels;    // Canais SPSC, um por impressora (modo CHANNEL_SPSC)
+    int num_channels;              // Número de canais SPSC
+
+    // Lado do produtor
+    LINE_ALIGNED size_t in; // Índice para inserção
+    PrintWaitList not_full; // Produtores esperando espaço
+    SpinPolicy insert_spin; // Espera adaptativa por espaço
+
+    // Lado do consumidor
+    LINE_ALIGNED size_t out; // Índice para remoção
+    PrintWaitList not_empty; // Impressoras esperando documentos, fechada no fim da produção
+    SpinPolicy remove_spin;  // Espera adaptativa por documentos
+
+    // Estado compartilhado: lido sem o mutex pelo giro de monitor_wait e pelos laços
+    // das threads, por isso toda escrita é atômica (count e active_producers só
+    // mudam com o mutex adquirido)
+    LINE_ALIGNED pthread_mutex_t mutex; // Mutex principal do monitor
+    size_t count;                       // Número atual de documentos no buffer
+    int active_producers;               // Número de produtores ativos
+    int should_stop;                    // Flag para controle de finalização
 } PrintQueueMonitor;
 
+/**
+ * Parâmetros de uma execução do sistema
+ */
+typedef struct
+{
+    int docs_per_producer; // Documentos produzidos por cada produtor
+    int batch_size;        // Documentos por lote (1 = operações unitárias)
+    int simulate_delays;   // Simula tempos de produção e impressão
+    int verbose;           // Exibe mensagens de cada documento
+} RunConfig;
+
 // Instância global do monitor
 PrintQueueMonitor print_queue;
 
+// Configuração lida da linha de comando e do ambiente
+PrintConfig config;
+
+// Parâmetros da execução atual
+RunConfig run_config = {
+    .simulate_delays = 1,
+    .verbose = 1};
+
+/**
+ * Contadores de documentos consumidos por impressora
+ */
+int *docs_consumed_by;
+
+// Documentos descartados porque o prazo de submissão venceu (--submit-timeout-ms)
+atomic_ulong docs_shed;
+
+/**
+ * Aloca um buffer de documentos zerado e alinhado à linha de cache, no nó do buffer
+ *
+ * @param capacity Número de documentos
+ * @return Buffer alocado ou NULL em caso de falha
+ */
+Document *alloc_documents(size_t capacity)
+{
+    size_t bytes = capacity * sizeof(Document);
+
+    // aligned_alloc exige tamanho múltiplo do alinhamento
+    bytes = (bytes + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    Document *buffer = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    if (buffer != NULL)
+    {
+        memset(buffer, 0, bytes);
+        print_affinity_bind(buffer, bytes);
+    }
+    return buffer;
+}
+
+/**
+ * Latências inserção → remoção registradas por cada impressora
+ */
+PrintLatencyRecorder *latency;
+
+/**
+ * Escolhe o modo de entrega para uma configuração de threads
+ *
+ * O modo SPSC é escolhido automaticamente com um produtor e uma impressora, ou quando
+ * cada produtor está vinculado a uma impressora própria.
+ *
+ * @param num_producers Número de produtores
+ * @param num_consumers Número de impressoras
+ * @param bind_printers Produtores vinculados a impressoras (--bind)
+ * @return Modo de entrega
+ */
+ChannelMode select_channel_mode(int num_producers, int num_consumers, int bind_printers)
+{
+    if (num_producers == 1 && num_consumers == 1)
+    {
+        return CHANNEL_SPSC;
+    }
+    if (bind_printers && num_producers == num_consumers)
+    {
+        return CHANNEL_SPSC;
+    }
+    return CHANNEL_MONITOR;
+}
+
+/**
+ * Nome legível de um modo de entrega
+ */
+const char *channel_mode_name(ChannelMode mode)
+{
+    return mode == CHANNEL_SPSC ? "SPSC" : "monitor";
+}
+
+/**
+ * Nome da implementação nas estatísticas (print_stats.h)
+ */
+const char *monitor_impl_name(ChannelMode mode)
+{
+    return mode == CHANNEL_SPSC ? "monitor-spsc" : "monitor";
+}
+
 /**
  * Inicializa o monitor e seus mecanismos de sincronização
  *
+ * No modo SPSC, aloca um canal com a capacidade configurada para cada impressora;
+ * no modo monitor, aloca o buffer compartilhado.
+ *
  * @param m Ponteiro para o monitor
+ * @param mode Modo de entrega dos documentos
+ * @param num_producers Número de produtores ativos
+ * @param num_consumers Número de impressoras
+ * @param capacity Capacidade do buffer (potência de dois)
+ * @return 0 em caso de sucesso, -1 se a alocação falhar
  */
-void monitor_init(PrintQueueMonitor *m)
+int monitor_init(PrintQueueMonitor *m, ChannelMode mode, int num_producers, int num_consumers,
+                 size_t capacity)
 {
     // Inicializa contadores
     m->count = 0;
     m->in = 0;
     m->out = 0;
-    m->active_producers = NUM_PRODUCERS;
+    m->capacity = capacity;
+    m->mask = capacity - 1;
+    m->active_producers = num_producers;
     m->should_stop = 0;
+    m->mode = mode;
+    m->buffer = NULL;
+    m->channels = NULL;
+    m->num_channels = 0;
+
+    if (mode == CHANNEL_MONITOR)
+    {
+        m->buffer = alloc_documents(capacity);
+        if (m->buffer == NULL)
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        // Inicializa canais SPSC
+        m->channels = aligned_alloc(CACHE_LINE_SIZE, num_consumers * sizeof(PrintSpscChannel));
+        if (m->channels == NULL)
+        {
+            return -1;
+        }
+        m->num_channels = num_consumers;
+        for (int i = 0; i < num_consumers; i++)
+        {
+            Document *buffer = alloc_documents(capacity);
+            if (buffer == NULL)
+            {
+                return -1;
+            }
+            print_spsc_init(&m->channels[i], buffer, capacity, sizeof(Document));
+        }
+    }
 
     // Inicializa mecanismos de sincronização
+    atomic_init(&m->insert_spin.limit, ADAPTIVE_SPIN_INITIAL);
+    atomic_init(&m->insert_spin.waits, 0);
+    atomic_init(&m->insert_spin.spin_hits, 0);
+    atomic_init(&m->remove_spin.limit, ADAPTIVE_SPIN_INITIAL);
+    atomic_init(&m->remove_spin.waits, 0);
+    atomic_init(&m->remove_spin.spin_hits, 0);
     pthread_mutex_init(&m->mutex, NULL);
-    pthread_mutex_init(&m->print_mutex, NULL);
-    pthread_cond_init(&m->not_full, NULL);
-    pthread_cond_init(&m->not_empty, NULL);
+    print_waitlist_init(&m->not_full);
+    print_waitlist_init(&m->not_empty);
+
+    return 0;
 }
 
 /**
@@ -101,66 +370,283 @@ void monitor_init(PrintQueueMonitor *m)
 void monitor_destroy(PrintQueueMonitor *m)
 {
     pthread_mutex_destroy(&m->mutex);
-    pthread_mutex_destroy(&m->print_mutex);
-    pthread_cond_destroy(&m->not_full);
-    pthread_cond_destroy(&m->not_empty);
+
+    for (int i = 0; i < m->num_channels; i++)
+    {
+        free(m->channels[i].buffer);
+    }
+    free(m->channels);
+    free(m->buffer);
 }
 
 /**
  * Função thread-safe para impressão de mensagens
  *
+ * Registra a mensagem no log assíncrono da thread; não deve ser chamada com o mutex
+ * do monitor adquirido.
+ *
  * @param m Ponteiro para o monitor
+ * @param timestamp Momento do evento (print_log_now)
  * @param format String de formato
  * @param ... Argumentos variáveis
  */
-void monitor_print(PrintQueueMonitor *m, const char *format, ...)
+void monitor_print(PrintQueueMonitor *m, uint64_t timestamp, const char *format, ...)
 {
     va_list args;
-    va_start(args, format);
+    (void)m;
 
-    pthread_mutex_lock(&m->print_mutex);
-    vprintf(format, args);
-    fflush(stdout);
-    pthread_mutex_unlock(&m->print_mutex);
+    if (!run_config.verbose)
+    {
+        return;
+    }
 
+    va_start(args, format);
+    print_logv_at(timestamp, format, args);
     va_end(args);
 }
 
 /**
- * Insere um documento no buffer do monitor
+ * Pausa curta usada dentro de laços de espera ativa
+ */
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Condição de espera do produtor: há espaço no buffer (ou o sistema está parando)
+ *
+ * Pode ser avaliada sem o mutex durante o giro; a leitura atômica evita que o
+ * compilador mantenha os campos em registradores.
+ */
+static int monitor_has_space(PrintQueueMonitor *m)
+{
+    return __atomic_load_n(&m->count, __ATOMIC_ACQUIRE) < m->capacity ||
+           __atomic_load_n(&m->should_stop, __ATOMIC_RELAXED);
+}
+
+/**
+ * Condição de espera da impressora: há documentos, ou não haverá mais nenhum
+ */
+static int monitor_has_documents(PrintQueueMonitor *m)
+{
+    return __atomic_load_n(&m->count, __ATOMIC_ACQUIRE) > 0 ||
+           __atomic_load_n(&m->should_stop, __ATOMIC_RELAXED) ||
+           __atomic_load_n(&m->active_producers, __ATOMIC_RELAXED) == 0;
+}
+
+/**
+ * Aguarda uma condição do monitor girando e, se necessário, dormindo
+ *
+ * Deve ser chamada com o mutex adquirido e retorna com ele adquirido e a condição
+ * verdadeira. Se a condição for falsa, libera o mutex e gira até o limite da
+ * política; depois readquire o mutex e dorme na lista de espera enquanto a condição
+ * continuar falsa.
+ *
+ * Ajuste do limite (iterações):
+ * - Giro bem-sucedido após i iterações: aproxima o limite de 2i, margem para a
+ *   próxima passagem de documento, que tende a durar o mesmo
+ * - Giro sem sucesso: reduz o limite em 1/4, pois a espera foi longa demais
+ *
+ * Com prazo, a espera na lista termina quando ele vence; um prazo já
+ * vencido (operações try_*) não gira nem dorme.
+ *
+ * @param m Ponteiro para o monitor
+ * @param policy Política da condição
+ * @param waiters Lista de espera da condição
+ * @param ready Condição aguardada
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return 0 com a condição verdadeira, ETIMEDOUT se o prazo venceu antes
+ */
+static int monitor_wait(PrintQueueMonitor *m, SpinPolicy *policy, PrintWaitList *waiters,
+                        int (*ready)(PrintQueueMonitor *), const struct timespec *deadline)
+{
+    if (ready(m))
+    {
+        return 0;
+    }
+    if (print_deadline_expired(deadline))
+    {
+        return ETIMEDOUT;
+    }
+
+    atomic_fetch_add_explicit(&policy->waits, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&m->mutex);
+
+    int limit = atomic_load_explicit(&policy->limit, memory_order_relaxed);
+    int spins = 0;
+    while (spins < limit && !ready(m))
+    {
+        cpu_relax();
+        spins++;
+    }
+
+    int next = spins < limit ? limit + (2 * spins - limit) / 8 : limit - limit / 4;
+    if (next < ADAPTIVE_SPIN_MIN)
+    {
+        next = ADAPTIVE_SPIN_MIN;
+    }
+    else if (next > ADAPTIVE_SPIN_MAX)
+    {
+        next = ADAPTIVE_SPIN_MAX;
+    }
+    atomic_store_explicit(&policy->limit, next, memory_order_relaxed);
+
+    pthread_mutex_lock(&m->mutex);
+    int parked = 0;
+    while (!ready(m))
+    {
+        parked = 1;
+        if (print_waitlist_wait(waiters, &m->mutex, deadline) == ETIMEDOUT && !ready(m))
+        {
+            return ETIMEDOUT;
+        }
+    }
+
+    if (!parked)
+    {
+        atomic_fetch_add_explicit(&policy->spin_hits, 1, memory_order_relaxed);
+    }
+    return 0;
+}
+
+/**
+ * Exibe os contadores da espera adaptativa
+ *
+ * @param m Ponteiro para o monitor
+ */
+void monitor_spin_report(PrintQueueMonitor *m)
+{
+    const SpinPolicy *policies[] = {&m->insert_spin, &m->remove_spin};
+    const char *names[] = {"espaço", "documentos"};
+
+    for (int i = 0; i < 2; i++)
+    {
+        unsigned long waits = atomic_load(&policies[i]->waits);
+        unsigned long hits = atomic_load(&policies[i]->spin_hits);
+
+        printf("Espera por %s: %lu esperas, %lu resolvidas girando (%.1f%%), limite de giro %d\n",
+               names[i], waits, hits, waits ? 100.0 * hits / waits : 0.0,
+               atomic_load(&policies[i]->limit));
+    }
+}
+
+/**
+ * Insere um documento no buffer do monitor, esperando por espaço até o prazo
  *
- * Esta função bloqueia se o buffer estiver cheio até que haja espaço disponível.
  * Implementa a semântica do monitor usando mutex e variável de condição.
  *
  * @param m Ponteiro para o monitor
  * @param doc Documento a ser inserido
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_STOPPED ou PRINT_ERR_TIMEOUT se o buffer
+ *         continuou cheio até o prazo
  */
-void monitor_insert(PrintQueueMonitor *m, Document doc)
+int monitor_insert_until(PrintQueueMonitor *m, const Document *doc, const struct timespec *deadline)
 {
     pthread_mutex_lock(&m->mutex);
 
     // Aguarda espaço disponível no buffer
-    while (m->count == BUFFER_SIZE && !m->should_stop)
+    if (monitor_wait(m, &m->insert_spin, &m->not_full, monitor_has_space, deadline) != 0)
     {
-        pthread_cond_wait(&m->not_full, &m->mutex);
+        pthread_mutex_unlock(&m->mutex);
+        return PRINT_ERR_TIMEOUT;
     }
 
-    if (m->should_stop)
+    if (__atomic_load_n(&m->should_stop, __ATOMIC_RELAXED))
     {
         pthread_mutex_unlock(&m->mutex);
-        return;
+        return PRINT_ERR_STOPPED;
     }
 
     // Insere documento e atualiza estado
-    m->buffer[m->in] = doc;
-    monitor_print(m, "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %d\n",
-                  doc.producer_id, doc.id, doc.type, doc.size, m->in);
+    size_t pos = m->in;
+    uint64_t timestamp = print_log_now();
+    m->buffer[pos] = *doc;
+    m->buffer[pos].enqueue_ns = timestamp;
+
+    m->in = (m->in + 1) & m->mask;
+    __atomic_store_n(&m->count, m->count + 1, __ATOMIC_RELEASE);
+
+    print_waitlist_wake(&m->not_empty, 1);
+    pthread_mutex_unlock(&m->mutex);
+
+    monitor_print(m, timestamp, "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                  doc->producer_id, doc->id, doc->type, doc->size, pos);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Insere um documento se houver espaço, sem esperar
+ *
+ * @return PRINT_SUCCESS, PRINT_ERR_STOPPED ou PRINT_ERR_TIMEOUT se o buffer estiver cheio
+ */
+int monitor_try_insert(PrintQueueMonitor *m, const Document *doc)
+{
+    return monitor_insert_until(m, doc, &print_deadline_now);
+}
+
+/**
+ * Insere um documento no buffer do monitor
+ *
+ * Esta função bloqueia se o buffer estiver cheio até que haja espaço disponível.
+ *
+ * @param m Ponteiro para o monitor
+ * @param doc Documento a ser inserido
+ */
+void monitor_insert(PrintQueueMonitor *m, const Document *doc)
+{
+    monitor_insert_until(m, doc, NULL);
+}
+
+/**
+ * Remove um documento do buffer do monitor, esperando até o prazo
+ *
+ * @param m Ponteiro para o monitor
+ * @param doc Ponteiro para armazenar o documento removido
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_EMPTY se não haverá mais documentos, ou
+ *         PRINT_ERR_TIMEOUT se nenhum documento chegou até o prazo
+ */
+int monitor_remove_until(PrintQueueMonitor *m, Document *doc, const struct timespec *deadline)
+{
+    pthread_mutex_lock(&m->mutex);
+
+    // Aguarda documento, desligamento ou fim dos produtores
+    if (monitor_wait(m, &m->remove_spin, &m->not_empty, monitor_has_documents, deadline) != 0)
+    {
+        pthread_mutex_unlock(&m->mutex);
+        return PRINT_ERR_TIMEOUT;
+    }
+
+    if (m->count == 0)
+    {
+        pthread_mutex_unlock(&m->mutex);
+        return PRINT_ERR_EMPTY;
+    }
 
-    m->in = (m->in + 1) % BUFFER_SIZE;
-    m->count++;
+    *doc = m->buffer[m->out];
+    m->out = (m->out + 1) & m->mask;
+    __atomic_store_n(&m->count, m->count - 1, __ATOMIC_RELEASE);
 
-    pthread_cond_signal(&m->not_empty);
+    print_waitlist_wake(&m->not_full, 1);
     pthread_mutex_unlock(&m->mutex);
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Remove um documento se houver algum, sem esperar
+ *
+ * @return PRINT_SUCCESS, PRINT_ERR_EMPTY ou PRINT_ERR_TIMEOUT se o buffer estiver vazio
+ */
+int monitor_try_remove(PrintQueueMonitor *m, Document *doc)
+{
+    return monitor_remove_until(m, doc, &print_deadline_now);
 }
 
 /**
@@ -174,34 +660,215 @@ void monitor_insert(PrintQueueMonitor *m, Document doc)
  */
 int monitor_remove(PrintQueueMonitor *m, Document *doc)
 {
+    return monitor_remove_until(m, doc, NULL) == PRINT_SUCCESS;
+}
+
+/**
+ * Acorda threads após uma operação em lote
+ *
+ * Cada documento (ou posição) movido libera no máximo uma thread, então acorda no
+ * máximo uma thread por documento, em ordem de chegada, em vez de todas.
+ *
+ * @param waiters Lista de espera a sinalizar
+ * @param moved Número de documentos movidos na seção crítica
+ */
+static void monitor_wake(PrintWaitList *waiters, int moved)
+{
+    print_waitlist_wake(waiters, moved);
+}
+
+/**
+ * Insere vários documentos no buffer do monitor
+ *
+ * Move quantos documentos couberem a cada aquisição do mutex e emite um único sinal
+ * por lote. Se o buffer encher antes do fim do lote, aguarda espaço e continua.
+ *
+ * @param m Ponteiro para o monitor
+ * @param docs Documentos a serem inseridos
+ * @param n Número de documentos (até PRINT_MAX_BATCH_SIZE)
+ * @return Número de documentos inseridos (menor que n apenas em desligamento)
+ */
+int monitor_insert_batch(PrintQueueMonitor *m, const Document *docs, int n)
+{
+    size_t positions[PRINT_MAX_BATCH_SIZE];
+    uint64_t timestamps[PRINT_MAX_BATCH_SIZE];
+    int inserted = 0;
+
     pthread_mutex_lock(&m->mutex);
 
-    while (m->count == 0 && !m->should_stop)
+    while (inserted < n)
     {
-        if (m->active_producers == 0)
+        // Aguarda espaço disponível no buffer
+        monitor_wait(m, &m->insert_spin, &m->not_full, monitor_has_space, NULL);
+
+        if (__atomic_load_n(&m->should_stop, __ATOMIC_RELAXED))
         {
-            pthread_mutex_unlock(&m->mutex);
-            return 0;
+            break;
         }
-        pthread_cond_wait(&m->not_empty, &m->mutex);
+
+        int moved = 0;
+        uint64_t timestamp = print_log_now();
+        while (inserted < n && m->count < m->capacity)
+        {
+            positions[inserted] = m->in;
+            timestamps[inserted] = timestamp;
+            m->buffer[m->in] = docs[inserted];
+            m->buffer[m->in].enqueue_ns = timestamp;
+
+            m->in = (m->in + 1) & m->mask;
+            __atomic_store_n(&m->count, m->count + 1, __ATOMIC_RELEASE);
+            inserted++;
+            moved++;
+        }
+
+        monitor_wake(&m->not_empty, moved);
     }
 
-    if (m->should_stop && m->count == 0)
+    pthread_mutex_unlock(&m->mutex);
+
+    for (int i = 0; i < inserted; i++)
     {
-        pthread_mutex_unlock(&m->mutex);
-        return 0;
+        const Document *doc = &docs[i];
+        monitor_print(m, timestamps[i], "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                      doc->producer_id, doc->id, doc->type, doc->size, positions[i]);
     }
+    return inserted;
+}
 
-    *doc = m->buffer[m->out];
-    m->out = (m->out + 1) % BUFFER_SIZE;
-    m->count--;
+/**
+ * Remove até max documentos do buffer do monitor
+ *
+ * Bloqueia enquanto o buffer estiver vazio e houver produtores ativos. Remove todos os
+ * documentos disponíveis (até max) em uma única seção crítica e acorda os produtores
+ * uma única vez.
+ *
+ * @param m Ponteiro para o monitor
+ * @param out Vetor que recebe os documentos removidos
+ * @param max Capacidade do vetor
+ * @return Número de documentos removidos, 0 se não há mais documentos
+ */
+int monitor_remove_batch(PrintQueueMonitor *m, Document *out, int max)
+{
+    int removed = 0;
+
+    pthread_mutex_lock(&m->mutex);
 
-    pthread_cond_signal(&m->not_full);
+    // Aguarda documento, desligamento ou fim dos produtores
+    monitor_wait(m, &m->remove_spin, &m->not_empty, monitor_has_documents, NULL);
+
+    while (removed < max && m->count > 0)
+    {
+        out[removed++] = m->buffer[m->out];
+        m->out = (m->out + 1) & m->mask;
+        __atomic_store_n(&m->count, m->count - 1, __ATOMIC_RELEASE);
+    }
+
+    monitor_wake(&m->not_full, removed);
     pthread_mutex_unlock(&m->mutex);
 
+    return removed;
+}
+
+/**
+ * Tenta inserir um documento no canal SPSC sem bloquear
+ *
+ * Deve ser chamada apenas pelo produtor dono do canal.
+ *
+ * @param c Canal SPSC
+ * @param doc Documento a ser inserido
+ * @param pos Recebe a posição ocupada pelo documento
+ * @return 1 se o documento foi inserido, 0 se o canal estava cheio
+ */
+int spsc_try_insert(PrintSpscChannel *c, const Document *doc, size_t *pos)
+{
+    Document *slot = print_spsc_claim(c, pos);
+
+    if (slot == NULL)
+    {
+        return 0;
+    }
+    *slot = *doc;
+    slot->enqueue_ns = print_log_now();
+    print_spsc_publish(c);
     return 1;
 }
 
+/**
+ * Insere um documento no canal SPSC, aguardando enquanto estiver cheio até o prazo
+ *
+ * O prazo é verificado entre as tentativas; a espera pode excedê-lo em até um
+ * intervalo de backoff.
+ *
+ * @param m Ponteiro para o monitor
+ * @param c Canal SPSC
+ * @param doc Documento a ser inserido
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_STOPPED ou PRINT_ERR_TIMEOUT se o canal
+ *         continuou cheio até o prazo
+ */
+int spsc_insert_until(PrintQueueMonitor *m, PrintSpscChannel *c, const Document *doc, const struct timespec *deadline)
+{
+    int attempt = 0;
+    size_t pos;
+
+    while (!spsc_try_insert(c, doc, &pos))
+    {
+        if (__atomic_load_n(&m->should_stop, __ATOMIC_RELAXED))
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        if (print_deadline_expired(deadline))
+        {
+            return PRINT_ERR_TIMEOUT;
+        }
+        print_spsc_backoff(&attempt);
+    }
+
+    monitor_print(m, print_log_now(), "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                  doc->producer_id, doc->id, doc->type, doc->size, pos);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Remove um documento do canal SPSC, aguardando enquanto estiver vazio
+ *
+ * @param m Ponteiro para o monitor
+ * @param c Canal SPSC
+ * @param doc Recebe o documento removido
+ * @return 1 se um documento foi removido, 0 se o canal foi fechado e está vazio
+ */
+int spsc_remove(PrintQueueMonitor *m, PrintSpscChannel *c, Document *doc)
+{
+    int attempt = 0;
+
+    while (!print_spsc_try_remove(c, doc, NULL))
+    {
+        if (__atomic_load_n(&m->should_stop, __ATOMIC_RELAXED))
+        {
+            return 0;
+        }
+        if (print_spsc_closed(c))
+        {
+            // O produtor fecha o canal após publicar o último documento
+            return print_spsc_try_remove(c, doc, NULL);
+        }
+        print_spsc_backoff(&attempt);
+    }
+
+    return 1;
+}
+
+/**
+ * Canal SPSC associado a um produtor (ou impressora), ou NULL no modo monitor
+ *
+ * @param m Ponteiro para o monitor
+ * @param index Índice do produtor ou da impressora (base zero)
+ */
+PrintSpscChannel *monitor_channel(PrintQueueMonitor *m, int index)
+{
+    return m->mode == CHANNEL_SPSC ? &m->channels[index] : NULL;
+}
+
 /**
  * Thread produtora - simula uma aplicação gerando documentos
  *
@@ -212,27 +879,86 @@ void *producer(void *arg)
 {
     int producer_id = *(int *)arg;
     int docs_produced = 0;
+    PrintSpscChannel *channel = monitor_channel(&print_queue, producer_id - 1);
+    Document batch[PRINT_MAX_BATCH_SIZE];
+    struct timespec deadline;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+    int trace_done = 0;
 
-    while (docs_produced < MAX_DOCUMENTS && !print_queue.should_stop)
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+    print_affinity_pin(PRINT_AFFINITY_PRODUCER, producer_id - 1);
+    while (docs_produced < run_config.docs_per_producer && !trace_done &&
+           !__atomic_load_n(&print_queue.should_stop, __ATOMIC_RELAXED))
     {
-        Document doc = {
-            .id = (producer_id * MAX_DOCUMENTS) + docs_produced,
-            .size = rand() % 100 + 1,
-            .producer_id = producer_id};
-        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        // Cria uma rajada de documentos
+        int n = 0;
+        while (n < run_config.batch_size && docs_produced + n < run_config.docs_per_producer)
+        {
+            Document *doc = &batch[n];
+            doc->id = (producer_id * run_config.docs_per_producer) + docs_produced + n;
+            doc->size = (int)workload_sample(&config.job_sizes, &rng);
+            doc->producer_id = producer_id;
+            snprintf(doc->type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+            if (print_trace_document(&trace, producer_id, &doc->size, doc->type, MAX_TYPE_LENGTH) != 0)
+            {
+                trace_done = 1; // Fim do trace deste produtor
+                break;
+            }
+            n++;
+        }
+        if (n == 0)
+        {
+            break;
+        }
 
-        monitor_insert(&print_queue, doc);
+        if (channel || n == 1 || config.submit_timeout >= 0)
+        {
+            // Com prazo de submissão, cada documento da rajada tem o seu próprio prazo
+            for (int i = 0; i < n; i++)
+            {
+                const struct timespec *until = print_deadline_for(config.submit_timeout, &deadline);
+                int ret = channel ? spsc_insert_until(&print_queue, channel, &batch[i], until)
+                                  : monitor_insert_until(&print_queue, &batch[i], until);
+                if (ret == PRINT_ERR_TIMEOUT)
+                {
+                    // Buffer saturado: descarta o documento em vez de bloquear o produtor
+                    atomic_fetch_add_explicit(&docs_shed, 1, memory_order_relaxed);
+                    monitor_print(&print_queue, print_log_now(), "[Produtor %d] Buffer cheio, documento %d descartado\n",
+                                  producer_id, batch[i].id);
+                }
+            }
+        }
+        else
+        {
+            n = monitor_insert_batch(&print_queue, batch, n);
+        }
 
-        docs_produced++;
-        usleep(rand() % 500000); // Simula tempo de produção
+        docs_produced += n;
+        print_affinity_note(PRINT_AFFINITY_PRODUCER, producer_id - 1, n);
+        if (run_config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo de produção
+        }
     }
 
-    pthread_mutex_lock(&print_queue.mutex);
-    print_queue.active_producers--;
-    pthread_cond_broadcast(&print_queue.not_empty);
-    pthread_mutex_unlock(&print_queue.mutex);
+    if (channel)
+    {
+        // Fecha o canal após publicar o último documento
+        print_spsc_close(channel);
+    }
+    else
+    {
+        // O último produtor fecha a lista das impressoras, que acordam em cascata
+        pthread_mutex_lock(&print_queue.mutex);
+        if (__atomic_sub_fetch(&print_queue.active_producers, 1, __ATOMIC_RELEASE) == 0)
+        {
+            print_waitlist_close(&print_queue.not_empty);
+        }
+        pthread_mutex_unlock(&print_queue.mutex);
+    }
 
-    monitor_print(&print_queue, "[Produtor %d] Finalizou após produzir %d documentos\n",
+    monitor_print(&print_queue, print_log_now(), "[Produtor %d] Finalizou após produzir %d documentos\n",
                   producer_id, docs_produced);
     return NULL;
 }
@@ -247,81 +973,283 @@ void *consumer(void *arg)
 {
     int consumer_id = *(int *)arg;
     int docs_consumed = 0;
-    Document doc;
+    Document batch[PRINT_MAX_BATCH_SIZE];
+    PrintSpscChannel *channel = monitor_channel(&print_queue, consumer_id - 1);
 
-    while (!print_queue.should_stop || print_queue.count > 0)
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, consumer_id - 1);
+    while (!__atomic_load_n(&print_queue.should_stop, __ATOMIC_RELAXED) ||
+           __atomic_load_n(&print_queue.count, __ATOMIC_ACQUIRE) > 0)
     {
-        if (monitor_remove(&print_queue, &doc))
+        int removed;
+
+        if (channel)
+        {
+            removed = spsc_remove(&print_queue, channel, &batch[0]);
+        }
+        else if (run_config.batch_size == 1)
+        {
+            removed = monitor_remove(&print_queue, &batch[0]);
+        }
+        else
+        {
+            removed = monitor_remove_batch(&print_queue, batch, run_config.batch_size);
+        }
+
+        uint64_t now = print_log_now();
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, consumer_id - 1, removed);
+        for (int i = 0; i < removed; i++)
         {
-            monitor_print(&print_queue,
+            Document *doc = &batch[i];
+            uint64_t started = print_log_now();
+
+            print_latency_record(&latency[consumer_id - 1], now - doc->enqueue_ns);
+            monitor_print(&print_queue, now,
                           "[Consumidor %d] Imprimindo documento %d (%s, %dKB)\n",
-                          consumer_id, doc.id, doc.type, doc.size);
+                          consumer_id, doc->id, doc->type, doc->size);
 
             docs_consumed++;
-            usleep(doc.size * 10000); // Simula tempo de impressão
+            if (run_config.simulate_delays)
+            {
+                usleep(doc->size * 10000); // Simula tempo de impressão
+            }
+            print_service_record(&latency[consumer_id - 1], print_log_now() - started);
         }
-        else if (print_queue.active_producers == 0)
+
+        if (removed)
+        {
+            continue;
+        }
+        if (channel || __atomic_load_n(&print_queue.active_producers, __ATOMIC_RELAXED) == 0)
         {
             break;
         }
     }
 
-    monitor_print(&print_queue, "[Consumidor %d] Finalizou após consumir %d documentos\n",
+    docs_consumed_by[consumer_id - 1] = docs_consumed;
+    monitor_print(&print_queue, print_log_now(), "[Consumidor %d] Finalizou após consumir %d documentos\n",
                   consumer_id, docs_consumed);
     return NULL;
 }
 
 /**
- * Função principal
- * Inicializa o sistema, cria threads e gerencia o ciclo de vida
+ * Executa o sistema de impressão uma vez
+ *
+ * Inicializa o monitor, cria as threads, aguarda sua conclusão e mede a vazão. As
+ * latências de cada impressora ficam em latency até que o chamador as libere.
+ *
+ * @param mode Modo de entrega dos documentos
+ * @param num_producers Número de produtores
+ * @param num_consumers Número de impressoras
+ * @param stats Recebe as medições globais da execução
+ * @param throughput Recebe a vazão em documentos por segundo
+ * @return 0 em caso de sucesso, 1 em caso de erro
  */
-int main()
+int run_print_system(ChannelMode mode, int num_producers, int num_consumers, PrintStats *stats,
+                     double *throughput)
 {
-    pthread_t producers[NUM_PRODUCERS];
-    pthread_t consumers[NUM_CONSUMERS];
-    int producer_ids[NUM_PRODUCERS];
-    int consumer_ids[NUM_CONSUMERS];
+    pthread_t *producers = calloc(num_producers, sizeof(pthread_t));
+    pthread_t *consumers = calloc(num_consumers, sizeof(pthread_t));
+    int *producer_ids = calloc(num_producers, sizeof(int));
+    int *consumer_ids = calloc(num_consumers, sizeof(int));
+    long total_consumed = 0;
     int i;
 
-    monitor_init(&print_queue);
+    docs_consumed_by = calloc(num_consumers, sizeof(int));
+    latency = calloc(num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !consumers || !producer_ids || !consumer_ids || !docs_consumed_by || !latency ||
+        monitor_init(&print_queue, mode, num_producers, num_consumers, config.buffer_size) != 0)
+    {
+        fprintf(stderr, "Erro ao alocar memória\n");
+        return 1;
+    }
+    if (!config.compare && print_stats_watch_start(monitor_impl_name(mode), latency, num_consumers) != 0)
+    {
+        fprintf(stderr, "Erro ao iniciar relatório de latências\n");
+        return 1;
+    }
+    print_stats_begin(stats);
 
     // Cria threads produtoras
-    for (i = 0; i < NUM_PRODUCERS; i++)
+    print_trace_start();
+    for (i = 0; i < num_producers; i++)
     {
         producer_ids[i] = i + 1;
         if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
         {
             fprintf(stderr, "Erro ao criar produtor %d\n", i + 1);
-            print_queue.should_stop = 1;
+            __atomic_store_n(&print_queue.should_stop, 1, __ATOMIC_RELAXED);
             return 1;
         }
     }
 
     // Cria threads consumidoras
-    for (i = 0; i < NUM_CONSUMERS; i++)
+    for (i = 0; i < num_consumers; i++)
     {
         consumer_ids[i] = i + 1;
         if (pthread_create(&consumers[i], NULL, consumer, &consumer_ids[i]) != 0)
         {
             fprintf(stderr, "Erro ao criar consumidor %d\n", i + 1);
-            print_queue.should_stop = 1;
+            __atomic_store_n(&print_queue.should_stop, 1, __ATOMIC_RELAXED);
             return 1;
         }
     }
 
     // Aguarda conclusão das threads
-    for (i = 0; i < NUM_PRODUCERS; i++)
+    for (i = 0; i < num_producers; i++)
     {
         pthread_join(producers[i], NULL);
     }
 
-    for (i = 0; i < NUM_CONSUMERS; i++)
+    for (i = 0; i < num_consumers; i++)
     {
         pthread_join(consumers[i], NULL);
+        total_consumed += docs_consumed_by[i];
     }
 
+    print_stats_end(stats);
+    if (!config.compare)
+    {
+        print_stats_watch_stop();
+    }
+    if (mode == CHANNEL_MONITOR && !config.quiet)
+    {
+        monitor_spin_report(&print_queue);
+    }
+    if (!config.quiet && !config.compare)
+    {
+        print_affinity_report(stdout); // Antes de liberar o buffer, cujas páginas são consultadas
+    }
     monitor_destroy(&print_queue);
+    free(producers);
+    free(consumers);
+    free(producer_ids);
+    free(consumer_ids);
+    free(docs_consumed_by);
 
-    printf("Sistema finalizado com sucesso\n");
+    double elapsed = (stats->end_ns - stats->start_ns) / 1e9;
+    *throughput = elapsed > 0 ? total_consumed / elapsed : 0;
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * Compara a vazão dos modos monitor (unitário e em lotes) e SPSC
+ *
+ * Executa o cenário 1 produtor → 1 impressora sem atrasos simulados e sem mensagens
+ * por documento, uma vez em cada modo.
+ *
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int compare_channel_modes(void)
+{
+    ChannelMode modes[] = {CHANNEL_MONITOR, CHANNEL_MONITOR, CHANNEL_SPSC};
+    int batch_sizes[] = {1, config.batch_size, 1};
+    PrintStats stats;
+    double throughput;
+
+    run_config.docs_per_producer = COMPARE_DOCUMENTS;
+    run_config.simulate_delays = 0;
+    run_config.verbose = 0;
+
+    printf("Comparação 1 produtor → 1 impressora (%d documentos)\n", COMPARE_DOCUMENTS);
+    for (int i = 0; i < 3; i++)
+    {
+        run_config.batch_size = batch_sizes[i];
+        if (run_print_system(modes[i], 1, 1, &stats, &throughput) != 0)
+        {
+            return 1;
+        }
+        print_latency_free(latency, 1);
+        free(latency);
+        printf("Vazão (modo %s, lote %d): %.0f documentos/s\n",
+               channel_mode_name(modes[i]), batch_sizes[i], throughput);
+    }
+
+    return 0;
+}
+
+/**
+ * Função principal
+ * Inicializa o sistema, cria threads e gerencia o ciclo de vida
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
+ */
+int main(int argc, char *argv[])
+{
+    ChannelMode mode;
+    PrintStats stats;
+    double throughput;
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? 0 : 1;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return 1;
+    }
+    run_config.docs_per_producer = config.max_documents;
+    run_config.batch_size = config.batch_size;
+    run_config.simulate_delays = config.simulate_delays;
+    run_config.verbose = !config.quiet;
+
+    if (config.compare)
+    {
+        return compare_channel_modes();
+    }
+
+    // Topologia e nó do buffer, antes de alocá-lo (a comparação não fixa threads)
+    if (print_affinity_init(&config, config.num_producers, config.num_consumers) != 0)
+    {
+        return 1;
+    }
+
+    mode = select_channel_mode(config.num_producers, config.num_consumers, config.bind_printers);
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: buffer de %zu posições, %d produtores, %d impressoras (modo %s)\n",
+               config.buffer_size, config.num_producers, config.num_consumers, channel_mode_name(mode));
+    }
+
+    // Inicia a thread escritora do log
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Erro ao criar thread de log\n");
+        return 1;
+    }
+
+    ret = run_print_system(mode, config.num_producers, config.num_consumers, &stats, &throughput);
+    print_log_stop();
+    print_trace_finish(&config);
+    if (ret != 0)
+    {
+        return 1;
+    }
+
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report(monitor_impl_name(mode), &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, monitor_impl_name(mode), latency, config.num_consumers);
+    }
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    print_affinity_cleanup();
+
+    if (!config.quiet)
+    {
+        printf("Vazão (modo %s): %.1f documentos/s\n", channel_mode_name(mode), throughput);
+        if (config.submit_timeout >= 0)
+        {
+            printf("Documentos descartados por prazo de submissão: %lu\n", atomic_load(&docs_shed));
+        }
+        printf("Sistema finalizado com sucesso\n");
+    }
+    return 0;
+}
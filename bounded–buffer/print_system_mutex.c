@@ -17,6 +17,42 @@
  * - Mutex para proteção de recursos compartilhados
  * - Variáveis de condição para sinalização entre threads
  * - Coordenação entre Produtores e Consumidores
+ *
+ * Conteúdo dos Documentos:
+ * - O conteúdo de cada documento é escrito em um bloco de um pool pré-alocado
+ *   (print_slab.h); o buffer transporta apenas o identificador do bloco, que a
+ *   impressora lê e devolve ao pool, sem cópia do conteúdo nem uso de malloc
+ *
+ * Saída em Spool (--spool DIR):
+ * - Em vez de simular a impressão com usleep, cada impressora grava o conteúdo dos
+ *   documentos no seu arquivo de spool por um anel io_uring (print_spool.h), com o
+ *   pool de blocos registrado como buffer fixo e várias gravações em andamento; o
+ *   bloco volta ao pool e a impressão é registrada no diário na conclusão da gravação
+ *
+ * Pool Elástico (--elastic MIN,MAX):
+ * - Uma thread supervisora observa periodicamente a ocupação do buffer e a espera
+ *   média dos documentos na fila, e inicia ou encerra impressoras entre MIN e MAX
+ * - Histerese: o pool cresce depois de algumas amostras seguidas com o buffer quase
+ *   cheio ou a espera acima de --elastic-target-ms, e só encolhe depois de uma janela
+ *   bem mais longa com o buffer quase vazio; quem encerra é uma impressora que
+ *   encontra o buffer vazio, nunca uma que esteja imprimindo
+ *
+ * Espera Limitada:
+ * - queue_insert_until/queue_remove_until aceitam um prazo (print_deadline.h) e
+ *   queue_try_insert/queue_try_remove não esperam; com --submit-timeout-ms os
+ *   produtores descartam o documento em vez de esperar indefinidamente
+ *
+ * Diário Durável (--journal ARQUIVO):
+ * - Cada submissão é gravada no diário (print_journal.h) antes de entrar na fila, e
+ *   cada impressão concluída depois de impressa; gravações de várias threads são
+ *   agrupadas em um único fdatasync
+ * - Na inicialização, os trabalhos do diário ainda não impressos são reenviados à
+ *   fila por uma thread de reexecução antes dos novos documentos
+ *
+ * Mensagens:
+ * - Nenhuma mensagem é impressa com o mutex adquirido: a marca de tempo e a posição
+ *   são capturadas na região crítica e a mensagem é registrada depois, no log
+ *   assíncrono (print_log.h)
  */
 
 #include <stdio.h>
@@ -25,18 +61,49 @@
 #include <pthread.h>
 #include <unistd.h>
 #include <errno.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_slab.h"
+#include "print_journal.h"
+#include "print_deadline.h"
+#include "print_spool.h"
+#include "print_trace.h"
+#include "print_affinity.h"
+#include "print_waitlist.h"
 
 /**
  * Constantes de Configuração do Sistema
  *
- * Estas constantes definem os parâmetros operacionais do sistema de fila de impressão.
- * Modifique estes valores para ajustar o comportamento do sistema.
+ * Capacidade do buffer, número de produtores e consumidores e documentos por produtor
+ * são definidos em tempo de execução (veja print_config.h).
  */
-#define BUFFER_SIZE 5      // Tamanho do buffer circular
-#define NUM_PRODUCERS 3    // Número de threads produtoras (aplicações)
-#define NUM_CONSUMERS 2    // Número de threads consumidoras (impressoras)
-#define MAX_DOCUMENTS 10   // Máximo de documentos por produtor
 #define MAX_TYPE_LENGTH 20 // Tamanho máximo para o tipo do documento
+#define CACHE_LINE_SIZE 64 // Tamanho da linha de cache
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_PAYLOAD | PRINT_OPT_JOURNAL | PRINT_OPT_SUBMIT_TIMEOUT | PRINT_OPT_SPOOL | \
+                         PRINT_OPT_TRACE | PRINT_OPT_ELASTIC | PRINT_OPT_AFFINITY)
+
+/**
+ * Layout em memória da fila
+ *
+ * Por padrão, campos do produtor, do consumidor e compartilhados ficam em linhas de
+ * cache separadas e cada documento ocupa uma linha própria, para que a escrita de um
+ * lado não invalide a linha lida pelo outro (falso compartilhamento). Compilando com
+ * -DPRINT_PACKED_LAYOUT, o layout compacto original é mantido para comparação
+ * (veja bench/perf_false_sharing.sh).
+ */
+#ifdef PRINT_PACKED_LAYOUT
+#define LINE_ALIGNED
+#else
+#define LINE_ALIGNED _Alignas(CACHE_LINE_SIZE)
+#endif
 
 /**
  * Códigos de Erro do Sistema
@@ -44,10 +111,16 @@
  * Estes códigos são retornados por várias funções do sistema para indicar
  * sucesso ou condições específicas de falha.
  */
-#define PRINT_SUCCESS 0     // Operação concluída com sucesso
-#define PRINT_ERR_MUTEX -1  // Falha na inicialização/operação do mutex
-#define PRINT_ERR_THREAD -2 // Falha na criação/operação da thread
-#define PRINT_ERR_COND -3   // Falha na inicialização/operação da variável de condição
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_MUTEX -1   // Falha na inicialização/operação do mutex
+#define PRINT_ERR_THREAD -2  // Falha na criação/operação da thread
+#define PRINT_ERR_COND -3    // Falha na inicialização/operação da variável de condição
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_EMPTY -5   // Buffer vazio e sem produtores ativos
+#define PRINT_ERR_NOMEM -6   // Falha na alocação do buffer
+#define PRINT_ERR_JOURNAL -7 // Falha na gravação do diário
+#define PRINT_ERR_TIMEOUT -8 // Prazo vencido (buffer cheio ou vazio nas operações try_*)
+#define PRINT_ERR_RETIRED -9 // Impressora dispensada pelo pool elástico
 
 /**
  * Estrutura do Documento
@@ -57,36 +130,55 @@
  */
 typedef struct
 {
-    int id;                     // Identificador único do documento
+    LINE_ALIGNED int id;        // Identificador único do documento
     char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "PDF", "DOC")
     int size;                   // Tamanho do documento em KB
     int producer_id;            // ID da aplicação produtora
+    uint64_t enqueue_ns;        // Momento da inserção no buffer (CLOCK_MONOTONIC)
+    PrintSlabHandle payload;    // Bloco do pool com o conteúdo do documento
+    uint64_t job;               // Número do trabalho no diário (0 = sem diário)
 } Document;
 
+/**
+ * Cabeçalho gravado no início do bloco de conteúdo de cada documento
+ */
+typedef struct
+{
+    int doc_id;    // Documento dono do bloco (conferido pela impressora)
+    size_t length; // Bytes de conteúdo após o cabeçalho
+} PayloadHeader;
+
 /**
  * Estrutura da Fila de Impressão
  *
- * Estrutura de dados principal que gerencia o sistema de fila de impressão. Contém:
- * 1. O buffer circular e seus índices de gerenciamento
- * 2. Primitivas de sincronização
- * 3. Informações de estado do sistema
+ * Estrutura de dados principal que gerencia o sistema de fila de impressão. Os campos
+ * são agrupados por quem os escreve, cada grupo em sua própria linha de cache:
+ * 1. Buffer circular e parâmetros (somente leitura após a inicialização)
+ * 2. Lado do produtor: índice de inserção e condição em que produtores esperam
+ * 3. Lado do consumidor: índice de remoção e condição em que consumidores esperam
+ * 4. Estado compartilhado: mutex, contagem e estado do sistema
  */
 typedef struct
 {
     // Gerenciamento do Buffer
-    Document buffer[BUFFER_SIZE]; // Buffer circular que armazena documentos
-    int in;                       // Índice para próxima inserção (produtor)
-    int out;                      // Índice para próxima remoção (consumidor)
-    int count;                    // Número atual de documentos no buffer
-
-    // Primitivas de Sincronização
-    pthread_mutex_t mutex;    // Protege acesso aos recursos compartilhados
-    pthread_cond_t not_full;  // Sinaliza quando o buffer não está cheio
-    pthread_cond_t not_empty; // Sinaliza quando o buffer não está vazio
-
-    // Estado do Sistema
-    int active_producers; // Número de threads produtoras ativas
-    int should_stop;      // Flag para desligamento do sistema
+    LINE_ALIGNED Document *buffer; // Buffer circular que armazena documentos
+    size_t capacity;               // Capacidade do buffer (potência de dois)
+    size_t mask;                   // capacity - 1, aplicada aos índices
+
+    // Lado do Produtor
+    LINE_ALIGNED size_t in;  // Índice para próxima inserção (produtor)
+    pthread_cond_t not_full; // Sinaliza quando o buffer não está cheio
+
+    // Lado do Consumidor
+    LINE_ALIGNED size_t out;  // Índice para próxima remoção (consumidor)
+    PrintWaitList not_empty;  // Impressoras esperando documentos, fechada no fim da produção
+
+    // Estado Compartilhado
+    LINE_ALIGNED pthread_mutex_t mutex; // Protege acesso aos recursos compartilhados
+    size_t count;                       // Número atual de documentos no buffer
+    int active_producers;               // Número de threads produtoras ativas
+    int should_stop;                    // Flag para desligamento do sistema
+    int retire_printers;                // Impressoras ociosas a encerrar (pool elástico)
 } PrintQueue;
 
 // Instância global da fila de impressão
@@ -95,22 +187,366 @@ PrintQueue print_queue = {
     .out = 0,
     .count = 0,
     .active_producers = 0,
-    .should_stop = 0};
+    .should_stop = 0,
+    .retire_printers = 0};
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências inserção → remoção registradas por cada consumidor
+PrintLatencyRecorder *latency;
+
+// Documentos descartados porque o prazo de submissão venceu (--submit-timeout-ms)
+atomic_ulong docs_shed;
+
+// Trabalhos do diário ainda não impressos na execução anterior
+PrintJournalRecord *recovered_jobs;
+size_t num_recovered_jobs;
+
+/**
+ * Saída de uma impressora em spool (--spool)
+ */
+typedef struct
+{
+    PrintSpool spool;                  // Arquivo de spool e anel io_uring
+    Document docs[PRINT_SPOOL_DEPTH];  // Documentos com gravação em andamento, por slot
+    uint64_t started[PRINT_SPOOL_DEPTH]; // Início da impressão de cada documento
+    int printer;                       // Índice da impressora
+} PrinterOutput;
+
+// Saídas das impressoras (NULL = impressão simulada)
+PrinterOutput *outputs;
+
+/**
+ * Pool elástico de impressoras (--elastic)
+ *
+ * Cada impressora ocupa uma posição entre 0 e MAX - 1 dos vetores por impressora
+ * (latências, spool); uma posição livre é reutilizada pela próxima impressora iniciada.
+ */
+#define PRINTER_SLOT_FREE 0    // Sem thread
+#define PRINTER_SLOT_RUNNING 1 // Thread em execução
+#define PRINTER_SLOT_EXITED 2  // Thread encerrada, aguardando pthread_join
+
+typedef struct
+{
+    int enabled;            // Pool elástico ativo
+    pthread_t supervisor;   // Thread supervisora
+    atomic_int stop;        // Pede o encerramento da supervisora
+    atomic_int *slots;      // Estado de cada posição (PRINTER_SLOT_*)
+    pthread_t *threads;     // Threads das impressoras, por posição
+    int *ids;               // IDs das impressoras, por posição
+    int running;            // Impressoras ativas e não dispensadas (supervisora)
+    int peak;               // Maior número de impressoras ativas
+    unsigned long started;  // Impressoras iniciadas pela supervisora
+    unsigned long retired;  // Impressoras dispensadas pela supervisora
+    atomic_ulong wait_ns;   // Espera na fila somada desde a última amostra
+    atomic_ulong removed;   // Documentos removidos desde a última amostra
+} ElasticPool;
+
+ElasticPool elastic;
+
+/**
+ * Aloca um buffer de documentos zerado e alinhado à linha de cache, no nó do buffer
+ *
+ * @param capacity Número de documentos
+ * @return Buffer alocado ou NULL em caso de falha
+ */
+Document *alloc_documents(size_t capacity)
+{
+    size_t bytes = capacity * sizeof(Document);
+
+    // aligned_alloc exige tamanho múltiplo do alinhamento
+    bytes = (bytes + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    Document *buffer = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    if (buffer != NULL)
+    {
+        memset(buffer, 0, bytes);
+        print_affinity_bind(buffer, bytes);
+    }
+    return buffer;
+}
+
+/**
+ * Gera o conteúdo de um documento em um bloco do pool
+ *
+ * Simula a aplicação renderizando o trabalho: grava o cabeçalho e preenche até
+ * doc->size KB (limitado ao tamanho do bloco). Se o pool estiver momentaneamente
+ * esgotado, cede a CPU até que uma impressora devolva um bloco.
+ *
+ * @param doc Documento (recebe o identificador do bloco)
+ * @return PRINT_SUCCESS, ou PRINT_ERR_STOPPED em desligamento
+ */
+int render_document(Document *doc)
+{
+    while ((doc->payload = print_slab_alloc()) == PRINT_SLAB_NONE)
+    {
+        if (print_queue.should_stop)
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        sched_yield();
+    }
+
+    PayloadHeader *header = print_slab_ptr(doc->payload);
+    size_t length = (size_t)doc->size * 1024;
+    if (length > print_slab.block_size - sizeof(PayloadHeader))
+    {
+        length = print_slab.block_size - sizeof(PayloadHeader);
+    }
+    header->doc_id = doc->id;
+    header->length = length;
+    memset(header + 1, doc->id & 0xff, length);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Lê o conteúdo de um documento e devolve o bloco ao pool
+ *
+ * @param consumer_id ID da impressora
+ * @param doc Documento impresso
+ */
+void release_document(int consumer_id, const Document *doc)
+{
+    const PayloadHeader *header = print_slab_ptr(doc->payload);
+
+    if (header->doc_id != doc->id)
+    {
+        print_log("[Consumidor %d] Conteúdo do documento %d não confere (bloco %u)\n",
+                  consumer_id, doc->id, doc->payload);
+    }
+    print_slab_free(doc->payload);
+}
+
+/**
+ * Registra a submissão de um documento no diário e espera a gravação
+ *
+ * O documento só é aceito na fila depois que a submissão é durável.
+ *
+ * @param doc Documento (recebe o número do trabalho)
+ * @return PRINT_SUCCESS, ou PRINT_ERR_JOURNAL se o diário falhou
+ */
+int journal_submit(Document *doc)
+{
+    if (config.journal == NULL)
+    {
+        return PRINT_SUCCESS;
+    }
+
+    PrintJournalRecord rec = {
+        .kind = PRINT_JOURNAL_SUBMIT,
+        .job = print_journal_next_job(),
+        .doc_id = doc->id,
+        .size = doc->size,
+        .producer_id = doc->producer_id};
+    memcpy(rec.type, doc->type, sizeof(rec.type));
+
+    uint64_t lsn = print_journal_append(&rec);
+    if (lsn == 0 || print_journal_wait(lsn) != 0)
+    {
+        return PRINT_ERR_JOURNAL;
+    }
+    doc->job = rec.job;
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Registra no diário a conclusão da impressão de um documento
+ *
+ * Não espera a gravação: se o registro se perder, o documento é apenas reimpresso
+ * na próxima execução.
+ *
+ * @param doc Documento impresso
+ */
+void journal_complete(const Document *doc)
+{
+    if (doc->job == 0)
+    {
+        return;
+    }
+
+    PrintJournalRecord rec = {
+        .kind = PRINT_JOURNAL_DONE,
+        .job = doc->job,
+        .doc_id = doc->id,
+        .size = doc->size,
+        .producer_id = doc->producer_id};
+    memcpy(rec.type, doc->type, sizeof(rec.type));
+    print_journal_append(&rec);
+}
+
+/**
+ * Conclusão da gravação de um documento no spool
+ *
+ * Registra o tempo de serviço, devolve o bloco ao pool e, se o documento foi gravado
+ * por inteiro, registra a impressão no diário: só agora o conteúdo saiu da memória.
+ * Uma gravação que falhou não é registrada, e o documento é reimpresso na
+ * recuperação do diário.
+ *
+ * @param ctx Saída da impressora
+ * @param slot Slot da gravação
+ * @param result Tamanho da gravação, ou -errno
+ */
+void output_done(void *ctx, int slot, int result)
+{
+    PrinterOutput *out = ctx;
+    Document *doc = &out->docs[slot];
+    const PayloadHeader *header = print_slab_ptr(doc->payload);
+    int written = result == (int)(sizeof(PayloadHeader) + header->length);
+
+    if (!written)
+    {
+        print_log("[Consumidor %d] Falha ao gravar documento %d no spool: %s\n", out->printer + 1, doc->id,
+                  strerror(result < 0 ? -result : EIO));
+    }
+    print_service_record(&latency[out->printer], print_log_now() - out->started[slot]);
+    release_document(out->printer + 1, doc);
+    if (written)
+    {
+        journal_complete(doc);
+    }
+}
+
+/**
+ * Imprime um documento retirado da fila
+ *
+ * Com --spool, envia o conteúdo ao spool da impressora e retorna sem esperar a
+ * gravação (concluída em output_done). Sem spool, simula o tempo de impressão.
+ *
+ * @param printer Índice da impressora
+ * @param doc Documento
+ * @param started Momento da retirada da fila
+ */
+void print_document(int printer, const Document *doc, uint64_t started)
+{
+    if (outputs != NULL)
+    {
+        PrinterOutput *out = &outputs[printer];
+        int slot = print_spool_slot(&out->spool, output_done, out);
+        const PayloadHeader *header = print_slab_ptr(doc->payload);
+
+        out->docs[slot] = *doc;
+        out->started[slot] = started;
+        print_spool_write(&out->spool, slot, header, sizeof(PayloadHeader) + header->length, output_done, out);
+        return;
+    }
+
+    release_document(printer + 1, doc);
+
+    // Simula tempo de impressão proporcional ao tamanho do documento
+    if (config.simulate_delays)
+    {
+        usleep(doc->size * 10000);
+    }
+    print_service_record(&latency[printer], print_log_now() - started);
+    journal_complete(doc);
+}
+
+/**
+ * Envia as gravações acumuladas de uma impressora antes de ela esperar por documentos
+ *
+ * @param printer Índice da impressora
+ */
+void printer_idle(int printer)
+{
+    if (outputs != NULL)
+    {
+        print_spool_flush(&outputs[printer].spool, output_done, &outputs[printer]);
+    }
+}
+
+/**
+ * Espera todas as gravações de uma impressora
+ *
+ * @param printer Índice da impressora
+ */
+void printer_finish(int printer)
+{
+    if (outputs != NULL)
+    {
+        print_spool_drain(&outputs[printer].spool, output_done, &outputs[printer]);
+    }
+}
+
+/**
+ * Abre os arquivos de spool das impressoras
+ *
+ * Deve ser chamada depois de print_slab_init: a área do pool é registrada no anel.
+ *
+ * @param dir Diretório dos arquivos
+ * @param num_printers Número de impressoras
+ * @return PRINT_SUCCESS, PRINT_ERR_NOMEM ou PRINT_ERR_STOPPED se um arquivo não puder ser criado
+ */
+int open_outputs(const char *dir, int num_printers)
+{
+    outputs = calloc(num_printers, sizeof(PrinterOutput));
+    if (outputs == NULL)
+    {
+        return PRINT_ERR_NOMEM;
+    }
+
+    for (int i = 0; i < num_printers; i++)
+    {
+        char path[4096];
+
+        snprintf(path, sizeof(path), "%s/impressora-%d.spool", dir, i + 1);
+        outputs[i].printer = i;
+        if (print_spool_open(&outputs[i].spool, path, print_slab.arena,
+                             (size_t)print_slab.num_blocks * print_slab.block_size) != 0)
+        {
+            return PRINT_ERR_STOPPED;
+        }
+    }
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Fecha os arquivos de spool e exibe as gravações de cada impressora
+ *
+ * @param num_printers Número de impressoras
+ */
+void close_outputs(int num_printers)
+{
+    for (int i = 0; i < num_printers; i++)
+    {
+        PrintSpool *sp = &outputs[i].spool;
+
+        if (!config.quiet)
+        {
+            printf("Spool da impressora %d: %lu gravações, %lu chamadas io_uring_enter (%s)\n",
+                   i + 1, sp->writes, sp->enters, print_spool_mode(sp));
+        }
+        print_spool_close(sp);
+    }
+    free(outputs);
+    outputs = NULL;
+}
 
 /**
  * Inicializa o sistema de fila de impressão
  *
- * Configura as primitivas de sincronização e inicializa o estado do sistema.
- * Deve ser chamada antes de qualquer outra operação na fila de impressão.
+ * Aloca o buffer circular, configura as primitivas de sincronização e inicializa o
+ * estado do sistema. Deve ser chamada antes de qualquer outra operação na fila de impressão.
  *
+ * @param capacity Capacidade do buffer (potência de dois)
  * @return PRINT_SUCCESS em caso de sucesso, código de erro em caso de falha
  */
-int init_print_queue(void)
+int init_print_queue(size_t capacity)
 {
+    // Aloca o buffer circular
+    print_queue.buffer = alloc_documents(capacity);
+    if (print_queue.buffer == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar buffer de %zu posições: %s\n", capacity, strerror(errno));
+        return PRINT_ERR_NOMEM;
+    }
+    print_queue.capacity = capacity;
+    print_queue.mask = capacity - 1;
+
     // Inicializa o mutex principal
     if (pthread_mutex_init(&print_queue.mutex, NULL) != 0)
     {
         fprintf(stderr, "Falha ao inicializar mutex: %s\n", strerror(errno));
+        free(print_queue.buffer);
         return PRINT_ERR_MUTEX;
     }
 
@@ -118,18 +554,13 @@ int init_print_queue(void)
     if (pthread_cond_init(&print_queue.not_full, NULL) != 0)
     {
         pthread_mutex_destroy(&print_queue.mutex);
+        free(print_queue.buffer);
         fprintf(stderr, "Falha ao inicializar condição not_full: %s\n", strerror(errno));
         return PRINT_ERR_COND;
     }
 
-    // Inicializa variável de condição para not_empty
-    if (pthread_cond_init(&print_queue.not_empty, NULL) != 0)
-    {
-        pthread_mutex_destroy(&print_queue.mutex);
-        pthread_cond_destroy(&print_queue.not_full);
-        fprintf(stderr, "Falha ao inicializar condição not_empty: %s\n", strerror(errno));
-        return PRINT_ERR_COND;
-    }
+    // Impressoras esperam em uma lista própria, para serem acordadas uma a uma
+    print_waitlist_init(&print_queue.not_empty);
 
     return PRINT_SUCCESS;
 }
@@ -144,7 +575,155 @@ void cleanup_print_queue(void)
 {
     pthread_mutex_destroy(&print_queue.mutex);
     pthread_cond_destroy(&print_queue.not_full);
-    pthread_cond_destroy(&print_queue.not_empty);
+    free(print_queue.buffer);
+    print_queue.buffer = NULL;
+}
+
+/**
+ * Espera uma variável de condição da fila até o prazo
+ *
+ * @param cond Variável de condição (com print_queue.mutex adquirido)
+ * @param deadline Prazo absoluto, ou NULL para esperar indefinidamente
+ * @return 0 se acordou, ETIMEDOUT se o prazo venceu
+ */
+int queue_wait(pthread_cond_t *cond, const struct timespec *deadline)
+{
+    if (deadline == NULL)
+    {
+        pthread_cond_wait(cond, &print_queue.mutex);
+        return 0;
+    }
+    return pthread_cond_timedwait(cond, &print_queue.mutex, deadline);
+}
+
+/**
+ * Insere um documento no buffer compartilhado, esperando por espaço até o prazo
+ *
+ * Sinaliza aos consumidores que um novo documento está disponível.
+ *
+ * @param doc Documento (recebe a marca de tempo de inserção)
+ * @param pos Recebe a posição ocupada
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_TIMEOUT se o buffer continuou cheio até o prazo,
+ *         ou PRINT_ERR_STOPPED em desligamento
+ */
+int queue_insert_until(Document *doc, size_t *pos, const struct timespec *deadline)
+{
+    pthread_mutex_lock(&print_queue.mutex);
+
+    // Aguarda enquanto o buffer estiver cheio
+    while (print_queue.count == print_queue.capacity && !print_queue.should_stop)
+    {
+        if (queue_wait(&print_queue.not_full, deadline) == ETIMEDOUT &&
+            print_queue.count == print_queue.capacity)
+        {
+            pthread_mutex_unlock(&print_queue.mutex);
+            return PRINT_ERR_TIMEOUT;
+        }
+    }
+
+    if (print_queue.should_stop)
+    {
+        pthread_mutex_unlock(&print_queue.mutex);
+        return PRINT_ERR_STOPPED;
+    }
+
+    // Adiciona documento ao buffer
+    *pos = print_queue.in;
+    doc->enqueue_ns = print_log_now();
+    print_queue.buffer[*pos] = *doc;
+
+    // Atualiza estado do buffer
+    print_queue.in = (print_queue.in + 1) & print_queue.mask;
+    print_queue.count++;
+
+    print_waitlist_wake(&print_queue.not_empty, 1);
+    pthread_mutex_unlock(&print_queue.mutex);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Insere um documento se houver espaço, sem esperar
+ *
+ * @return PRINT_SUCCESS, PRINT_ERR_TIMEOUT se o buffer estiver cheio, ou PRINT_ERR_STOPPED
+ */
+int queue_try_insert(Document *doc, size_t *pos)
+{
+    return queue_insert_until(doc, pos, &print_deadline_now);
+}
+
+/**
+ * Insere um documento, esperando por espaço indefinidamente
+ *
+ * @return PRINT_SUCCESS, ou PRINT_ERR_STOPPED em desligamento
+ */
+int queue_insert(Document *doc, size_t *pos)
+{
+    return queue_insert_until(doc, pos, NULL);
+}
+
+/**
+ * Remove um documento do buffer compartilhado, esperando até o prazo
+ *
+ * Sinaliza aos produtores que há espaço disponível.
+ *
+ * @param doc Recebe o documento
+ * @param pos Recebe a posição liberada
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_EMPTY se não há documentos nem produtores ativos,
+ *         PRINT_ERR_TIMEOUT se o buffer continuou vazio até o prazo, PRINT_ERR_RETIRED se
+ *         o pool elástico dispensou a impressora, ou PRINT_ERR_STOPPED
+ */
+int queue_remove_until(Document *doc, size_t *pos, const struct timespec *deadline)
+{
+    pthread_mutex_lock(&print_queue.mutex);
+
+    // Aguarda por documentos disponíveis
+    while (print_queue.count == 0)
+    {
+        if (print_queue.active_producers == 0 || print_queue.should_stop)
+        {
+            int ret = print_queue.should_stop ? PRINT_ERR_STOPPED : PRINT_ERR_EMPTY;
+            pthread_mutex_unlock(&print_queue.mutex);
+            return ret;
+        }
+        // Buffer vazio: esta impressora atende um pedido de encolhimento do pool
+        if (print_queue.retire_printers > 0)
+        {
+            print_queue.retire_printers--;
+            pthread_mutex_unlock(&print_queue.mutex);
+            return PRINT_ERR_RETIRED;
+        }
+        if (print_waitlist_wait(&print_queue.not_empty, &print_queue.mutex, deadline) == ETIMEDOUT &&
+            print_queue.count == 0)
+        {
+            pthread_mutex_unlock(&print_queue.mutex);
+            return PRINT_ERR_TIMEOUT;
+        }
+    }
+
+    // Remove documento
+    *pos = print_queue.out;
+    *doc = print_queue.buffer[*pos];
+
+    // Atualiza estado do buffer
+    print_queue.out = (print_queue.out + 1) & print_queue.mask;
+    print_queue.count--;
+
+    pthread_cond_signal(&print_queue.not_full);
+    pthread_mutex_unlock(&print_queue.mutex);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Remove um documento se houver algum, sem esperar
+ *
+ * @return PRINT_SUCCESS, PRINT_ERR_TIMEOUT se o buffer estiver vazio, PRINT_ERR_EMPTY ou
+ *         PRINT_ERR_STOPPED
+ */
+int queue_try_remove(Document *doc, size_t *pos)
+{
+    return queue_remove_until(doc, pos, &print_deadline_now);
 }
 
 /**
@@ -155,8 +734,8 @@ void cleanup_print_queue(void)
  *
  * Fluxo do Produtor:
  * 1. Cria um novo documento com ID único e tamanho aleatório
- * 2. Aguarda se o buffer estiver cheio
- * 3. Adiciona o documento ao buffer quando houver espaço
+ * 2. Aguarda se o buffer estiver cheio (até o prazo de --submit-timeout-ms, se houver)
+ * 3. Adiciona o documento ao buffer quando houver espaço, ou o descarta se o prazo vencer
  * 4. Sinaliza aos consumidores que um novo documento está disponível
  *
  * @param arg Ponteiro para o ID do produtor (int)
@@ -166,62 +745,78 @@ void *producer(void *arg)
 {
     int producer_id = *(int *)arg;
     int docs_produced = 0;
+    struct timespec deadline;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
 
-    // Registra como produtor ativo
-    pthread_mutex_lock(&print_queue.mutex);
-    print_queue.active_producers++;
-    pthread_mutex_unlock(&print_queue.mutex);
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+    print_affinity_pin(PRINT_AFFINITY_PRODUCER, producer_id - 1);
 
     // Loop principal de produção
-    while (docs_produced < MAX_DOCUMENTS && !print_queue.should_stop)
+    while (docs_produced < config.max_documents && !print_queue.should_stop)
     {
         // Cria novo documento com propriedades simuladas
         Document doc = {
-            .id = (producer_id * MAX_DOCUMENTS) + docs_produced,
-            .size = rand() % 100 + 1,
+            .id = (producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
             .producer_id = producer_id};
         snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
-
-        pthread_mutex_lock(&print_queue.mutex);
-
-        // Aguarda enquanto o buffer estiver cheio
-        while (print_queue.count == BUFFER_SIZE && !print_queue.should_stop)
+        if (print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH) != 0)
         {
-            pthread_cond_wait(&print_queue.not_full, &print_queue.mutex);
+            break; // Fim do trace deste produtor
         }
-
-        if (print_queue.should_stop)
+        if (render_document(&doc) != PRINT_SUCCESS)
         {
-            pthread_mutex_unlock(&print_queue.mutex);
             break;
         }
 
-        // Adiciona documento ao buffer
-        print_queue.buffer[print_queue.in] = doc;
-        printf("[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %d\n",
-               producer_id, doc.id, doc.type, doc.size, print_queue.in);
-
-        // Atualiza estado do buffer
-        print_queue.in = (print_queue.in + 1) % BUFFER_SIZE;
-        print_queue.count++;
-
-        pthread_cond_signal(&print_queue.not_empty);
-        pthread_mutex_unlock(&print_queue.mutex);
+        // Submissão durável antes de o documento ser aceito na fila
+        size_t pos;
+        if (journal_submit(&doc) != PRINT_SUCCESS)
+        {
+            print_slab_free(doc.payload);
+            break;
+        }
+        int ret = queue_insert_until(&doc, &pos, print_deadline_for(config.submit_timeout, &deadline));
+        if (ret == PRINT_ERR_TIMEOUT)
+        {
+            // Fila saturada: descarta o documento em vez de bloquear o produtor
+            print_slab_free(doc.payload);
+            journal_complete(&doc);
+            atomic_fetch_add_explicit(&docs_shed, 1, memory_order_relaxed);
+            print_log("[Produtor %d] Fila cheia, documento %d descartado\n", producer_id, doc.id);
+        }
+        else if (ret != PRINT_SUCCESS)
+        {
+            print_slab_free(doc.payload);
+            break;
+        }
+        else
+        {
+            print_affinity_note(PRINT_AFFINITY_PRODUCER, producer_id - 1, 1);
+            print_log_at(doc.enqueue_ns, "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                         producer_id, doc.id, doc.type, doc.size, pos);
+        }
 
         docs_produced++;
-        usleep(rand() % 500000); // Simula tempo variável de criação de documento
+        if (config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
     }
 
-    // Remove registro do produtor e sinaliza conclusão
+    // Remove registro do produtor; o último fecha a lista de espera das impressoras,
+    // que acordam em cascata
     pthread_mutex_lock(&print_queue.mutex);
     print_queue.active_producers--;
     if (print_queue.active_producers == 0)
     {
-        pthread_cond_broadcast(&print_queue.not_empty);
+        print_waitlist_close(&print_queue.not_empty);
     }
     pthread_mutex_unlock(&print_queue.mutex);
 
-    printf("[Produtor %d] Finalizou a produção de documentos\n", producer_id);
+    print_slab_thread_flush();
+    print_log("[Produtor %d] Finalizou a produção de documentos\n", producer_id);
     return NULL;
 }
 
@@ -244,39 +839,272 @@ void *producer(void *arg)
 void *consumer(void *arg)
 {
     int consumer_id = *(int *)arg;
+    Document doc;
+    size_t pos;
+    int ret;
+
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, consumer_id - 1);
+    for (;;)
+    {
+        // Buffer vazio: envia as gravações pendentes antes de esperar
+        if ((ret = queue_try_remove(&doc, &pos)) == PRINT_ERR_TIMEOUT)
+        {
+            printer_idle(consumer_id - 1);
+            ret = queue_remove_until(&doc, &pos, NULL);
+        }
+        if (ret != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        uint64_t timestamp = print_log_now();
+
+        print_latency_record(&latency[consumer_id - 1], timestamp - doc.enqueue_ns);
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, consumer_id - 1, 1);
+        if (elastic.enabled)
+        {
+            atomic_fetch_add_explicit(&elastic.wait_ns, timestamp - doc.enqueue_ns, memory_order_relaxed);
+            atomic_fetch_add_explicit(&elastic.removed, 1, memory_order_relaxed);
+        }
+        print_log_at(timestamp, "[Consumidor %d] Imprimindo documento %d (%s, %dKB) da posição %zu\n",
+                     consumer_id, doc.id, doc.type, doc.size, pos);
+        print_document(consumer_id - 1, &doc, timestamp);
+    }
 
-    while (!print_queue.should_stop)
+    printer_finish(consumer_id - 1);
+    print_slab_thread_flush();
+    if (ret == PRINT_ERR_EMPTY)
+    {
+        print_log("[Consumidor %d] Não há mais documentos para imprimir, encerrando\n", consumer_id);
+    }
+    else if (ret == PRINT_ERR_RETIRED)
     {
+        print_log("[Consumidor %d] Dispensada pelo pool elástico, encerrando\n", consumer_id);
+    }
+    if (elastic.enabled)
+    {
+        atomic_store(&elastic.slots[consumer_id - 1], PRINTER_SLOT_EXITED);
+    }
+    return NULL;
+}
+
+/**
+ * Supervisão do Pool Elástico
+ *
+ * A cada ELASTIC_TICK_US a supervisora amostra a ocupação do buffer e a espera na
+ * fila: a maior entre a espera média dos documentos removidos desde a amostra
+ * anterior e a idade do documento mais antigo ainda no buffer (que cresce mesmo
+ * quando todas as impressoras estão ocupadas e nada é removido).
+ *
+ * - Sobrecarga (ocupação >= ELASTIC_HIGH_OCCUPANCY ou espera >= --elastic-target-ms)
+ *   por ELASTIC_UP_TICKS amostras seguidas: cancela os encolhimentos pendentes e
+ *   inicia uma impressora, se houver menos que MAX
+ * - Ociosidade (ocupação <= ELASTIC_LOW_OCCUPANCY e espera abaixo de um quarto do
+ *   alvo) por ELASTIC_DOWN_TICKS amostras seguidas: pede que uma impressora ociosa
+ *   encerre, se houver mais que MIN
+ *
+ * A janela de encolhimento é bem mais longa que a de crescimento, de modo que uma
+ * pausa curta entre rajadas não desfaz o pool que a rajada seguinte vai precisar.
+ */
+#define ELASTIC_TICK_US 20000       // Intervalo entre amostras da supervisora
+#define ELASTIC_HIGH_OCCUPANCY 0.75 // Ocupação considerada sobrecarga
+#define ELASTIC_LOW_OCCUPANCY 0.10  // Ocupação considerada ociosidade
+#define ELASTIC_UP_TICKS 2          // Amostras seguidas de sobrecarga para crescer
+#define ELASTIC_DOWN_TICKS 25       // Amostras seguidas de ociosidade para encolher
+
+/**
+ * Inicia uma impressora na primeira posição livre do pool
+ *
+ * @return ID da impressora iniciada, ou -1 se não houver posição livre ou a thread
+ *         não puder ser criada
+ */
+int elastic_start_printer(void)
+{
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        if (atomic_load(&elastic.slots[i]) != PRINTER_SLOT_FREE)
+        {
+            continue;
+        }
+
+        elastic.ids[i] = i + 1;
+        atomic_store(&elastic.slots[i], PRINTER_SLOT_RUNNING);
+        if (pthread_create(&elastic.threads[i], NULL, consumer, &elastic.ids[i]) != 0)
+        {
+            atomic_store(&elastic.slots[i], PRINTER_SLOT_FREE);
+            fprintf(stderr, "Falha ao criar thread consumidora %d: %s\n", i, strerror(errno));
+            return -1;
+        }
+        elastic.running++;
+        elastic.peak = elastic.running > elastic.peak ? elastic.running : elastic.peak;
+        return i + 1;
+    }
+    return -1;
+}
+
+/**
+ * Aguarda as impressoras encerradas e libera as suas posições
+ */
+void elastic_reap(void)
+{
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        if (atomic_load(&elastic.slots[i]) == PRINTER_SLOT_EXITED)
+        {
+            pthread_join(elastic.threads[i], NULL);
+            atomic_store(&elastic.slots[i], PRINTER_SLOT_FREE);
+        }
+    }
+}
+
+/**
+ * Função da Thread Supervisora do Pool Elástico
+ *
+ * Ajusta o número de impressoras até o fim da produção; a partir daí as impressoras
+ * ativas drenam o buffer e encerram.
+ *
+ * @param arg Não utilizado
+ * @return NULL
+ */
+void *elastic_supervisor(void *arg)
+{
+    uint64_t target_ns = (uint64_t)config.elastic_target_ms * 1000000ULL;
+    int high_ticks = 0;
+    int low_ticks = 0;
+
+    (void)arg;
+    while (!atomic_load(&elastic.stop))
+    {
+        usleep(ELASTIC_TICK_US);
+        elastic_reap();
+
+        // Amostra do buffer: ocupação e idade do documento mais antigo
         pthread_mutex_lock(&print_queue.mutex);
+        size_t count = print_queue.count;
+        int producing = print_queue.active_producers > 0;
+        uint64_t oldest = count > 0 ? print_queue.buffer[print_queue.out].enqueue_ns : 0;
+        pthread_mutex_unlock(&print_queue.mutex);
+        if (!producing)
+        {
+            break;
+        }
 
-        // Aguarda por documentos disponíveis
-        while (print_queue.count == 0)
+        uint64_t now = print_log_now();
+        unsigned long removed = atomic_exchange_explicit(&elastic.removed, 0, memory_order_relaxed);
+        uint64_t wait_ns = atomic_exchange_explicit(&elastic.wait_ns, 0, memory_order_relaxed);
+        uint64_t delay = removed > 0 ? wait_ns / removed : 0;
+        if (oldest != 0 && now > oldest && now - oldest > delay)
         {
-            if (print_queue.active_producers == 0)
+            delay = now - oldest;
+        }
+        double occupancy = (double)count / print_queue.capacity;
+
+        if (occupancy >= ELASTIC_HIGH_OCCUPANCY || delay >= target_ns)
+        {
+            low_ticks = 0;
+            if (++high_ticks < ELASTIC_UP_TICKS)
+            {
+                continue;
+            }
+            high_ticks = 0;
+
+            // Encolhimentos ainda não atendidos deixam de valer
+            pthread_mutex_lock(&print_queue.mutex);
+            int cancelled = print_queue.retire_printers;
+            print_queue.retire_printers = 0;
+            pthread_mutex_unlock(&print_queue.mutex);
+            elastic.running += cancelled;
+            elastic.retired -= cancelled;
+
+            int id;
+            if (elastic.running < config.elastic_max && (id = elastic_start_printer()) > 0)
             {
+                elastic.started++;
+                print_log("[Supervisor] Ocupação %.0f%%, espera %.1f ms: iniciou a impressora %d (%d ativas)\n",
+                          occupancy * 100, delay / 1e6, id, elastic.running);
+            }
+        }
+        else if (occupancy <= ELASTIC_LOW_OCCUPANCY && delay < target_ns / 4)
+        {
+            high_ticks = 0;
+            if (++low_ticks < ELASTIC_DOWN_TICKS)
+            {
+                continue;
+            }
+            low_ticks = 0;
+
+            if (elastic.running > config.elastic_min)
+            {
+                pthread_mutex_lock(&print_queue.mutex);
+                print_queue.retire_printers++;
+                print_waitlist_wake(&print_queue.not_empty, 1);
                 pthread_mutex_unlock(&print_queue.mutex);
-                printf("[Consumidor %d] Não há mais documentos para imprimir, encerrando\n", consumer_id);
-                return NULL;
+                elastic.running--;
+                elastic.retired++;
+                print_log("[Supervisor] Ocupação %.0f%%, espera %.1f ms: dispensando uma impressora (%d ativas)\n",
+                          occupancy * 100, delay / 1e6, elastic.running);
             }
-            pthread_cond_wait(&print_queue.not_empty, &print_queue.mutex);
         }
+        else
+        {
+            high_ticks = 0;
+            low_ticks = 0;
+        }
+    }
+    return NULL;
+}
 
-        // Processa documento
-        Document doc = print_queue.buffer[print_queue.out];
-        printf("[Consumidor %d] Imprimindo documento %d (%s, %dKB) da posição %d\n",
-               consumer_id, doc.id, doc.type, doc.size, print_queue.out);
+/**
+ * Função da Thread de Reexecução do Diário
+ *
+ * Reenvia à fila os trabalhos que a execução anterior aceitou e não imprimiu. Os
+ * trabalhos já estão no diário, então não são registrados de novo; conta como um
+ * produtor adicional para que as impressoras não encerrem antes do fim do reenvio.
+ *
+ * @param arg Não utilizado
+ * @return NULL
+ */
+void *replay_producer(void *arg)
+{
+    size_t replayed = 0;
 
-        // Atualiza estado do buffer
-        print_queue.out = (print_queue.out + 1) % BUFFER_SIZE;
-        print_queue.count--;
+    (void)arg;
+    for (; replayed < num_recovered_jobs && !print_queue.should_stop; replayed++)
+    {
+        const PrintJournalRecord *rec = &recovered_jobs[replayed];
+        Document doc = {
+            .id = rec->doc_id,
+            .size = rec->size,
+            .producer_id = rec->producer_id,
+            .job = rec->job};
+        memcpy(doc.type, rec->type, MAX_TYPE_LENGTH);
+        doc.type[MAX_TYPE_LENGTH - 1] = '\0';
+        if (render_document(&doc) != PRINT_SUCCESS)
+        {
+            break;
+        }
 
-        pthread_cond_signal(&print_queue.not_full);
-        pthread_mutex_unlock(&print_queue.mutex);
+        size_t pos;
+        if (queue_insert(&doc, &pos) != PRINT_SUCCESS)
+        {
+            print_slab_free(doc.payload);
+            break;
+        }
+
+        print_log_at(doc.enqueue_ns, "[Diário] Reenviou o trabalho %llu: documento %d (%s, %dKB) na posição %zu\n",
+                     (unsigned long long)doc.job, doc.id, doc.type, doc.size, pos);
+    }
 
-        // Simula tempo de impressão proporcional ao tamanho do documento
-        usleep(doc.size * 10000);
+    // Remove o registro do produtor de reexecução
+    pthread_mutex_lock(&print_queue.mutex);
+    if (--print_queue.active_producers == 0)
+    {
+        print_waitlist_close(&print_queue.not_empty);
     }
+    pthread_mutex_unlock(&print_queue.mutex);
 
+    print_slab_thread_flush();
+    print_log("[Diário] %zu trabalhos pendentes reenviados\n", replayed);
     return NULL;
 }
 
@@ -292,25 +1120,154 @@ void *consumer(void *arg)
  * 3. Aguarda conclusão de todas as threads
  * 4. Limpa recursos
  *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
  * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
  */
-int main()
+int main(int argc, char *argv[])
 {
-    pthread_t producers[NUM_PRODUCERS];
-    pthread_t consumers[NUM_CONSUMERS];
-    int producer_ids[NUM_PRODUCERS];
-    int consumer_ids[NUM_CONSUMERS];
+    pthread_t *producers;
+    pthread_t *consumers;
+    int *producer_ids;
+    int *consumer_ids;
+    pthread_t replayer;
+    PrintStats stats;
+    int replayers = 0;
     int ret;
 
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Pool elástico: os vetores por impressora são dimensionados pelo máximo
+    if (config.elastic_max > 0)
+    {
+        config.num_consumers = config.elastic_max;
+        elastic.enabled = 1;
+    }
+
+    producers = calloc(config.num_producers, sizeof(pthread_t));
+    consumers = calloc(config.num_consumers, sizeof(pthread_t));
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    consumer_ids = calloc(config.num_consumers, sizeof(int));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !consumers || !producer_ids || !consumer_ids || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de threads\n");
+        return EXIT_FAILURE;
+    }
+    if (elastic.enabled)
+    {
+        elastic.slots = calloc(config.num_consumers, sizeof(atomic_int));
+        if (elastic.slots == NULL)
+        {
+            fprintf(stderr, "Falha ao alocar vetores de threads\n");
+            return EXIT_FAILURE;
+        }
+        elastic.threads = consumers;
+        elastic.ids = consumer_ids;
+    }
+
+    // Recupera os trabalhos pendentes do diário; havendo algum, uma thread de
+    // reexecução os reenvia como um produtor adicional
+    if (config.journal != NULL)
+    {
+        if (print_journal_replay(config.journal, &recovered_jobs, &num_recovered_jobs) != 0)
+        {
+            fprintf(stderr, "Falha ao ler o diário %s: %s\n", config.journal, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        if (print_journal_open(config.journal, config.journal_us, config.num_producers,
+                               recovered_jobs, num_recovered_jobs) != 0)
+        {
+            return EXIT_FAILURE;
+        }
+        replayers = num_recovered_jobs > 0;
+    }
+
+    // Topologia e nó do buffer, antes de alocá-lo
+    if (print_affinity_init(&config, config.num_producers, config.num_consumers) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
     // Inicializa sistema
-    if ((ret = init_print_queue()) != PRINT_SUCCESS)
+    if ((ret = init_print_queue(config.buffer_size)) != PRINT_SUCCESS)
     {
         fprintf(stderr, "Falha ao inicializar fila de impressão: %d\n", ret);
         return EXIT_FAILURE;
     }
 
+    // Pool de conteúdo: um bloco por documento que cabe no buffer, mais as listas
+    // locais de cada thread
+    size_t queued = config.buffer_size;
+    if (config.spool != NULL)
+    {
+        queued += (size_t)config.num_consumers * PRINT_SPOOL_DEPTH; // Blocos com gravação em andamento
+    }
+    if (print_slab_init(print_slab_blocks_for(queued, config.num_producers + replayers + config.num_consumers),
+                        sizeof(PayloadHeader) + config.payload_size) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    if (config.spool != NULL && open_outputs(config.spool, config.num_consumers) != PRINT_SUCCESS)
+    {
+        fprintf(stderr, "Falha ao abrir os arquivos de spool em %s\n", config.spool);
+        return EXIT_FAILURE;
+    }
+
+    int num_consumer_threads = elastic.enabled ? config.elastic_min : config.num_consumers;
+
+    // Produtores são registrados antes da criação das threads, para que nenhum
+    // consumidor encerre antes de o primeiro produtor começar
+    print_queue.active_producers = config.num_producers + replayers;
+
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: buffer de %zu posições, %d produtores, %d impressoras\n",
+               config.buffer_size, config.num_producers, num_consumer_threads);
+        if (elastic.enabled)
+        {
+            printf("Pool elástico: %d a %d impressoras, espera alvo de %ld ms\n", config.elastic_min,
+                   config.elastic_max, config.elastic_target_ms);
+        }
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+
+    const char *impl = "mutex";
+    if (print_stats_watch_start(impl, latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar relatório de latências\n");
+        return EXIT_FAILURE;
+    }
+    print_stats_begin(&stats);
+
+    // Reenvia os trabalhos pendentes do diário
+    if (replayers && pthread_create(&replayer, NULL, replay_producer, NULL) != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de reexecução do diário: %s\n", strerror(errno));
+        print_queue.should_stop = 1;
+        return EXIT_FAILURE;
+    }
+
     // Cria threads produtoras
-    for (int i = 0; i < NUM_PRODUCERS; i++)
+    print_trace_start();
+    for (int i = 0; i < config.num_producers; i++)
     {
         producer_ids[i] = i + 1;
         if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
@@ -321,10 +1278,14 @@ int main()
         }
     }
 
-    // Cria threads consumidoras
-    for (int i = 0; i < NUM_CONSUMERS; i++)
+    // Cria threads consumidoras (as primeiras MIN com o pool elástico)
+    for (int i = 0; i < num_consumer_threads; i++)
     {
         consumer_ids[i] = i + 1;
+        if (elastic.enabled)
+        {
+            atomic_store(&elastic.slots[i], PRINTER_SLOT_RUNNING);
+        }
         if (pthread_create(&consumers[i], NULL, consumer, &consumer_ids[i]) != 0)
         {
             fprintf(stderr, "Falha ao criar thread consumidora %d: %s\n", i, strerror(errno));
@@ -333,19 +1294,110 @@ int main()
         }
     }
 
+    // Supervisora do pool elástico
+    if (elastic.enabled)
+    {
+        elastic.running = elastic.peak = num_consumer_threads;
+        if (pthread_create(&elastic.supervisor, NULL, elastic_supervisor, NULL) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread supervisora: %s\n", strerror(errno));
+            print_queue.should_stop = 1;
+            return EXIT_FAILURE;
+        }
+    }
+
     // Aguarda conclusão das threads
-    for (int i = 0; i < NUM_PRODUCERS; i++)
+    if (replayers)
+    {
+        pthread_join(replayer, NULL);
+    }
+    for (int i = 0; i < config.num_producers; i++)
     {
         pthread_join(producers[i], NULL);
     }
-    for (int i = 0; i < NUM_CONSUMERS; i++)
+    if (elastic.enabled)
     {
-        pthread_join(consumers[i], NULL);
+        // Sem a supervisora, nenhuma posição muda de livre para ocupada
+        atomic_store(&elastic.stop, 1);
+        pthread_join(elastic.supervisor, NULL);
+        for (int i = 0; i < config.num_consumers; i++)
+        {
+            if (atomic_load(&elastic.slots[i]) != PRINTER_SLOT_FREE)
+            {
+                pthread_join(consumers[i], NULL);
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < num_consumer_threads; i++)
+        {
+            pthread_join(consumers[i], NULL);
+        }
     }
 
-    // Limpa recursos
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+    if (config.journal != NULL)
+    {
+        print_journal_close();
+    }
+
+    // Escreve as mensagens pendentes e limpa recursos
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report(impl, &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, impl, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        printf("Pool de conteúdo: %u blocos de %zu bytes, %lu lotes retirados e %lu devolvidos à lista global\n",
+               print_slab.num_blocks, print_slab.block_size, atomic_load(&print_slab.refills),
+               atomic_load(&print_slab.flushes));
+    }
+    if (!config.quiet)
+    {
+        print_affinity_report(stdout);
+    }
+    if (elastic.enabled && !config.quiet)
+    {
+        printf("Pool elástico: %lu impressoras iniciadas e %lu dispensadas pela supervisora, pico de %d simultâneas\n",
+               elastic.started, elastic.retired, elastic.peak);
+    }
+    if (config.submit_timeout >= 0 && !config.quiet)
+    {
+        printf("Documentos descartados por prazo de submissão: %lu\n", atomic_load(&docs_shed));
+    }
+    if (config.journal != NULL && !config.quiet)
+    {
+        printf("Diário: %zu trabalhos reexecutados, %lu registros gravados em %lu commits (%.1f por fdatasync)\n",
+               num_recovered_jobs, print_journal.records, print_journal.commits,
+               print_journal.commits ? (double)print_journal.records / print_journal.commits : 0.0);
+    }
+    if (outputs != NULL)
+    {
+        close_outputs(config.num_consumers);
+    }
+    free(recovered_jobs);
+    free(elastic.slots);
+    print_slab_destroy();
+    print_affinity_cleanup();
     cleanup_print_queue();
-    printf("Sistema de fila de impressão finalizado com sucesso\n");
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(producers);
+    free(consumers);
+    free(producer_ids);
+    free(consumer_ids);
+    if (!config.quiet)
+    {
+        printf("Sistema de fila de impressão finalizado com sucesso\n");
+    }
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,658 @@
+/**
+ * Sistema de Fila de Impressão - Implementação em Pipeline (Spool → Render → Print)
+ *
+ * Nas demais versões cada impressora faz todo o trabalho de um documento. Aqui o
+ * trabalho é dividido em três estágios, cada um com suas próprias threads e sua
+ * própria fila limitada de entrada:
+ *
+ *   produtores → [fila 0] → spool → [fila 1] → render → [fila 2] → print
+ *
+ * Cada fila é uma malha de canais SPSC sem locks (print_spsc.h, os mesmos do modo
+ * SPSC do monitor): um canal para cada par escritor → leitor. Um escritor distribui
+ * os documentos entre os leitores em rodízio, pulando canais cheios; um leitor
+ * percorre em rodízio os canais dos seus escritores.
+ *
+ * Características Principais:
+ * - Threads de cada estágio configuráveis com --stages S,R,P (padrão: -c em cada)
+ * - Cada canal tem a capacidade de --buffer-size
+ * - O custo simulado de cada estágio é proporcional ao tamanho do documento; a soma
+ *   dos três é o mesmo custo de impressão das demais versões
+ * - Contrapressão: um estágio cuja fila de saída está cheia fica bloqueado, e o
+ *   bloqueio se propaga até os produtores
+ *
+ * Estatísticas por estágio:
+ * Cada thread mede o tempo em que esteve processando, esperando entrada (fila de
+ * entrada vazia) e bloqueada na saída (fila de saída cheia). Ao final, o relatório
+ * mostra a ocupação de cada estágio e aponta o gargalo, o estágio mais ocupado. As
+ * latências registradas (espera e serviço) são as do estágio de impressão, medidas
+ * desde a entrada do documento no pipeline.
+ *
+ * Desligamento: um escritor que termina fecha os seus canais. Um leitor encerra
+ * quando todos os canais de entrada estão fechados e vazios, e o encerramento
+ * avança estágio a estágio até a impressão.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdatomic.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_trace.h"
+#include "print_spsc.h"
+
+/**
+ * Constantes de Configuração do Sistema
+ *
+ * Capacidade das filas, número de produtores, threads de cada estágio e documentos
+ * por produtor são definidos em tempo de execução (veja print_config.h).
+ */
+#define MAX_TYPE_LENGTH 20 // Tamanho máximo para o tipo do documento
+#define CACHE_LINE_SIZE 64 // Tamanho da linha de cache
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_STAGES | PRINT_OPT_TRACE)
+
+/**
+ * Códigos de Erro do Sistema
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_EMPTY -5   // Fila vazia e sem escritores ativos
+#define PRINT_ERR_NOMEM -6   // Falha na alocação das filas
+
+/**
+ * Estágios do Pipeline
+ */
+#define STAGE_SPOOL 0  // Recebe o documento do produtor e o grava no spool
+#define STAGE_RENDER 1 // Converte o documento para a linguagem da impressora
+#define STAGE_PRINT 2  // Envia o documento ao dispositivo
+
+/**
+ * Estrutura do Documento
+ */
+typedef struct
+{
+    int id;                     // Identificador único do documento
+    char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "PDF", "DOC")
+    int size;                   // Tamanho do documento em KB
+    int producer_id;            // ID da aplicação produtora
+    uint64_t enqueue_ns;        // Momento da entrada no pipeline (CLOCK_MONOTONIC)
+} Document;
+
+/**
+ * Fila Limitada entre Dois Estágios
+ *
+ * Malha de canais SPSC: o canal do escritor w para o leitor r é channels[w * readers + r].
+ * A fila fica definitivamente vazia para um leitor quando todos os seus canais de
+ * entrada estão fechados e vazios.
+ */
+typedef struct
+{
+    PrintSpscChannel *channels; // Canal de cada par escritor → leitor
+    Document *buffers;          // Buffers dos canais, um após o outro
+    int writers;                // Threads que inserem na fila
+    int readers;                // Threads que removem da fila
+} StageQueue;
+
+/**
+ * Estágio do Pipeline
+ *
+ * Os contadores são somados por cada thread do estágio ao encerrar.
+ */
+typedef struct
+{
+    const char *name;        // Nome exibido nas mensagens
+    int cost_us_per_kb;      // Custo simulado por KB do documento
+    int threads;             // Threads do estágio
+    atomic_ulong documents;  // Documentos processados
+    atomic_ulong busy_ns;    // Tempo processando documentos
+    atomic_ulong idle_ns;    // Tempo esperando a fila de entrada
+    atomic_ulong blocked_ns; // Tempo bloqueado na fila de saída cheia
+} PipelineStage;
+
+/**
+ * Estrutura do Pipeline de Impressão
+ *
+ * A fila i é a entrada do estágio i; o estágio i insere na fila i + 1, exceto o
+ * último, que envia os documentos à impressora.
+ */
+typedef struct
+{
+    StageQueue queues[PRINT_PIPELINE_STAGES]; // Fila de entrada de cada estágio
+    size_t capacity;                          // Capacidade de cada canal (potência de dois)
+    atomic_int should_stop;                   // Flag para desligamento do sistema
+} PrintPipeline;
+
+/**
+ * Argumento das Threads dos Estágios
+ */
+typedef struct
+{
+    int stage; // Estágio da thread
+    int id;    // ID da thread dentro do estágio (a partir de 1)
+} StageWorker;
+
+/**
+ * Posição de uma thread em uma fila: seu índice e o próximo canal do rodízio
+ */
+typedef struct
+{
+    StageQueue *queue; // Fila
+    int index;         // Índice da thread entre os escritores (ou leitores) da fila
+    int next;          // Próximo leitor (ou escritor) a tentar, módulo o seu número
+} StageEndpoint;
+
+// Instância global do pipeline
+PrintPipeline pipeline;
+
+// Estágios: a soma dos custos é o custo de impressão das demais versões (10ms/KB)
+PipelineStage stages[PRINT_PIPELINE_STAGES] = {
+    [STAGE_SPOOL] = {.name = "Spool", .cost_us_per_kb = 500},
+    [STAGE_RENDER] = {.name = "Render", .cost_us_per_kb = 6000},
+    [STAGE_PRINT] = {.name = "Print", .cost_us_per_kb = 3500}};
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências entrada no pipeline → impressão registradas por cada thread de impressão
+PrintLatencyRecorder *latency;
+
+/**
+ * Inicializa as filas do pipeline
+ *
+ * @param capacity Capacidade de cada canal (potência de dois)
+ * @param num_producers Número de produtores, escritores da primeira fila
+ * @return PRINT_SUCCESS ou PRINT_ERR_NOMEM
+ */
+int init_pipeline(size_t capacity, int num_producers)
+{
+    pipeline.capacity = capacity;
+
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        StageQueue *queue = &pipeline.queues[i];
+        size_t num_channels;
+
+        queue->writers = i == 0 ? num_producers : stages[i - 1].threads;
+        queue->readers = stages[i].threads;
+        num_channels = (size_t)queue->writers * queue->readers;
+        queue->channels = aligned_alloc(CACHE_LINE_SIZE, num_channels * sizeof(PrintSpscChannel));
+        queue->buffers = calloc(num_channels * capacity, sizeof(Document));
+        if (queue->channels == NULL || queue->buffers == NULL)
+        {
+            fprintf(stderr, "Falha ao alocar %zu canais de %zu posições: %s\n", num_channels, capacity,
+                    strerror(errno));
+            return PRINT_ERR_NOMEM;
+        }
+        for (size_t c = 0; c < num_channels; c++)
+        {
+            print_spsc_init(&queue->channels[c], &queue->buffers[c * capacity], capacity, sizeof(Document));
+        }
+    }
+    atomic_init(&pipeline.should_stop, 0);
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Libera recursos das filas do pipeline
+ */
+void cleanup_pipeline(void)
+{
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        StageQueue *queue = &pipeline.queues[i];
+
+        free(queue->channels);
+        free(queue->buffers);
+        queue->channels = NULL;
+        queue->buffers = NULL;
+    }
+}
+
+/**
+ * Insere um documento em uma fila, aguardando enquanto todos os canais do escritor
+ * estiverem cheios
+ *
+ * Tenta os leitores em rodízio a partir do seguinte ao último usado, de modo que um
+ * leitor lento não retém o escritor enquanto outro tem espaço.
+ *
+ * @param writer Escritor e sua fila
+ * @param doc Documento a ser inserido
+ * @param pos Recebe a posição ocupada no canal
+ * @param blocked_ns Acumula o tempo de espera por espaço livre
+ * @return PRINT_SUCCESS ou PRINT_ERR_STOPPED se o sistema estiver em desligamento
+ */
+int stage_queue_insert(StageEndpoint *writer, const Document *doc, size_t *pos, uint64_t *blocked_ns)
+{
+    StageQueue *queue = writer->queue;
+    PrintSpscChannel *row = &queue->channels[(size_t)writer->index * queue->readers];
+    uint64_t start = 0;
+    int attempt = 0;
+
+    for (;;)
+    {
+        for (int i = 0; i < queue->readers; i++)
+        {
+            int reader = (writer->next + i) % queue->readers;
+            if (print_spsc_try_insert(&row[reader], doc, pos))
+            {
+                writer->next = (reader + 1) % queue->readers;
+                if (start != 0)
+                {
+                    *blocked_ns += print_stats_now() - start;
+                }
+                return PRINT_SUCCESS;
+            }
+        }
+        if (atomic_load(&pipeline.should_stop))
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        if (start == 0)
+        {
+            start = print_stats_now();
+        }
+        print_spsc_backoff(&attempt);
+    }
+}
+
+/**
+ * Remove um documento de uma fila, aguardando enquanto os canais do leitor
+ * estiverem vazios
+ *
+ * @param reader Leitor e sua fila
+ * @param doc Recebe o documento removido
+ * @param pos Recebe a posição liberada no canal
+ * @param idle_ns Acumula o tempo de espera por documentos
+ * @return PRINT_SUCCESS ou PRINT_ERR_EMPTY se todos os canais estiverem fechados e vazios
+ */
+int stage_queue_remove(StageEndpoint *reader, Document *doc, size_t *pos, uint64_t *idle_ns)
+{
+    StageQueue *queue = reader->queue;
+    uint64_t start = 0;
+    int attempt = 0;
+
+    for (;;)
+    {
+        int closed = 1;
+
+        for (int i = 0; i < queue->writers; i++)
+        {
+            int writer = (reader->next + i) % queue->writers;
+            PrintSpscChannel *c = &queue->channels[(size_t)writer * queue->readers + reader->index];
+
+            // Fechado antes da tentativa: se ela falhar, o canal está esgotado
+            closed &= print_spsc_closed(c);
+            if (print_spsc_try_remove(c, doc, pos))
+            {
+                reader->next = (writer + 1) % queue->writers;
+                if (start != 0)
+                {
+                    *idle_ns += print_stats_now() - start;
+                }
+                return PRINT_SUCCESS;
+            }
+        }
+        if (closed || atomic_load(&pipeline.should_stop))
+        {
+            if (start != 0)
+            {
+                *idle_ns += print_stats_now() - start;
+            }
+            return PRINT_ERR_EMPTY;
+        }
+        if (start == 0)
+        {
+            start = print_stats_now();
+        }
+        print_spsc_backoff(&attempt);
+    }
+}
+
+/**
+ * Fecha os canais de um escritor da fila
+ *
+ * Cada leitor encerra ao encontrar todos os seus canais fechados e vazios.
+ *
+ * @param writer Escritor e sua fila
+ */
+void stage_queue_writer_done(StageEndpoint *writer)
+{
+    StageQueue *queue = writer->queue;
+
+    for (int r = 0; r < queue->readers; r++)
+    {
+        print_spsc_close(&queue->channels[(size_t)writer->index * queue->readers + r]);
+    }
+}
+
+/**
+ * Interrompe o pipeline: as threads que esperam nas filas encerram na próxima
+ * verificação
+ */
+void stop_pipeline(void)
+{
+    atomic_store(&pipeline.should_stop, 1);
+}
+
+/**
+ * Função da Thread Produtora
+ *
+ * Simula uma aplicação enviando documentos para a fila de entrada do pipeline.
+ *
+ * @param arg Ponteiro para o ID do produtor (int)
+ * @return NULL
+ */
+void *producer(void *arg)
+{
+    int producer_id = *(int *)arg;
+    int docs_produced = 0;
+    uint64_t blocked_ns = 0;
+    size_t pos;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+    StageEndpoint output = {&pipeline.queues[STAGE_SPOOL], producer_id - 1, producer_id - 1};
+
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+
+    while (docs_produced < config.max_documents && !atomic_load(&pipeline.should_stop))
+    {
+        // Cria novo documento com propriedades simuladas
+        Document doc = {
+            .id = (producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
+            .producer_id = producer_id};
+        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        if (print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH) != 0)
+        {
+            break; // Fim do trace deste produtor
+        }
+
+        doc.enqueue_ns = print_stats_now();
+        if (stage_queue_insert(&output, &doc, &pos, &blocked_ns) != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        print_log("[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                  producer_id, doc.id, doc.type, doc.size, pos);
+
+        docs_produced++;
+        if (config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
+    }
+
+    // Fecha os canais do produtor: o spool encerra quando todos estiverem esgotados
+    stage_queue_writer_done(&output);
+
+    print_log("[Produtor %d] Finalizou a produção de documentos\n", producer_id);
+    return NULL;
+}
+
+/**
+ * Função das Threads dos Estágios
+ *
+ * Remove documentos da fila de entrada do estágio, simula o seu custo e os insere na
+ * fila do estágio seguinte; as threads de impressão registram as latências. Encerra
+ * quando a fila de entrada fica vazia e sem escritores.
+ *
+ * @param arg Ponteiro para o StageWorker da thread
+ * @return NULL
+ */
+void *stage_worker(void *arg)
+{
+    StageWorker *worker = arg;
+    PipelineStage *stage = &stages[worker->stage];
+    StageEndpoint input = {&pipeline.queues[worker->stage], worker->id - 1, 0};
+    StageEndpoint output = {worker->stage == STAGE_PRINT ? NULL : &pipeline.queues[worker->stage + 1],
+                            worker->id - 1, worker->id - 1};
+    unsigned long documents = 0;
+    uint64_t busy_ns = 0;
+    uint64_t idle_ns = 0;
+    uint64_t blocked_ns = 0;
+    Document doc;
+    size_t pos;
+
+    while (stage_queue_remove(&input, &doc, &pos, &idle_ns) == PRINT_SUCCESS)
+    {
+        uint64_t timestamp = print_stats_now();
+        print_log("[%s %d] Processando documento %d (%s, %dKB) da posição %zu\n",
+                  stage->name, worker->id, doc.id, doc.type, doc.size, pos);
+
+        // Simula o custo do estágio, proporcional ao tamanho do documento
+        if (config.simulate_delays)
+        {
+            usleep(doc.size * stage->cost_us_per_kb);
+        }
+        uint64_t done = print_stats_now();
+        busy_ns += done - timestamp;
+        documents++;
+
+        if (output.queue == NULL)
+        {
+            PrintLatencyRecorder *recorder = &latency[worker->id - 1];
+            print_latency_record(recorder, timestamp - doc.enqueue_ns);
+            print_service_record(recorder, done - timestamp);
+        }
+        else if (stage_queue_insert(&output, &doc, &pos, &blocked_ns) != PRINT_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    atomic_fetch_add(&stage->documents, documents);
+    atomic_fetch_add(&stage->busy_ns, busy_ns);
+    atomic_fetch_add(&stage->idle_ns, idle_ns);
+    atomic_fetch_add(&stage->blocked_ns, blocked_ns);
+    if (output.queue != NULL)
+    {
+        stage_queue_writer_done(&output);
+    }
+
+    print_log("[%s %d] Não há mais documentos, encerrando\n", stage->name, worker->id);
+    return NULL;
+}
+
+/**
+ * Exibe a ocupação de cada estágio e aponta o gargalo
+ *
+ * As porcentagens são relativas ao tempo total das threads do estágio
+ * (threads × duração da execução).
+ *
+ * @param elapsed_ns Duração da execução
+ */
+void stage_report(uint64_t elapsed_ns)
+{
+    int bottleneck = 0;
+    double bottleneck_busy = -1.0;
+
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        PipelineStage *stage = &stages[i];
+        double total = (double)elapsed_ns * stage->threads;
+        double busy = total > 0 ? 100.0 * atomic_load(&stage->busy_ns) / total : 0.0;
+        double idle = total > 0 ? 100.0 * atomic_load(&stage->idle_ns) / total : 0.0;
+        double blocked = total > 0 ? 100.0 * atomic_load(&stage->blocked_ns) / total : 0.0;
+
+        printf("Estágio %s: %d threads, %lu documentos, ocupação %.1f%%, "
+               "esperando entrada %.1f%%, bloqueado na saída %.1f%%\n",
+               stage->name, stage->threads, atomic_load(&stage->documents), busy, idle, blocked);
+        if (busy > bottleneck_busy)
+        {
+            bottleneck = i;
+            bottleneck_busy = busy;
+        }
+    }
+    printf("Gargalo: estágio %s (ocupação %.1f%%)\n", stages[bottleneck].name, bottleneck_busy);
+}
+
+/**
+ * Função Principal
+ *
+ * Inicializa o sistema, cria threads produtoras e as threads de cada estágio,
+ * aguarda conclusão e finaliza.
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
+ * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
+ */
+int main(int argc, char *argv[])
+{
+    pthread_t *producers;
+    pthread_t *workers[PRINT_PIPELINE_STAGES];
+    int *producer_ids;
+    StageWorker *worker_args[PRINT_PIPELINE_STAGES];
+    PrintStats stats;
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // As impressoras desta versão são as threads do estágio de impressão
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        stages[i].threads = config.stage_threads[i];
+    }
+    config.num_consumers = stages[STAGE_PRINT].threads;
+
+    producers = calloc(config.num_producers, sizeof(pthread_t));
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !producer_ids || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de threads\n");
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        workers[i] = calloc(stages[i].threads, sizeof(pthread_t));
+        worker_args[i] = calloc(stages[i].threads, sizeof(StageWorker));
+        if (!workers[i] || !worker_args[i])
+        {
+            fprintf(stderr, "Falha ao alocar vetores de threads\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (init_pipeline(config.buffer_size, config.num_producers) != PRINT_SUCCESS)
+    {
+        fprintf(stderr, "Falha ao inicializar o pipeline\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: pipeline com canais de %zu posições, %d produtores, "
+               "%d spool, %d render, %d impressoras\n",
+               config.buffer_size, config.num_producers, stages[STAGE_SPOOL].threads,
+               stages[STAGE_RENDER].threads, stages[STAGE_PRINT].threads);
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+
+    if (print_stats_watch_start("pipeline", latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar relatório de latências\n");
+        return EXIT_FAILURE;
+    }
+    print_stats_begin(&stats);
+
+    // Cria threads produtoras
+    print_trace_start();
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        producer_ids[i] = i + 1;
+        if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread produtora %d: %s\n", i, strerror(errno));
+            stop_pipeline();
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Cria as threads de cada estágio
+    for (int s = 0; s < PRINT_PIPELINE_STAGES; s++)
+    {
+        for (int i = 0; i < stages[s].threads; i++)
+        {
+            worker_args[s][i] = (StageWorker){.stage = s, .id = i + 1};
+            if (pthread_create(&workers[s][i], NULL, stage_worker, &worker_args[s][i]) != 0)
+            {
+                fprintf(stderr, "Falha ao criar thread %d do estágio %s: %s\n", i, stages[s].name,
+                        strerror(errno));
+                stop_pipeline();
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    // Aguarda conclusão das threads
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    for (int s = 0; s < PRINT_PIPELINE_STAGES; s++)
+    {
+        for (int i = 0; i < stages[s].threads; i++)
+        {
+            pthread_join(workers[s][i], NULL);
+        }
+    }
+
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report("pipeline", &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, "pipeline", latency, config.num_consumers);
+        stage_report(stats.end_ns - stats.start_ns);
+    }
+    cleanup_pipeline();
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(producers);
+    free(producer_ids);
+    for (int i = 0; i < PRINT_PIPELINE_STAGES; i++)
+    {
+        free(workers[i]);
+        free(worker_args[i]);
+    }
+    if (!config.quiet)
+    {
+        printf("Sistema de fila de impressão finalizado com sucesso\n");
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,19 @@
  * - Múltiplos produtores e consumidores
  * - Sincronização usando semáforos POSIX
  * - Simulação de tempos variáveis de produção e consumo
+ * - Mensagens registradas fora da região crítica, em log assíncrono sem locks (print_log.h)
+ *
+ * Semáforos:
+ * Por padrão são usados os semáforos POSIX da glibc (sem_t). Compilando com
+ * -DUSE_FUTEX_SEM, o programa usa o semáforo leve de print_futex.h, cujo caminho sem
+ * disputa não faz chamada de sistema. A opção --compare mede as duas implementações
+ * no mesmo programa (operações sem disputa e alternância entre duas threads).
+ *
+ * Espera limitada:
+ * buffer_insert_until/buffer_remove_until esperam os semáforos até um prazo
+ * (sem_timedwait ou futex com prazo absoluto) e buffer_try_insert/buffer_try_remove
+ * não esperam; com --submit-timeout-ms os produtores descartam o documento em vez de
+ * bloquear com o buffer cheio.
  */
 
 #include <stdio.h>
@@ -20,14 +33,105 @@
 #include <semaphore.h>
 #include <stdarg.h>
 
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_trace.h"
+#include "print_affinity.h"
+#include "print_futex.h"
+#include "print_deadline.h"
+
 /**
  * Configurações do sistema
+ *
+ * Capacidade do buffer, número de produtores e consumidores e documentos por produtor
+ * são definidos em tempo de execução (veja print_config.h).
  */
-#define BUFFER_SIZE 5      // Tamanho do buffer circular
-#define NUM_PRODUCERS 3    // Número de threads produtoras (aplicações)
-#define NUM_CONSUMERS 2    // Número de threads consumidoras (impressoras)
-#define MAX_DOCUMENTS 10   // Máximo de documentos por produtor
 #define MAX_TYPE_LENGTH 20 // Tamanho máximo do tipo do documento
+#define COMPARE_OPERATIONS 1000000 // Operações por medição em --compare
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_COMPARE | PRINT_OPT_SUBMIT_TIMEOUT | PRINT_OPT_TRACE | PRINT_OPT_AFFINITY)
+
+/**
+ * Resultados das operações do buffer
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_EMPTY -5   // Buffer vazio e produção encerrada
+#define PRINT_ERR_TIMEOUT -8 // Prazo vencido (buffer cheio ou vazio nas operações try_*)
+
+/**
+ * Semáforo usado pela fila (selecionado em tempo de compilação)
+ *
+ * print_sem_* seguem a convenção de sem_init/sem_wait/sem_post/sem_destroy.
+ */
+#ifdef USE_FUTEX_SEM
+typedef FutexSem PrintSem;
+#define PRINT_SEM_NAME "sem-futex"
+#else
+typedef sem_t PrintSem;
+#define PRINT_SEM_NAME "sem"
+#endif
+
+static inline int print_sem_init(PrintSem *s, unsigned value)
+{
+#ifdef USE_FUTEX_SEM
+    return futex_sem_init(s, value);
+#else
+    return sem_init(s, 0, value);
+#endif
+}
+
+static inline int print_sem_wait(PrintSem *s)
+{
+#ifdef USE_FUTEX_SEM
+    return futex_sem_wait(s);
+#else
+    // Um sinal tratado (SIGUSR1, print_stats.h) interrompe sem_wait mesmo com SA_RESTART
+    int ret;
+    while ((ret = sem_wait(s)) != 0 && errno == EINTR)
+    {
+    }
+    return ret;
+#endif
+}
+
+static inline int print_sem_timedwait(PrintSem *s, const struct timespec *deadline)
+{
+    if (deadline == NULL)
+    {
+        return print_sem_wait(s);
+    }
+#ifdef USE_FUTEX_SEM
+    return futex_sem_timedwait(s, deadline);
+#else
+    int ret;
+    while ((ret = sem_timedwait(s, deadline)) != 0 && errno == EINTR)
+    {
+    }
+    return ret;
+#endif
+}
+
+static inline int print_sem_post(PrintSem *s)
+{
+#ifdef USE_FUTEX_SEM
+    return futex_sem_post(s);
+#else
+    return sem_post(s);
+#endif
+}
+
+static inline int print_sem_destroy(PrintSem *s)
+{
+#ifdef USE_FUTEX_SEM
+    return futex_sem_destroy(s);
+#else
+    return sem_destroy(s);
+#endif
+}
 
 /**
  * Estrutura que representa um documento na fila de impressão
@@ -38,48 +142,145 @@ typedef struct
     char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "Doc1", "Doc2")
     int size;                   // Tamanho do documento em KB
     int producer_id;            // ID do produtor que criou o documento
+    uint64_t enqueue_ns;        // Momento da inserção no buffer (CLOCK_MONOTONIC)
 } Document;
 
 /**
  * Buffer circular e variáveis de controle
  */
-Document buffer[BUFFER_SIZE]; // Buffer circular para armazenar documentos
-int in = 0;                   // Índice para inserção no buffer
-int out = 0;                  // Índice para remoção do buffer
+Document *buffer;   // Buffer circular para armazenar documentos
+size_t buffer_mask; // Capacidade do buffer - 1 (capacidade é potência de dois)
+size_t in = 0;      // Índice para inserção no buffer
+size_t out = 0;     // Índice para remoção do buffer
+size_t count = 0;   // Documentos no buffer (protegido pelo semáforo mutex)
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências inserção → remoção registradas por cada consumidor
+PrintLatencyRecorder *latency;
 
 /**
  * Semáforos para controle de sincronização
  */
-sem_t empty;       // Controla número de espaços vazios no buffer
-sem_t full;        // Controla número de espaços ocupados no buffer
-sem_t mutex;       // Protege acesso à região crítica (buffer)
-sem_t print_mutex; // Protege operações de impressão no console
+PrintSem empty; // Controla número de espaços vazios no buffer
+PrintSem full;  // Controla número de espaços ocupados no buffer
+PrintSem mutex; // Protege acesso à região crítica (buffer)
 
 /**
  * Flag global para controle de finalização do sistema
  */
 volatile int should_stop = 0;
 
+// Documentos descartados porque o prazo de submissão venceu (--submit-timeout-ms)
+atomic_ulong docs_shed;
+
 /**
  * Função thread-safe para impressão de mensagens no console
- * Usa semáforo para garantir que apenas uma thread imprima por vez
+ * Registra a mensagem no buffer de log da própria thread, sem semáforo; a thread
+ * escritora do log (print_log.h) a envia ao console
  *
+ * @param timestamp Momento do evento (print_log_now)
  * @param format String de formato (igual ao printf)
  * @param ... Argumentos variáveis para o formato
  */
-void safe_print(const char *format, ...)
+void safe_print(uint64_t timestamp, const char *format, ...)
 {
     va_list args;
     va_start(args, format);
 
-    sem_wait(&print_mutex); // Obtém acesso exclusivo ao console
-    vprintf(format, args);
-    fflush(stdout);
-    sem_post(&print_mutex); // Libera acesso ao console
+    print_logv_at(timestamp, format, args);
 
     va_end(args);
 }
 
+/**
+ * Insere um documento no buffer, esperando por espaço até o prazo
+ *
+ * @param doc Documento (recebe a marca de tempo de inserção)
+ * @param pos Recebe a posição ocupada
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, ou PRINT_ERR_TIMEOUT se o buffer continuou cheio até o prazo
+ */
+int buffer_insert_until(Document *doc, size_t *pos, const struct timespec *deadline)
+{
+    if (print_sem_timedwait(&empty, deadline) != 0) // Aguarda espaço vazio no buffer
+    {
+        return PRINT_ERR_TIMEOUT;
+    }
+    print_sem_wait(&mutex); // Entra na região crítica
+
+    // Adiciona documento ao buffer
+    *pos = in;
+    doc->enqueue_ns = print_log_now();
+    buffer[*pos] = *doc;
+
+    in = (in + 1) & buffer_mask; // Atualiza índice de inserção
+    count++;
+
+    print_sem_post(&mutex); // Sai da região crítica
+    print_sem_post(&full);  // Sinaliza item produzido
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Insere um documento se houver espaço, sem esperar
+ *
+ * @return PRINT_SUCCESS, ou PRINT_ERR_TIMEOUT se o buffer estiver cheio
+ */
+int buffer_try_insert(Document *doc, size_t *pos)
+{
+    return buffer_insert_until(doc, pos, &print_deadline_now);
+}
+
+/**
+ * Remove um documento do buffer, esperando até o prazo
+ *
+ * @param doc Recebe o documento
+ * @param pos Recebe a posição liberada
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_EMPTY se a produção terminou e o buffer está vazio,
+ *         ou PRINT_ERR_TIMEOUT se nenhum documento chegou até o prazo
+ */
+int buffer_remove_until(Document *doc, size_t *pos, const struct timespec *deadline)
+{
+    if (print_sem_timedwait(&full, deadline) != 0) // Aguarda documento disponível
+    {
+        return PRINT_ERR_TIMEOUT;
+    }
+    print_sem_wait(&mutex); // Entra na região crítica
+
+    // Buffer vazio: o sinal veio da finalização, não de um documento. Repassa-o à
+    // próxima impressora (cascata), de modo que a finalização faça um único post
+    if (count == 0)
+    {
+        print_sem_post(&mutex);
+        print_sem_post(&full);
+        return PRINT_ERR_EMPTY;
+    }
+
+    // Remove documento do buffer
+    *pos = out;
+    *doc = buffer[*pos];
+
+    out = (out + 1) & buffer_mask; // Atualiza índice de remoção
+    count--;
+
+    print_sem_post(&mutex); // Sai da região crítica
+    print_sem_post(&empty); // Sinaliza espaço livre
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Remove um documento se houver algum, sem esperar
+ *
+ * @return PRINT_SUCCESS, PRINT_ERR_EMPTY ou PRINT_ERR_TIMEOUT se o buffer estiver vazio
+ */
+int buffer_try_remove(Document *doc, size_t *pos)
+{
+    return buffer_remove_until(doc, pos, &print_deadline_now);
+}
+
 /**
  * Função executada pelas threads produtoras
  * Simula aplicações gerando documentos para impressão
@@ -91,34 +292,49 @@ void *producer(void *arg)
 {
     int producer_id = *(int *)arg;
     int docs_produced = 0;
+    struct timespec deadline;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+    print_affinity_pin(PRINT_AFFINITY_PRODUCER, producer_id - 1);
 
-    while (docs_produced < MAX_DOCUMENTS && !should_stop)
+    while (docs_produced < config.max_documents && !should_stop)
     {
         // Cria novo documento com dados simulados
         Document doc = {
-            .id = (producer_id * MAX_DOCUMENTS) + docs_produced,
-            .size = rand() % 100 + 1,
+            .id = (producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
             .producer_id = producer_id};
         snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        if (print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH) != 0)
+        {
+            break; // Fim do trace deste produtor
+        }
 
-        sem_wait(&empty); // Aguarda espaço vazio no buffer
-        sem_wait(&mutex); // Entra na região crítica
-
-        // Adiciona documento ao buffer
-        buffer[in] = doc;
-        safe_print("[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %d\n",
-                   producer_id, doc.id, doc.type, doc.size, in);
-
-        in = (in + 1) % BUFFER_SIZE; // Atualiza índice de inserção
-
-        sem_post(&mutex); // Sai da região crítica
-        sem_post(&full);  // Sinaliza item produzido
+        size_t pos;
+        if (buffer_insert_until(&doc, &pos, print_deadline_for(config.submit_timeout, &deadline)) == PRINT_SUCCESS)
+        {
+            print_affinity_note(PRINT_AFFINITY_PRODUCER, producer_id - 1, 1);
+            safe_print(doc.enqueue_ns, "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                       producer_id, doc.id, doc.type, doc.size, pos);
+        }
+        else
+        {
+            // Buffer saturado: descarta o documento em vez de bloquear o produtor
+            atomic_fetch_add_explicit(&docs_shed, 1, memory_order_relaxed);
+            safe_print(print_log_now(), "[Produtor %d] Buffer cheio, documento %d descartado\n",
+                       producer_id, doc.id);
+        }
 
         docs_produced++;
-        usleep(rand() % 500000); // Simula tempo variável de produção (0-500ms)
+        if (config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de produção (0-500ms)
+        }
     }
 
-    safe_print("[Produtor %d] Finalizou após produzir %d documentos\n",
+    safe_print(print_log_now(), "[Produtor %d] Finalizou após produzir %d documentos\n",
                producer_id, docs_produced);
     return NULL;
 }
@@ -135,27 +351,29 @@ void *consumer(void *arg)
     int consumer_id = *(int *)arg;
     int docs_consumed = 0;
 
-    while (!should_stop)
-    {
-        sem_wait(&full);  // Aguarda documento disponível
-        sem_wait(&mutex); // Entra na região crítica
-
-        // Remove documento do buffer
-        Document doc = buffer[out];
-        safe_print("[Consumidor %d] Imprimindo documento %d (%s, %dKB) da posição %d\n",
-                   consumer_id, doc.id, doc.type, doc.size, out);
+    Document doc;
+    size_t pos;
 
-        out = (out + 1) % BUFFER_SIZE; // Atualiza índice de remoção
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, consumer_id - 1);
+    while (buffer_remove_until(&doc, &pos, NULL) == PRINT_SUCCESS)
+    {
+        uint64_t timestamp = print_log_now();
         docs_consumed++;
 
-        sem_post(&mutex); // Sai da região crítica
-        sem_post(&empty); // Sinaliza espaço livre
+        print_latency_record(&latency[consumer_id - 1], timestamp - doc.enqueue_ns);
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, consumer_id - 1, 1);
+        safe_print(timestamp, "[Consumidor %d] Imprimindo documento %d (%s, %dKB) da posição %zu\n",
+                   consumer_id, doc.id, doc.type, doc.size, pos);
 
         // Simula tempo de impressão proporcional ao tamanho do documento
-        usleep(doc.size * 10000);
+        if (config.simulate_delays)
+        {
+            usleep(doc.size * 10000);
+        }
+        print_service_record(&latency[consumer_id - 1], print_log_now() - timestamp);
     }
 
-    safe_print("[Consumidor %d] Finalizou após consumir %d documentos\n",
+    safe_print(print_log_now(), "[Consumidor %d] Finalizou após consumir %d documentos\n",
                consumer_id, docs_consumed);
     return NULL;
 }
@@ -163,41 +381,32 @@ void *consumer(void *arg)
 /**
  * Inicializa todos os semáforos necessários
  *
+ * @param capacity Capacidade do buffer (valor inicial do semáforo empty)
  * @return 0 em caso de sucesso, -1 em caso de erro
  */
-int init_semaphores()
+int init_semaphores(size_t capacity)
 {
     // Inicializa semáforo para espaços vazios
-    if (sem_init(&empty, 0, BUFFER_SIZE) != 0)
+    if (print_sem_init(&empty, capacity) != 0)
     {
         printf("Erro ao inicializar semáforo empty\n");
         return -1;
     }
 
     // Inicializa semáforo para documentos disponíveis
-    if (sem_init(&full, 0, 0) != 0)
+    if (print_sem_init(&full, 0) != 0)
     {
         printf("Erro ao inicializar semáforo full\n");
-        sem_destroy(&empty);
+        print_sem_destroy(&empty);
         return -1;
     }
 
     // Inicializa mutex para proteção do buffer
-    if (sem_init(&mutex, 0, 1) != 0)
+    if (print_sem_init(&mutex, 1) != 0)
     {
         printf("Erro ao inicializar semáforo mutex\n");
-        sem_destroy(&empty);
-        sem_destroy(&full);
-        return -1;
-    }
-
-    // Inicializa mutex para proteção da impressão
-    if (sem_init(&print_mutex, 0, 1) != 0)
-    {
-        printf("Erro ao inicializar semáforo print_mutex\n");
-        sem_destroy(&empty);
-        sem_destroy(&full);
-        sem_destroy(&mutex);
+        print_sem_destroy(&empty);
+        print_sem_destroy(&full);
         return -1;
     }
 
@@ -209,33 +418,274 @@ int init_semaphores()
  */
 void destroy_semaphores()
 {
-    sem_destroy(&empty);
-    sem_destroy(&full);
-    sem_destroy(&mutex);
-    sem_destroy(&print_mutex);
+    print_sem_destroy(&empty);
+    print_sem_destroy(&full);
+    print_sem_destroy(&mutex);
+}
+
+/**
+ * Operações de uma implementação de semáforo (usadas por --compare)
+ */
+typedef struct
+{
+    const char *name;                  // Nome exibido
+    size_t size;                       // Tamanho do objeto semáforo
+    int (*init)(void *s, unsigned v);  // Inicializa com valor v
+    int (*wait)(void *s);              // Decrementa (bloqueante)
+    int (*post)(void *s);              // Incrementa
+    int (*destroy)(void *s);           // Libera
+} SemOps;
+
+/**
+ * Adaptadores de sem_t e FutexSem para a interface de SemOps
+ */
+static int glibc_sem_init(void *s, unsigned v)
+{
+    return sem_init(s, 0, v);
+}
+
+static int glibc_sem_wait(void *s)
+{
+    return sem_wait(s);
+}
+
+static int glibc_sem_post(void *s)
+{
+    return sem_post(s);
+}
+
+static int glibc_sem_destroy(void *s)
+{
+    return sem_destroy(s);
+}
+
+static int futex_ops_init(void *s, unsigned v)
+{
+    return futex_sem_init(s, v);
+}
+
+static int futex_ops_wait(void *s)
+{
+    return futex_sem_wait(s);
+}
+
+static int futex_ops_post(void *s)
+{
+    return futex_sem_post(s);
+}
+
+static int futex_ops_destroy(void *s)
+{
+    return futex_sem_destroy(s);
+}
+
+static const SemOps sem_implementations[] = {
+    {"sem_t", sizeof(sem_t), glibc_sem_init, glibc_sem_wait, glibc_sem_post, glibc_sem_destroy},
+    {"futex", sizeof(FutexSem), futex_ops_init, futex_ops_wait, futex_ops_post, futex_ops_destroy}};
+
+/**
+ * Par de semáforos usado na alternância entre duas threads
+ */
+typedef struct
+{
+    const SemOps *ops;
+    void *ping; // Sinalizado pela thread principal
+    void *pong; // Sinalizado pela thread parceira
+} PingPong;
+
+/**
+ * Thread parceira da alternância: devolve cada sinal recebido
+ */
+void *ping_pong_partner(void *arg)
+{
+    PingPong *pp = arg;
+
+    for (int i = 0; i < COMPARE_OPERATIONS; i++)
+    {
+        pp->ops->wait(pp->ping);
+        pp->ops->post(pp->pong);
+    }
+    return NULL;
+}
+
+/**
+ * Mede uma implementação de semáforo e exibe o resultado
+ *
+ * @param ops Implementação
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int compare_semaphore(const SemOps *ops)
+{
+    void *ping = calloc(1, ops->size);
+    void *pong = calloc(1, ops->size);
+    PingPong pp = {ops, ping, pong};
+    pthread_t partner;
+    PrintStats uncontended, alternating;
+    int ping_ready = 0;
+    int pong_ready = 0;
+    int ret = 1;
+
+    ping_ready = ping != NULL && ops->init(ping, 0) == 0;
+    pong_ready = ping_ready && pong != NULL && ops->init(pong, 0) == 0;
+    if (!pong_ready)
+    {
+        printf("Falha ao inicializar semáforo %s\n", ops->name);
+        goto cleanup;
+    }
+
+    print_stats_begin(&uncontended);
+    for (int i = 0; i < COMPARE_OPERATIONS; i++)
+    {
+        ops->post(ping);
+        ops->wait(ping);
+    }
+    print_stats_end(&uncontended);
+
+    print_stats_begin(&alternating);
+    if (pthread_create(&partner, NULL, ping_pong_partner, &pp) != 0)
+    {
+        printf("Erro ao criar thread parceira\n");
+        goto cleanup;
+    }
+    for (int i = 0; i < COMPARE_OPERATIONS; i++)
+    {
+        ops->post(ping);
+        ops->wait(pong);
+    }
+    pthread_join(partner, NULL);
+    print_stats_end(&alternating);
+
+    printf("Semáforo %-6s sem disputa: %6.1f ns/par post+wait | alternância: %7.1f ns/ida e volta, "
+           "%.2f trocas de contexto\n",
+           ops->name,
+           (double)(uncontended.end_ns - uncontended.start_ns) / COMPARE_OPERATIONS,
+           (double)(alternating.end_ns - alternating.start_ns) / COMPARE_OPERATIONS,
+           (double)(alternating.end_switches - alternating.start_switches) / COMPARE_OPERATIONS);
+    ret = 0;
+
+cleanup:
+    if (ping_ready)
+    {
+        ops->destroy(ping);
+    }
+    if (pong_ready)
+    {
+        ops->destroy(pong);
+    }
+    free(ping);
+    free(pong);
+    return ret;
+}
+
+/**
+ * Compara sem_t e o semáforo sobre futex
+ *
+ * Para cada implementação mede:
+ * - Pares post/wait sem disputa em uma única thread (caminho rápido)
+ * - Idas e voltas entre duas threads que se alternam por dois semáforos
+ *
+ * @return 0 em caso de sucesso, 1 em caso de erro
+ */
+int compare_semaphores(void)
+{
+    printf("Comparação de semáforos (%d operações)\n", COMPARE_OPERATIONS);
+
+    for (size_t k = 0; k < sizeof(sem_implementations) / sizeof(sem_implementations[0]); k++)
+    {
+        if (compare_semaphore(&sem_implementations[k]) != 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
 }
 
 /**
  * Função principal
  * Inicializa o sistema, cria threads e gerencia ciclo de vida
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
  */
-int main()
+int main(int argc, char *argv[])
 {
-    pthread_t producers[NUM_PRODUCERS];
-    pthread_t consumers[NUM_CONSUMERS];
-    int producer_ids[NUM_PRODUCERS];
-    int consumer_ids[NUM_CONSUMERS];
-    int i;
+    pthread_t *producers;
+    pthread_t *consumers;
+    int *producer_ids;
+    int *consumer_ids;
+    PrintStats stats;
+    int i, ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? 0 : 1;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return 1;
+    }
+
+    if (config.compare)
+    {
+        return compare_semaphores();
+    }
+
+    // Topologia e nó do buffer, antes de alocá-lo
+    if (print_affinity_init(&config, config.num_producers, config.num_consumers) != 0)
+    {
+        return 1;
+    }
+
+    producers = calloc(config.num_producers, sizeof(pthread_t));
+    consumers = calloc(config.num_consumers, sizeof(pthread_t));
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    consumer_ids = calloc(config.num_consumers, sizeof(int));
+    buffer = calloc(config.buffer_size, sizeof(Document));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !consumers || !producer_ids || !consumer_ids || !buffer || !latency)
+    {
+        printf("Falha ao alocar memória\n");
+        return 1;
+    }
+    buffer_mask = config.buffer_mask;
+    print_affinity_bind(buffer, config.buffer_size * sizeof(Document));
 
     // Inicializa sistema de semáforos
-    if (init_semaphores() != 0)
+    if (init_semaphores(config.buffer_size) != 0)
     {
         printf("Falha na inicialização dos semáforos\n");
         return 1;
     }
 
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: buffer de %zu posições, %d produtores, %d impressoras\n",
+               config.buffer_size, config.num_producers, config.num_consumers);
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        printf("Falha ao criar thread de log\n");
+        destroy_semaphores();
+        return 1;
+    }
+
+    if (print_stats_watch_start(PRINT_SEM_NAME, latency, config.num_consumers) != 0)
+    {
+        printf("Falha ao iniciar relatório de latências\n");
+        destroy_semaphores();
+        return 1;
+    }
+    print_stats_begin(&stats);
+
     // Cria threads produtoras
-    for (i = 0; i < NUM_PRODUCERS; i++)
+    print_trace_start();
+    for (i = 0; i < config.num_producers; i++)
     {
         producer_ids[i] = i + 1;
         if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
@@ -248,7 +698,7 @@ int main()
     }
 
     // Cria threads consumidoras
-    for (i = 0; i < NUM_CONSUMERS; i++)
+    for (i = 0; i < config.num_consumers; i++)
     {
         consumer_ids[i] = i + 1;
         if (pthread_create(&consumers[i], NULL, consumer, &consumer_ids[i]) != 0)
@@ -261,7 +711,7 @@ int main()
     }
 
     // Aguarda produtores finalizarem
-    for (i = 0; i < NUM_PRODUCERS; i++)
+    for (i = 0; i < config.num_producers; i++)
     {
         pthread_join(producers[i], NULL);
     }
@@ -269,21 +719,51 @@ int main()
     // Sinaliza finalização para consumidores
     should_stop = 1;
 
-    // Libera consumidores que possam estar bloqueados
-    for (i = 0; i < NUM_CONSUMERS; i++)
-    {
-        sem_post(&full);
-    }
+    // Libera os consumidores com um único sinal extra, consumido só depois dos
+    // documentos restantes; cada consumidor que o recebe o repassa ao seguinte
+    print_sem_post(&full);
 
     // Aguarda consumidores finalizarem
-    for (i = 0; i < NUM_CONSUMERS; i++)
+    for (i = 0; i < config.num_consumers; i++)
     {
         pthread_join(consumers[i], NULL);
     }
 
-    // Libera recursos
-    destroy_semaphores();
+    print_stats_end(&stats);
+    print_stats_watch_stop();
 
-    printf("Sistema finalizado com sucesso\n");
+    // Escreve as mensagens pendentes e libera recursos
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report(PRINT_SEM_NAME, &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, PRINT_SEM_NAME, latency, config.num_consumers);
+    }
+    if (config.submit_timeout >= 0 && !config.quiet)
+    {
+        printf("Documentos descartados por prazo de submissão: %lu\n", atomic_load(&docs_shed));
+    }
+    if (!config.quiet)
+    {
+        print_affinity_report(stdout);
+    }
+    destroy_semaphores();
+    print_affinity_cleanup();
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(buffer);
+    free(producers);
+    free(consumers);
+    free(producer_ids);
+    free(consumer_ids);
+
+    if (!config.quiet)
+    {
+        printf("Sistema finalizado com sucesso\n");
+    }
     return 0;
 }
\ No newline at end of file
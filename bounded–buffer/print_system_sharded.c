@@ -0,0 +1,667 @@
+/**
+ * Sistema de Fila de Impressão - Implementação Particionada (Sharded)
+ *
+ * Nas demais versões todos os produtores e impressoras disputam o mesmo buffer e o
+ * mesmo mutex, que se torna o ponto único de contenção quando o número de threads
+ * cresce. Esta versão divide a fila em K anéis independentes (shards), cada um com
+ * buffer circular, mutex e variável de condição próprios.
+ *
+ * Características Principais:
+ * - K configurável com --shards (padrão: um anel por processador)
+ * - Cada produtor insere sempre no mesmo anel, escolhido pelo seu ID
+ * - Cada impressora escolhe dois anéis ao acaso e remove do que tiver mais
+ *   documentos (power of two choices); se ambos estiverem vazios, varre os demais
+ * - A capacidade de --buffer-size vale para cada anel
+ *
+ * Espera das impressoras:
+ * Um contador global de documentos pendentes evita varrer os anéis à toa. Uma
+ * impressora que não encontra documentos dorme em uma variável de condição global;
+ * produtores só adquirem o mutex dessa variável quando há impressoras dormindo, de
+ * modo que, com a fila ocupada, cada inserção toca apenas o mutex do seu anel.
+ * Como o produtor incrementa os pendentes antes de verificar as impressoras dormindo
+ * e a impressora se registra antes de verificar os pendentes (ambos sequencialmente
+ * consistentes), nenhum dos dois pode deixar de ver o outro.
+ *
+ * Desligamento: o mesmo protocolo das demais versões. As impressoras drenam os anéis
+ * e encerram quando não há produtores ativos nem documentos pendentes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdatomic.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_trace.h"
+#include "print_affinity.h"
+#include "print_waitlist.h"
+
+/**
+ * Constantes de Configuração do Sistema
+ *
+ * Número de anéis, capacidade de cada anel, número de produtores e consumidores e
+ * documentos por produtor são definidos em tempo de execução (veja print_config.h).
+ */
+#define MAX_TYPE_LENGTH 20 // Tamanho máximo para o tipo do documento
+#define CACHE_LINE_SIZE 64 // Tamanho da linha de cache
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_SHARDS | PRINT_OPT_TRACE | PRINT_OPT_AFFINITY)
+
+/**
+ * Códigos de Erro do Sistema
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_MUTEX -1   // Falha na inicialização do mutex
+#define PRINT_ERR_COND -3    // Falha na inicialização da variável de condição
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_EMPTY -5   // Anéis vazios e sem produtores ativos
+#define PRINT_ERR_NOMEM -6   // Falha na alocação dos anéis
+
+/**
+ * Estrutura do Documento
+ */
+typedef struct
+{
+    int id;                     // Identificador único do documento
+    char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "PDF", "DOC")
+    int size;                   // Tamanho do documento em KB
+    int producer_id;            // ID da aplicação produtora
+    uint64_t enqueue_ns;        // Momento da inserção no anel (CLOCK_MONOTONIC)
+} Document;
+
+/**
+ * Anel da Fila Particionada
+ *
+ * Cada anel ocupa linhas de cache próprias. O número de documentos é atômico para
+ * que as impressoras comparem anéis sem adquirir seus mutexes; ele só é alterado com
+ * o mutex do anel adquirido.
+ */
+typedef struct
+{
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t mutex; // Exclusão mútua do anel
+    pthread_cond_t not_full;                         // Sinaliza espaço livre no anel
+    size_t in;                                       // Próxima posição de inserção
+    size_t out;                                      // Próxima posição de remoção
+    atomic_size_t count;                             // Documentos no anel
+    unsigned long removed;                           // Documentos removidos (protegido pelo mutex)
+    Document *buffer;                                // Buffer circular do anel
+} PrintShard;
+
+/**
+ * Estrutura da Fila de Impressão Particionada
+ */
+typedef struct
+{
+    // Anéis (somente leitura após a inicialização)
+    _Alignas(CACHE_LINE_SIZE) PrintShard *shards; // Vetor de anéis
+    int num_shards;                               // Número de anéis
+    size_t capacity;                              // Capacidade de cada anel (potência de dois)
+    size_t mask;                                  // capacity - 1, aplicada às posições
+
+    // Documentos inseridos e ainda não removidos, somados em todos os anéis
+    _Alignas(CACHE_LINE_SIZE) atomic_long pending;
+
+    // Impressoras sem documentos dormem aqui
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t idle_mutex; // Protege a espera das impressoras
+    PrintWaitList not_empty;                              // Impressoras dormindo, fechada no fim da produção
+    atomic_int idle_printers;                             // Impressoras dormindo ou prestes a dormir
+
+    // Estado do Sistema
+    _Alignas(CACHE_LINE_SIZE) atomic_int active_producers; // Número de threads produtoras ativas
+    atomic_int should_stop;                                // Flag para desligamento do sistema
+} PrintQueue;
+
+// Instância global da fila de impressão
+PrintQueue print_queue;
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências inserção → remoção registradas por cada consumidor
+PrintLatencyRecorder *latency;
+
+/**
+ * Inicializa a fila particionada
+ *
+ * @param num_shards Número de anéis
+ * @param capacity Capacidade de cada anel (potência de dois)
+ * @param num_producers Número de produtores
+ * @return PRINT_SUCCESS, PRINT_ERR_NOMEM, PRINT_ERR_MUTEX ou PRINT_ERR_COND
+ */
+int init_print_queue(int num_shards, size_t capacity, int num_producers)
+{
+    print_queue.shards = aligned_alloc(CACHE_LINE_SIZE, num_shards * sizeof(PrintShard));
+    if (print_queue.shards == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar %d anéis: %s\n", num_shards, strerror(errno));
+        return PRINT_ERR_NOMEM;
+    }
+    memset(print_queue.shards, 0, num_shards * sizeof(PrintShard));
+    print_queue.num_shards = num_shards;
+    print_queue.capacity = capacity;
+    print_queue.mask = capacity - 1;
+
+    for (int i = 0; i < num_shards; i++)
+    {
+        PrintShard *shard = &print_queue.shards[i];
+
+        shard->buffer = calloc(capacity, sizeof(Document));
+        if (shard->buffer == NULL)
+        {
+            fprintf(stderr, "Falha ao alocar anel de %zu posições: %s\n", capacity, strerror(errno));
+            return PRINT_ERR_NOMEM;
+        }
+        print_affinity_bind(shard->buffer, capacity * sizeof(Document));
+        if (pthread_mutex_init(&shard->mutex, NULL) != 0)
+        {
+            return PRINT_ERR_MUTEX;
+        }
+        if (pthread_cond_init(&shard->not_full, NULL) != 0)
+        {
+            return PRINT_ERR_COND;
+        }
+        atomic_init(&shard->count, 0);
+    }
+
+    if (pthread_mutex_init(&print_queue.idle_mutex, NULL) != 0)
+    {
+        return PRINT_ERR_MUTEX;
+    }
+    print_waitlist_init(&print_queue.not_empty);
+    atomic_init(&print_queue.pending, 0);
+    atomic_init(&print_queue.idle_printers, 0);
+    atomic_init(&print_queue.active_producers, num_producers);
+    atomic_init(&print_queue.should_stop, 0);
+
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Libera recursos da fila particionada
+ */
+void cleanup_print_queue(void)
+{
+    for (int i = 0; i < print_queue.num_shards; i++)
+    {
+        PrintShard *shard = &print_queue.shards[i];
+
+        pthread_mutex_destroy(&shard->mutex);
+        pthread_cond_destroy(&shard->not_full);
+        free(shard->buffer);
+    }
+    pthread_mutex_destroy(&print_queue.idle_mutex);
+    free(print_queue.shards);
+    print_queue.shards = NULL;
+}
+
+/**
+ * Acorda uma impressora, se houver alguma dormindo
+ *
+ * Chamada depois de incrementar os documentos pendentes.
+ */
+static void wake_printer(void)
+{
+    if (atomic_load(&print_queue.idle_printers) > 0)
+    {
+        pthread_mutex_lock(&print_queue.idle_mutex);
+        print_waitlist_wake(&print_queue.not_empty, 1);
+        pthread_mutex_unlock(&print_queue.idle_mutex);
+    }
+}
+
+/**
+ * Insere um documento no anel do produtor, aguardando enquanto ele estiver cheio
+ *
+ * @param shard_index Anel do produtor
+ * @param doc Documento a ser inserido
+ * @param pos Recebe a posição ocupada no anel
+ * @return PRINT_SUCCESS ou PRINT_ERR_STOPPED se o sistema estiver em desligamento
+ */
+int print_queue_insert(int shard_index, Document *doc, size_t *pos)
+{
+    PrintShard *shard = &print_queue.shards[shard_index];
+
+    pthread_mutex_lock(&shard->mutex);
+    while (atomic_load_explicit(&shard->count, memory_order_relaxed) == print_queue.capacity &&
+           !atomic_load(&print_queue.should_stop))
+    {
+        pthread_cond_wait(&shard->not_full, &shard->mutex);
+    }
+    if (atomic_load(&print_queue.should_stop))
+    {
+        pthread_mutex_unlock(&shard->mutex);
+        return PRINT_ERR_STOPPED;
+    }
+
+    *pos = shard->in;
+    doc->enqueue_ns = print_stats_now();
+    shard->buffer[*pos] = *doc;
+    shard->in = (shard->in + 1) & print_queue.mask;
+    atomic_store_explicit(&shard->count, atomic_load_explicit(&shard->count, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+    // Contado antes de liberar o anel: nenhuma impressora o remove antes disso
+    atomic_fetch_add(&print_queue.pending, 1);
+    pthread_mutex_unlock(&shard->mutex);
+
+    wake_printer();
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Tenta remover um documento de um anel, sem esperar
+ *
+ * @param shard_index Anel
+ * @param doc Recebe o documento removido
+ * @param pos Recebe a posição liberada no anel
+ * @return 1 se um documento foi removido, 0 se o anel estava vazio
+ */
+static int shard_try_remove(int shard_index, Document *doc, size_t *pos)
+{
+    PrintShard *shard = &print_queue.shards[shard_index];
+
+    // Anel vazio: evita adquirir o mutex
+    if (atomic_load_explicit(&shard->count, memory_order_relaxed) == 0)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&shard->mutex);
+    size_t count = atomic_load_explicit(&shard->count, memory_order_relaxed);
+    if (count == 0)
+    {
+        pthread_mutex_unlock(&shard->mutex);
+        return 0;
+    }
+
+    *pos = shard->out;
+    *doc = shard->buffer[*pos];
+    shard->out = (shard->out + 1) & print_queue.mask;
+    atomic_store_explicit(&shard->count, count - 1, memory_order_relaxed);
+    shard->removed++;
+    pthread_cond_signal(&shard->not_full);
+    pthread_mutex_unlock(&shard->mutex);
+
+    atomic_fetch_sub(&print_queue.pending, 1);
+    return 1;
+}
+
+/**
+ * Gerador pseudoaleatório xorshift32 de cada impressora
+ *
+ * @param state Estado do gerador (diferente de zero)
+ */
+static inline uint32_t next_random(uint32_t *state)
+{
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/**
+ * Tenta remover um documento de qualquer anel, sem esperar
+ *
+ * Sorteia dois anéis e tenta primeiro o que tiver mais documentos; se nenhum dos dois
+ * tiver documentos, varre todos os anéis a partir do primeiro sorteado.
+ *
+ * @param seed Estado do gerador da impressora
+ * @param doc Recebe o documento removido
+ * @param shard_index Recebe o anel de onde o documento foi removido
+ * @param pos Recebe a posição liberada no anel
+ * @return 1 se um documento foi removido, 0 se todos os anéis estavam vazios
+ */
+int print_queue_try_remove(uint32_t *seed, Document *doc, int *shard_index, size_t *pos)
+{
+    int k = print_queue.num_shards;
+    int a = next_random(seed) % k;
+    int b = next_random(seed) % k;
+
+    if (atomic_load_explicit(&print_queue.shards[b].count, memory_order_relaxed) >
+        atomic_load_explicit(&print_queue.shards[a].count, memory_order_relaxed))
+    {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    if (shard_try_remove(a, doc, pos))
+    {
+        *shard_index = a;
+        return 1;
+    }
+    if (b != a && shard_try_remove(b, doc, pos))
+    {
+        *shard_index = b;
+        return 1;
+    }
+
+    for (int i = 1; i < k; i++)
+    {
+        int s = (a + i) % k;
+        if (shard_try_remove(s, doc, pos))
+        {
+            *shard_index = s;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Aguarda documentos pendentes
+ *
+ * @return 1 se pode haver documentos, 0 se não há documentos pendentes nem
+ *         produtores ativos (ou o sistema está em desligamento)
+ */
+static int wait_documents(void)
+{
+    pthread_mutex_lock(&print_queue.idle_mutex);
+    atomic_fetch_add(&print_queue.idle_printers, 1);
+    while (atomic_load(&print_queue.pending) == 0 &&
+           atomic_load(&print_queue.active_producers) > 0 &&
+           !atomic_load(&print_queue.should_stop))
+    {
+        print_waitlist_wait(&print_queue.not_empty, &print_queue.idle_mutex, NULL);
+    }
+    atomic_fetch_sub(&print_queue.idle_printers, 1);
+    int more = atomic_load(&print_queue.pending) > 0 && !atomic_load(&print_queue.should_stop);
+    pthread_mutex_unlock(&print_queue.idle_mutex);
+
+    return more;
+}
+
+/**
+ * Remove um documento de algum anel, aguardando enquanto todos estiverem vazios
+ *
+ * @param seed Estado do gerador da impressora
+ * @param doc Recebe o documento removido
+ * @param shard_index Recebe o anel de onde o documento foi removido
+ * @param pos Recebe a posição liberada no anel
+ * @return PRINT_SUCCESS ou PRINT_ERR_EMPTY
+ */
+int print_queue_remove(uint32_t *seed, Document *doc, int *shard_index, size_t *pos)
+{
+    while (!print_queue_try_remove(seed, doc, shard_index, pos))
+    {
+        if (!wait_documents())
+        {
+            return PRINT_ERR_EMPTY;
+        }
+    }
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Função da Thread Produtora
+ *
+ * Simula uma aplicação enviando documentos para o seu anel da fila de impressão.
+ *
+ * @param arg Ponteiro para o ID do produtor (int)
+ * @return NULL
+ */
+void *producer(void *arg)
+{
+    int producer_id = *(int *)arg;
+    int shard_index = (producer_id - 1) % print_queue.num_shards;
+    int docs_produced = 0;
+    size_t pos;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+    print_affinity_pin(PRINT_AFFINITY_PRODUCER, producer_id - 1);
+
+    while (docs_produced < config.max_documents && !atomic_load(&print_queue.should_stop))
+    {
+        // Cria novo documento com propriedades simuladas
+        Document doc = {
+            .id = (producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
+            .producer_id = producer_id};
+        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        if (print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH) != 0)
+        {
+            break; // Fim do trace deste produtor
+        }
+
+        if (print_queue_insert(shard_index, &doc, &pos) != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        print_affinity_note(PRINT_AFFINITY_PRODUCER, producer_id - 1, 1);
+        print_log("[Produtor %d] Adicionou documento %d (%s, %dKB) no anel %d, posição %zu\n",
+                  producer_id, doc.id, doc.type, doc.size, shard_index, pos);
+
+        docs_produced++;
+        if (config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
+    }
+
+    // Remove registro do produtor; o último fecha a lista das impressoras, que
+    // acordam em cascata para verificar o fim
+    pthread_mutex_lock(&print_queue.idle_mutex);
+    if (atomic_fetch_sub(&print_queue.active_producers, 1) == 1)
+    {
+        print_waitlist_close(&print_queue.not_empty);
+    }
+    pthread_mutex_unlock(&print_queue.idle_mutex);
+
+    print_log("[Produtor %d] Finalizou a produção de documentos\n", producer_id);
+    return NULL;
+}
+
+/**
+ * Função da Thread Consumidora
+ *
+ * Simula uma impressora processando documentos dos anéis até que não haja
+ * mais produtores ativos nem documentos pendentes.
+ *
+ * @param arg Ponteiro para o ID do consumidor (int)
+ * @return NULL
+ */
+void *consumer(void *arg)
+{
+    int consumer_id = *(int *)arg;
+    uint32_t seed = 2654435761u * (uint32_t)consumer_id;
+    Document doc;
+    int shard_index;
+    size_t pos;
+
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, consumer_id - 1);
+    while (print_queue_remove(&seed, &doc, &shard_index, &pos) == PRINT_SUCCESS)
+    {
+        uint64_t timestamp = print_stats_now();
+        print_latency_record(&latency[consumer_id - 1], timestamp - doc.enqueue_ns);
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, consumer_id - 1, 1);
+        print_log("[Consumidor %d] Imprimindo documento %d (%s, %dKB) do anel %d, posição %zu\n",
+                  consumer_id, doc.id, doc.type, doc.size, shard_index, pos);
+
+        // Simula tempo de impressão proporcional ao tamanho do documento
+        if (config.simulate_delays)
+        {
+            usleep(doc.size * 10000);
+        }
+        print_service_record(&latency[consumer_id - 1], print_stats_now() - timestamp);
+    }
+
+    print_log("[Consumidor %d] Não há mais documentos para imprimir, encerrando\n", consumer_id);
+    return NULL;
+}
+
+/**
+ * Exibe quantos documentos saíram de cada anel
+ */
+void shard_report(void)
+{
+    unsigned long min = (unsigned long)-1;
+    unsigned long max = 0;
+
+    for (int i = 0; i < print_queue.num_shards; i++)
+    {
+        unsigned long removed = print_queue.shards[i].removed;
+        min = removed < min ? removed : min;
+        max = removed > max ? removed : max;
+    }
+    printf("Anéis: %d de %zu posições, documentos por anel: mín %lu, máx %lu\n",
+           print_queue.num_shards, print_queue.capacity, min, max);
+}
+
+/**
+ * Função Principal
+ *
+ * Inicializa o sistema, cria threads produtoras e consumidoras,
+ * aguarda conclusão e finaliza.
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
+ * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
+ */
+int main(int argc, char *argv[])
+{
+    pthread_t *producers;
+    pthread_t *consumers;
+    int *producer_ids;
+    int *consumer_ids;
+    PrintStats stats;
+    int num_shards;
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    num_shards = config.shards;
+    if (num_shards == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_shards = cpus < 1 ? 1 : cpus > PRINT_MAX_SHARDS ? PRINT_MAX_SHARDS : (int)cpus;
+    }
+
+    producers = calloc(config.num_producers, sizeof(pthread_t));
+    consumers = calloc(config.num_consumers, sizeof(pthread_t));
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    consumer_ids = calloc(config.num_consumers, sizeof(int));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !consumers || !producer_ids || !consumer_ids || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de threads\n");
+        return EXIT_FAILURE;
+    }
+
+    // Topologia e nó dos anéis, antes de alocá-los
+    if (print_affinity_init(&config, config.num_producers, config.num_consumers) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    if (init_print_queue(num_shards, config.buffer_size, config.num_producers) != PRINT_SUCCESS)
+    {
+        fprintf(stderr, "Falha ao inicializar a fila particionada\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: %d anéis de %zu posições, %d produtores, %d impressoras\n",
+               num_shards, config.buffer_size, config.num_producers, config.num_consumers);
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+
+    if (print_stats_watch_start("sharded", latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar relatório de latências\n");
+        return EXIT_FAILURE;
+    }
+    print_stats_begin(&stats);
+
+    // Cria threads produtoras
+    print_trace_start();
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        producer_ids[i] = i + 1;
+        if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread produtora %d: %s\n", i, strerror(errno));
+            atomic_store(&print_queue.should_stop, 1);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Cria threads consumidoras
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        consumer_ids[i] = i + 1;
+        if (pthread_create(&consumers[i], NULL, consumer, &consumer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread consumidora %d: %s\n", i, strerror(errno));
+            atomic_store(&print_queue.should_stop, 1);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Aguarda conclusão das threads
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        pthread_join(consumers[i], NULL);
+    }
+
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report("sharded", &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, "sharded", latency, config.num_consumers);
+        shard_report();
+        print_affinity_report(stdout);
+    }
+    print_affinity_cleanup();
+    cleanup_print_queue();
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(producers);
+    free(consumers);
+    free(producer_ids);
+    free(consumer_ids);
+    if (!config.quiet)
+    {
+        printf("Sistema de fila de impressão finalizado com sucesso\n");
+    }
+
+    return EXIT_SUCCESS;
+}
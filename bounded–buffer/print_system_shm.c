@@ -0,0 +1,659 @@
+/**
+ * Sistema de Fila de Impressão entre Processos (Memória Compartilhada)
+ *
+ * Nas demais versões, produtores e impressoras são threads de um mesmo processo. Aqui
+ * as aplicações são processos separados: o buffer circular e sua sincronização ficam
+ * em um segmento de memória compartilhada (shm_open + mmap), e um processo servidor
+ * de impressão (daemon) mantém as impressoras.
+ *
+ * Características Principais:
+ * - Buffer circular, índices e contadores dentro do segmento compartilhado
+ * - Mutex e variáveis de condição com PTHREAD_PROCESS_SHARED: sem disputa, inserir e
+ *   remover um documento não fazem chamada de sistema (futex apenas ao esperar)
+ * - Mutex robusto: se um produtor morrer com o mutex adquirido, o próximo processo
+ *   recupera o mutex (EOWNERDEAD) em vez de travar o sistema
+ * - Documentos copiados uma única vez, direto para o segmento (sem socket nem pipe)
+ *
+ * Papéis (primeiro argumento que não é opção):
+ *   daemon    Cria o segmento e executa as impressoras até receber SIGINT/SIGTERM;
+ *             então drena os documentos restantes e remove o segmento
+ *   producer  Abre o segmento de um daemon em execução e envia -d documentos
+ *   demo      (padrão) Cria o segmento, inicia -p processos produtores com fork e
+ *             executa -c impressoras até que todos terminem
+ *
+ * O nome do segmento é SHM_DEFAULT_NAME ou o valor de PRINT_SHM_NAME. O servidor
+ * não substitui um segmento existente, que pode ser de outro servidor em execução;
+ * o de um servidor que terminou sem removê-lo só é removido com PRINT_SHM_REPLACE=1.
+ *
+ * Compilação:
+ *   gcc -o print_system_shm print_system_shm.c -pthread -lrt -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+
+/**
+ * Constantes de Configuração do Sistema
+ *
+ * Capacidade do buffer, número de produtores (processos) e impressoras e documentos
+ * por produtor são definidos em tempo de execução (veja print_config.h).
+ */
+#define MAX_TYPE_LENGTH 20              // Tamanho máximo para o tipo do documento
+#define CACHE_LINE_SIZE 64              // Tamanho da linha de cache
+#define SHM_DEFAULT_NAME "/print_queue" // Nome padrão do segmento compartilhado
+#define SHM_MAGIC 0x50524e51u           // Marca de segmento inicializado ("PRNQ")
+#define SHM_VERSION 1                   // Versão do layout do segmento
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS 0 // Apenas as opções comuns
+
+/**
+ * Códigos de Erro do Sistema
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_MUTEX -1   // Falha na inicialização/operação do mutex
+#define PRINT_ERR_COND -3    // Falha na inicialização/operação da variável de condição
+#define PRINT_ERR_STOPPED -4 // Servidor em desligamento
+#define PRINT_ERR_NOMEM -6   // Falha ao criar ou mapear o segmento
+#define PRINT_ERR_NOQUEUE -7 // Segmento inexistente ou não inicializado
+
+/**
+ * Estrutura do Documento
+ *
+ * Copiada diretamente para o segmento; não pode conter ponteiros.
+ */
+typedef struct
+{
+    int id;                     // Identificador único do documento
+    char type[MAX_TYPE_LENGTH]; // Tipo do documento (ex: "PDF", "DOC")
+    int size;                   // Tamanho do documento em KB
+    int producer_id;            // ID (pid) do processo produtor
+    uint64_t enqueue_ns;        // Momento da inserção (CLOCK_MONOTONIC, comum aos processos)
+} Document;
+
+/**
+ * Fila de Impressão no Segmento Compartilhado
+ *
+ * Os documentos ficam logo após o cabeçalho (membro flexível). O campo magic é
+ * escrito por último na criação: um produtor só usa um segmento já inicializado.
+ */
+typedef struct
+{
+    // Identificação e parâmetros (somente leitura após a criação)
+    _Atomic uint32_t magic; // SHM_MAGIC quando inicializado
+    uint32_t version;       // SHM_VERSION
+    size_t capacity;        // Capacidade do buffer (potência de dois)
+    size_t mask;            // capacity - 1
+
+    // Sincronização (compartilhada entre processos)
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t mutex; // Mutex robusto do buffer
+    pthread_cond_t not_full;                         // Sinaliza espaço disponível
+    pthread_cond_t not_empty;                        // Sinaliza documento disponível
+
+    // Estado do buffer (protegido pelo mutex)
+    _Alignas(CACHE_LINE_SIZE) size_t in; // Índice para próxima inserção
+    size_t out;                          // Índice para próxima remoção
+    size_t count;                        // Documentos no buffer
+    int shutdown;                        // Servidor em desligamento: drena e encerra
+    unsigned long submitted;             // Documentos recebidos
+    unsigned long printed;               // Documentos impressos
+
+    _Alignas(CACHE_LINE_SIZE) Document slots[]; // Buffer circular
+} ShmPrintQueue;
+
+// Configuração desta execução
+PrintConfig config;
+
+// Fila mapeada neste processo
+ShmPrintQueue *queue;
+size_t queue_bytes;
+
+// Latências inserção → remoção registradas por cada impressora (servidor)
+PrintLatencyRecorder *latency;
+
+/**
+ * Nome do segmento compartilhado
+ */
+const char *shm_name(void)
+{
+    const char *name = getenv("PRINT_SHM_NAME");
+
+    return name != NULL ? name : SHM_DEFAULT_NAME;
+}
+
+/**
+ * Indica se um segmento existente deve ser removido antes de criar o novo
+ *
+ * Só o usuário sabe que o servidor dono do segmento não está mais em execução.
+ */
+int shm_replace(void)
+{
+    const char *replace = getenv("PRINT_SHM_REPLACE");
+
+    return replace != NULL && strcmp(replace, "1") == 0;
+}
+
+/**
+ * Adquire o mutex do segmento, recuperando-o se o dono anterior morreu
+ *
+ * Um processo que morre com o mutex adquirido deixa o estado do buffer coerente (as
+ * atualizações são feitas em poucas instruções), então basta marcar o mutex como
+ * consistente e continuar.
+ *
+ * @param q Fila compartilhada
+ */
+void shm_lock(ShmPrintQueue *q)
+{
+    if (pthread_mutex_lock(&q->mutex) == EOWNERDEAD)
+    {
+        pthread_mutex_consistent(&q->mutex);
+    }
+}
+
+/**
+ * Espera uma variável de condição do segmento, com a mesma recuperação de shm_lock
+ *
+ * @param q Fila compartilhada
+ * @param cond Variável de condição
+ */
+void shm_wait(ShmPrintQueue *q, pthread_cond_t *cond)
+{
+    if (pthread_cond_wait(cond, &q->mutex) == EOWNERDEAD)
+    {
+        pthread_mutex_consistent(&q->mutex);
+    }
+}
+
+/**
+ * Cria e inicializa o segmento compartilhado (servidor)
+ *
+ * Falha se já existir um segmento com o mesmo nome, a menos que PRINT_SHM_REPLACE=1
+ * peça a remoção de um segmento antigo (de um servidor que não encerrou).
+ *
+ * @param capacity Capacidade do buffer (potência de dois)
+ * @return PRINT_SUCCESS em caso de sucesso, código de erro em caso de falha
+ */
+int shm_create(size_t capacity)
+{
+    pthread_mutexattr_t mutex_attr;
+    pthread_condattr_t cond_attr;
+
+    if (shm_replace())
+    {
+        shm_unlink(shm_name());
+    }
+    int fd = shm_open(shm_name(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST)
+    {
+        fprintf(stderr,
+                "Segmento %s já existe: outro servidor está em execução? Se ele terminou sem removê-lo, "
+                "use PRINT_SHM_REPLACE=1\n",
+                shm_name());
+        return PRINT_ERR_NOMEM;
+    }
+    if (fd < 0)
+    {
+        fprintf(stderr, "Falha ao criar segmento %s: %s\n", shm_name(), strerror(errno));
+        return PRINT_ERR_NOMEM;
+    }
+
+    queue_bytes = sizeof(ShmPrintQueue) + capacity * sizeof(Document);
+    if (ftruncate(fd, (off_t)queue_bytes) != 0)
+    {
+        fprintf(stderr, "Falha ao dimensionar segmento: %s\n", strerror(errno));
+        close(fd);
+        shm_unlink(shm_name());
+        return PRINT_ERR_NOMEM;
+    }
+
+    queue = mmap(NULL, queue_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (queue == MAP_FAILED)
+    {
+        fprintf(stderr, "Falha ao mapear segmento: %s\n", strerror(errno));
+        shm_unlink(shm_name());
+        return PRINT_ERR_NOMEM;
+    }
+
+    // O segmento criado por ftruncate já vem zerado
+    queue->version = SHM_VERSION;
+    queue->capacity = capacity;
+    queue->mask = capacity - 1;
+
+    // Mutex robusto e compartilhado entre processos
+    if (pthread_mutexattr_init(&mutex_attr) != 0 ||
+        pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED) != 0 ||
+        pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST) != 0 ||
+        pthread_mutex_init(&queue->mutex, &mutex_attr) != 0)
+    {
+        fprintf(stderr, "Falha ao inicializar mutex compartilhado\n");
+        return PRINT_ERR_MUTEX;
+    }
+    pthread_mutexattr_destroy(&mutex_attr);
+
+    // Variáveis de condição compartilhadas entre processos
+    if (pthread_condattr_init(&cond_attr) != 0 ||
+        pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED) != 0 ||
+        pthread_cond_init(&queue->not_full, &cond_attr) != 0 ||
+        pthread_cond_init(&queue->not_empty, &cond_attr) != 0)
+    {
+        fprintf(stderr, "Falha ao inicializar variáveis de condição compartilhadas\n");
+        return PRINT_ERR_COND;
+    }
+    pthread_condattr_destroy(&cond_attr);
+
+    // Publica o segmento inicializado
+    atomic_store_explicit(&queue->magic, SHM_MAGIC, memory_order_release);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Abre o segmento de um servidor em execução (produtor)
+ *
+ * @return PRINT_SUCCESS em caso de sucesso, PRINT_ERR_NOQUEUE se não houver servidor
+ */
+int shm_attach(void)
+{
+    struct stat st;
+
+    int fd = shm_open(shm_name(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Segmento %s não encontrado (o servidor está em execução?): %s\n",
+                shm_name(), strerror(errno));
+        return PRINT_ERR_NOQUEUE;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ShmPrintQueue))
+    {
+        fprintf(stderr, "Segmento %s inválido\n", shm_name());
+        close(fd);
+        return PRINT_ERR_NOQUEUE;
+    }
+
+    queue_bytes = (size_t)st.st_size;
+    queue = mmap(NULL, queue_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (queue == MAP_FAILED)
+    {
+        fprintf(stderr, "Falha ao mapear segmento: %s\n", strerror(errno));
+        return PRINT_ERR_NOQUEUE;
+    }
+
+    if (atomic_load_explicit(&queue->magic, memory_order_acquire) != SHM_MAGIC ||
+        queue->version != SHM_VERSION ||
+        sizeof(ShmPrintQueue) + queue->capacity * sizeof(Document) > queue_bytes)
+    {
+        fprintf(stderr, "Segmento %s não inicializado ou de versão incompatível\n", shm_name());
+        munmap(queue, queue_bytes);
+        return PRINT_ERR_NOQUEUE;
+    }
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Desfaz o mapeamento do segmento e, no servidor, o remove
+ *
+ * @param owner 1 se este processo criou o segmento
+ */
+void shm_detach(int owner)
+{
+    if (owner)
+    {
+        pthread_mutex_destroy(&queue->mutex);
+        pthread_cond_destroy(&queue->not_full);
+        pthread_cond_destroy(&queue->not_empty);
+        shm_unlink(shm_name());
+    }
+    munmap(queue, queue_bytes);
+    queue = NULL;
+}
+
+/**
+ * Envia um documento ao servidor
+ *
+ * Bloqueia enquanto o buffer estiver cheio.
+ *
+ * @param doc Documento (recebe a marca de tempo de inserção)
+ * @param pos Recebe a posição ocupada
+ * @return PRINT_SUCCESS, ou PRINT_ERR_STOPPED se o servidor estiver encerrando
+ */
+int shm_submit(Document *doc, size_t *pos)
+{
+    shm_lock(queue);
+
+    while (queue->count == queue->capacity && !queue->shutdown)
+    {
+        shm_wait(queue, &queue->not_full);
+    }
+
+    if (queue->shutdown)
+    {
+        pthread_cond_signal(&queue->not_full); // Repassa o desligamento ao próximo produtor
+        pthread_mutex_unlock(&queue->mutex);
+        return PRINT_ERR_STOPPED;
+    }
+
+    *pos = queue->in;
+    doc->enqueue_ns = print_log_now();
+    queue->slots[*pos] = *doc;
+    queue->in = (queue->in + 1) & queue->mask;
+    queue->count++;
+    queue->submitted++;
+
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->mutex);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Processo produtor: envia config.max_documents documentos
+ *
+ * Os tamanhos e intervalos vêm do fluxo stream do gerador de carga; produtores
+ * iniciados separadamente usam o fluxo 0 e devem receber sementes (--seed) diferentes.
+ *
+ * @param stream Fluxo do gerador de carga (índice do produtor no modo demo)
+ * @return EXIT_SUCCESS ou EXIT_FAILURE
+ */
+int run_producer(int stream)
+{
+    int producer_id = (int)getpid();
+    int docs_produced = 0;
+    WorkloadRng rng;
+
+    workload_rng_init(&rng, config.seed, (uint64_t)stream);
+    while (docs_produced < config.max_documents)
+    {
+        Document doc = {
+            .id = docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
+            .producer_id = producer_id};
+        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+
+        size_t pos;
+        if (shm_submit(&doc, &pos) != PRINT_SUCCESS)
+        {
+            print_log("[Produtor %d] Servidor encerrando, documentos restantes descartados\n", producer_id);
+            break;
+        }
+
+        print_log_at(doc.enqueue_ns, "[Produtor %d] Adicionou documento %d (%s, %dKB) na posição %zu\n",
+                     producer_id, doc.id, doc.type, doc.size, pos);
+
+        docs_produced++;
+        if (config.simulate_delays)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
+    }
+
+    print_log("[Produtor %d] Finalizou após enviar %d documentos\n", producer_id, docs_produced);
+    return docs_produced == config.max_documents ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * Thread impressora do servidor
+ *
+ * Imprime documentos até o desligamento, drenando o buffer antes de encerrar.
+ *
+ * @param arg Ponteiro para o ID da impressora (int)
+ * @return NULL
+ */
+void *printer(void *arg)
+{
+    int printer_id = *(int *)arg;
+    int docs_printed = 0;
+
+    for (;;)
+    {
+        shm_lock(queue);
+
+        while (queue->count == 0 && !queue->shutdown)
+        {
+            shm_wait(queue, &queue->not_empty);
+        }
+
+        if (queue->count == 0)
+        {
+            pthread_cond_signal(&queue->not_empty); // Repassa o desligamento à próxima impressora
+            pthread_mutex_unlock(&queue->mutex);
+            break;
+        }
+
+        size_t pos = queue->out;
+        uint64_t timestamp = print_log_now();
+        Document doc = queue->slots[pos];
+        queue->out = (queue->out + 1) & queue->mask;
+        queue->count--;
+        queue->printed++;
+
+        pthread_cond_signal(&queue->not_full);
+        pthread_mutex_unlock(&queue->mutex);
+
+        print_latency_record(&latency[printer_id - 1], timestamp - doc.enqueue_ns);
+        print_log_at(timestamp, "[Impressora %d] Imprimindo documento %d do processo %d (%s, %dKB) da posição %zu\n",
+                     printer_id, doc.id, doc.producer_id, doc.type, doc.size, pos);
+        docs_printed++;
+
+        // Simula tempo de impressão proporcional ao tamanho do documento
+        if (config.simulate_delays)
+        {
+            usleep(doc.size * 10000);
+        }
+        print_service_record(&latency[printer_id - 1], print_log_now() - timestamp);
+    }
+
+    print_log("[Impressora %d] Finalizou após imprimir %d documentos\n", printer_id, docs_printed);
+    return NULL;
+}
+
+/**
+ * Sinaliza o desligamento às impressoras e aos produtores bloqueados
+ *
+ * Acorda uma única impressora e um único produtor; cada um repassa o sinal ao
+ * seguinte ao encerrar (cascata), sem acordar todos de uma vez. As variáveis de
+ * condição ficam no segmento compartilhado, por isso não há lista por thread.
+ */
+void shm_shutdown(void)
+{
+    shm_lock(queue);
+    queue->shutdown = 1;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+/**
+ * Servidor de impressão
+ *
+ * Cria o segmento, executa as impressoras e aguarda o fim da produção: no modo
+ * demonstração, o término dos processos produtores criados com fork; no modo
+ * daemon, SIGINT ou SIGTERM.
+ *
+ * @param demo 1 para o modo demonstração
+ * @return EXIT_SUCCESS ou EXIT_FAILURE
+ */
+int run_server(int demo)
+{
+    pthread_t *printers = calloc(config.num_consumers, sizeof(pthread_t));
+    int *printer_ids = calloc(config.num_consumers, sizeof(int));
+    pid_t *children = calloc(config.num_producers, sizeof(pid_t));
+    PrintStats stats;
+    sigset_t signals;
+    int failed = 0;
+
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!printers || !printer_ids || !children || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de impressoras\n");
+        return EXIT_FAILURE;
+    }
+    if (shm_create(config.buffer_size) != PRINT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (!config.quiet)
+    {
+        printf("Servidor de impressão: segmento %s, buffer de %zu posições, %d impressoras\n",
+               shm_name(), config.buffer_size, config.num_consumers);
+    }
+    fflush(stdout);
+
+    print_stats_begin(&stats);
+
+    // Processos produtores (antes de criar threads neste processo)
+    for (int i = 0; demo && i < config.num_producers; i++)
+    {
+        children[i] = fork();
+        if (children[i] == 0)
+        {
+            print_log_mute(config.quiet);
+            print_log_start();
+            int ret = run_producer(i + 1);
+            print_log_stop();
+            _exit(ret);
+        }
+        if (children[i] < 0)
+        {
+            fprintf(stderr, "Falha ao criar processo produtor %d: %s\n", i + 1, strerror(errno));
+            failed = 1;
+            break;
+        }
+    }
+
+    // Sinais de desligamento são tratados por sigwait na thread principal
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0 || print_stats_watch_start("shm", latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log ou de relatório\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        printer_ids[i] = i + 1;
+        if (pthread_create(&printers[i], NULL, printer, &printer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar impressora %d: %s\n", i + 1, strerror(errno));
+            shm_shutdown();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (demo)
+    {
+        for (int i = 0; i < config.num_producers && children[i] > 0; i++)
+        {
+            int status;
+
+            waitpid(children[i], &status, 0);
+            failed |= !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS;
+        }
+    }
+    else
+    {
+        int sig;
+
+        print_log("[Servidor] Aguardando documentos; SIGINT ou SIGTERM encerra\n");
+        sigwait(&signals, &sig);
+        print_log("[Servidor] Sinal %d recebido, drenando a fila\n", sig);
+    }
+
+    shm_shutdown();
+    for (int i = 0; i < config.num_consumers; i++)
+    {
+        pthread_join(printers[i], NULL);
+    }
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+
+    print_log_stop();
+    if (!config.quiet)
+    {
+        printf("Documentos recebidos: %lu, impressos: %lu\n", queue->submitted, queue->printed);
+    }
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report("shm", &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, "shm", latency, config.num_consumers);
+    }
+
+    shm_detach(1);
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(printers);
+    free(printer_ids);
+    free(children);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * Função Principal
+ *
+ * @param argc Número de argumentos
+ * @param argv Opções (veja print_config.h) e papel: daemon, producer ou demo
+ * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
+ */
+int main(int argc, char *argv[])
+{
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const char *role = optind < argc ? argv[optind] : "demo";
+    if (strcmp(role, "daemon") == 0)
+    {
+        return run_server(0);
+    }
+    if (strcmp(role, "demo") == 0)
+    {
+        return run_server(1);
+    }
+    if (strcmp(role, "producer") != 0)
+    {
+        fprintf(stderr, "Papel inválido: '%s' (esperado daemon, producer ou demo)\n", role);
+        return EXIT_FAILURE;
+    }
+
+    if (shm_attach() != PRINT_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+    ret = run_producer(0);
+    print_log_stop();
+    shm_detach(0);
+    return ret;
+}
@@ -0,0 +1,1392 @@
+/**
+ * Sistema de Fila de Impressão com Despacho por Impressora e Roubo de Trabalho
+ *
+ * Variante de print_system_mutex.c em que o buffer único compartilhado por todas as
+ * impressoras é substituído por uma fila por impressora. Cada fila é uma fila dupla
+ * (deque) protegida por um mutex próprio e alinhada à linha de cache. Os produtores
+ * escolhem a fila de destino em rodízio (--dispatch rr, padrão) ou pelo hash do seu
+ * ID (--dispatch hash); cada impressora consome a própria fila pela cabeça (ordem de
+ * chegada) e, quando ela esvazia, rouba o documento mais recente da cauda de outra
+ * impressora.
+ *
+ * Assim cada impressora toca quase sempre apenas a própria fila, e o mutex e o
+ * índice de remoção deixam de ser disputados por todas as impressoras.
+ *
+ * Espera:
+ * - O total de documentos pendentes é um contador atômico. Impressoras sem trabalho
+ *   e produtores sem espaço esperam em listas de espera globais, e quem publica ou
+ *   remove um documento só adquire o mutex global se houver alguém esperando
+ *
+ * Laço de Eventos (--event-loop):
+ * - Cada fila tem um eventfd, escrito pelo produtor que a encontra vazia; uma única
+ *   thread com epoll atende todas as filas e as esvazia em lotes de --batch
+ *   documentos, sem uma thread bloqueada por impressora
+ * - O laço lê o eventfd antes de esvaziar a fila, de modo que uma inserção posterior
+ *   à última remoção sempre gera uma nova notificação
+ * - O último produtor escreve um eventfd adicional, que avisa o laço do fim da produção
+ *
+ * Conteúdo dos Documentos:
+ * - O conteúdo de cada documento é escrito em um bloco de um pool pré-alocado
+ *   (print_slab.h); as filas transportam apenas o identificador do bloco
+ *
+ * Saída em Spool (--spool DIR):
+ * - Cada impressora grava o conteúdo dos documentos no seu arquivo de spool por um
+ *   anel io_uring (print_spool.h); com --event-loop, os anéis também são atendidos
+ *   pelo epoll
+ *
+ * Espera Limitada (--submit-timeout-ms):
+ * - Com todas as filas cheias até o prazo, o produtor descarta o documento
+ *
+ * Diário Durável (--journal ARQUIVO):
+ * - Submissões e impressões são gravadas no diário (print_journal.h) com commit em
+ *   grupo; os trabalhos não impressos na execução anterior são reenviados às filas
+ *
+ * Mensagens:
+ * - Nenhuma mensagem é impressa com o mutex de uma fila adquirido; são registradas no
+ *   log assíncrono (print_log.h)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "print_config.h"
+#include "print_log.h"
+#include "print_stats.h"
+#include "print_slab.h"
+#include "print_journal.h"
+#include "print_deadline.h"
+#include "print_spool.h"
+#include "print_trace.h"
+#include "print_affinity.h"
+#include "print_waitlist.h"
+
+/**
+ * Constantes de Configuração do Sistema
+ *
+ * Capacidade de cada fila, número de produtores e impressoras e documentos por
+ * produtor são definidos em tempo de execução (veja print_config.h).
+ */
+#define MAX_TYPE_LENGTH 20                // Tamanho máximo para o tipo do documento
+#define CACHE_LINE_SIZE 64                // Tamanho da linha de cache
+#define STEAL_HASH_MULTIPLIER 2654435761u // Constante do hash multiplicativo de Knuth
+
+/**
+ * Opções específicas aceitas por este programa (print_config.h)
+ */
+#define PROGRAM_OPTIONS (PRINT_OPT_BATCH | PRINT_OPT_DISPATCH | PRINT_OPT_PAYLOAD | PRINT_OPT_JOURNAL | PRINT_OPT_SUBMIT_TIMEOUT | \
+                         PRINT_OPT_EVENT_LOOP | PRINT_OPT_SPOOL | PRINT_OPT_TRACE | PRINT_OPT_AFFINITY)
+
+/**
+ * Códigos de Erro do Sistema
+ *
+ * Estes códigos são retornados por várias funções do sistema para indicar
+ * sucesso ou condições específicas de falha.
+ */
+#define PRINT_SUCCESS 0      // Operação concluída com sucesso
+#define PRINT_ERR_MUTEX -1   // Falha na inicialização/operação do mutex
+#define PRINT_ERR_COND -3    // Falha na criação de um eventfd
+#define PRINT_ERR_STOPPED -4 // Sistema em desligamento
+#define PRINT_ERR_NOMEM -6   // Falha na alocação das filas
+#define PRINT_ERR_JOURNAL -7 // Falha na gravação do diário
+#define PRINT_ERR_TIMEOUT -8 // Prazo vencido com todas as filas cheias
+
+/**
+ * Estrutura do Documento
+ *
+ * Representa um trabalho de impressão no sistema. Cada documento contém
+ * metadados sobre o trabalho de impressão e sua origem.
+ */
+typedef struct
+{
+    _Alignas(CACHE_LINE_SIZE) int id; // Identificador único do documento
+    char type[MAX_TYPE_LENGTH];       // Tipo do documento (ex: "PDF", "DOC")
+    int size;                         // Tamanho do documento em KB
+    int producer_id;                  // ID da aplicação produtora
+    uint64_t enqueue_ns;              // Momento da inserção no buffer (CLOCK_MONOTONIC)
+    PrintSlabHandle payload;          // Bloco do pool com o conteúdo do documento
+    uint64_t job;                     // Número do trabalho no diário (0 = sem diário)
+} Document;
+
+/**
+ * Cabeçalho gravado no início do bloco de conteúdo de cada documento
+ */
+typedef struct
+{
+    int doc_id;    // Documento dono do bloco (conferido pela impressora)
+    size_t length; // Bytes de conteúdo após o cabeçalho
+} PayloadHeader;
+
+/**
+ * Fila de uma impressora
+ *
+ * Buffer circular em que a dona remove pela cabeça e os ladrões pela cauda.
+ */
+typedef struct
+{
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t mutex; // Protege a fila
+    Document *buffer;                                // Buffer circular da fila
+    size_t head;                                     // Próximo documento da dona
+    size_t tail;                                     // Próxima posição de inserção
+    unsigned long stolen;                            // Documentos roubados desta fila
+    int event_fd;                                    // Notifica fila não vazia (-1 sem laço de eventos)
+} PrinterDeque;
+
+/**
+ * Estado do despacho por impressora
+ */
+typedef struct
+{
+    PrinterDeque *deques;       // Uma fila por impressora
+    int num_deques;             // Número de filas
+    size_t capacity;            // Capacidade de cada fila (potência de dois)
+    size_t mask;                // capacity - 1
+
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t pending; // Documentos em todas as filas
+    atomic_int idle_printers;                        // Impressoras esperando trabalho
+    atomic_int waiting_producers;                    // Produtores esperando espaço
+    atomic_int active_producers;                     // Produtores ainda em execução
+
+    pthread_mutex_t wait_mutex;  // Protege as esperas abaixo
+    PrintWaitList has_work;      // Impressoras ociosas, fechada no fim da produção
+    PrintWaitList has_space;     // Produtores esperando remoções
+    int done_fd;                 // Notifica o fim da produção ao laço de eventos (-1 sem laço)
+    atomic_int should_stop;      // Flag para desligamento do sistema
+} StealDispatch;
+
+// Instância global do despacho por impressora
+StealDispatch dispatch;
+
+// Configuração desta execução
+PrintConfig config;
+
+// Latências inserção → remoção registradas por cada impressora
+PrintLatencyRecorder *latency;
+
+// Documentos descartados porque o prazo de submissão venceu (--submit-timeout-ms)
+atomic_ulong docs_shed;
+
+// Trabalhos do diário ainda não impressos na execução anterior
+PrintJournalRecord *recovered_jobs;
+size_t num_recovered_jobs;
+
+/**
+ * Saída de uma impressora em spool (--spool)
+ */
+typedef struct
+{
+    PrintSpool spool;                  // Arquivo de spool e anel io_uring
+    Document docs[PRINT_SPOOL_DEPTH];  // Documentos com gravação em andamento, por slot
+    uint64_t started[PRINT_SPOOL_DEPTH]; // Início da impressão de cada documento
+    int printer;                       // Índice da impressora
+} PrinterOutput;
+
+// Saídas das impressoras (NULL = impressão simulada)
+PrinterOutput *outputs;
+
+/**
+ * Aloca um buffer de documentos zerado e alinhado à linha de cache, no nó do buffer
+ *
+ * @param capacity Número de documentos
+ * @return Buffer alocado ou NULL em caso de falha
+ */
+Document *alloc_documents(size_t capacity)
+{
+    size_t bytes = capacity * sizeof(Document);
+
+    // aligned_alloc exige tamanho múltiplo do alinhamento
+    bytes = (bytes + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    Document *buffer = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    if (buffer != NULL)
+    {
+        memset(buffer, 0, bytes);
+        print_affinity_bind(buffer, bytes);
+    }
+    return buffer;
+}
+
+/**
+ * Gera o conteúdo de um documento em um bloco do pool
+ *
+ * Simula a aplicação renderizando o trabalho: grava o cabeçalho e preenche até
+ * doc->size KB (limitado ao tamanho do bloco). Se o pool estiver momentaneamente
+ * esgotado, cede a CPU até que uma impressora devolva um bloco.
+ *
+ * @param doc Documento (recebe o identificador do bloco)
+ * @return PRINT_SUCCESS, ou PRINT_ERR_STOPPED em desligamento
+ */
+int render_document(Document *doc)
+{
+    while ((doc->payload = print_slab_alloc()) == PRINT_SLAB_NONE)
+    {
+        if (atomic_load(&dispatch.should_stop))
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        sched_yield();
+    }
+
+    PayloadHeader *header = print_slab_ptr(doc->payload);
+    size_t length = (size_t)doc->size * 1024;
+    if (length > print_slab.block_size - sizeof(PayloadHeader))
+    {
+        length = print_slab.block_size - sizeof(PayloadHeader);
+    }
+    header->doc_id = doc->id;
+    header->length = length;
+    memset(header + 1, doc->id & 0xff, length);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Lê o conteúdo de um documento e devolve o bloco ao pool
+ *
+ * @param consumer_id ID da impressora
+ * @param doc Documento impresso
+ */
+void release_document(int consumer_id, const Document *doc)
+{
+    const PayloadHeader *header = print_slab_ptr(doc->payload);
+
+    if (header->doc_id != doc->id)
+    {
+        print_log("[Consumidor %d] Conteúdo do documento %d não confere (bloco %u)\n",
+                  consumer_id, doc->id, doc->payload);
+    }
+    print_slab_free(doc->payload);
+}
+
+/**
+ * Registra a submissão de um documento no diário e espera a gravação
+ *
+ * O documento só é aceito na fila depois que a submissão é durável.
+ *
+ * @param doc Documento (recebe o número do trabalho)
+ * @return PRINT_SUCCESS, ou PRINT_ERR_JOURNAL se o diário falhou
+ */
+int journal_submit(Document *doc)
+{
+    if (config.journal == NULL)
+    {
+        return PRINT_SUCCESS;
+    }
+
+    PrintJournalRecord rec = {
+        .kind = PRINT_JOURNAL_SUBMIT,
+        .job = print_journal_next_job(),
+        .doc_id = doc->id,
+        .size = doc->size,
+        .producer_id = doc->producer_id};
+    memcpy(rec.type, doc->type, sizeof(rec.type));
+
+    uint64_t lsn = print_journal_append(&rec);
+    if (lsn == 0 || print_journal_wait(lsn) != 0)
+    {
+        return PRINT_ERR_JOURNAL;
+    }
+    doc->job = rec.job;
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Registra no diário a conclusão da impressão de um documento
+ *
+ * Não espera a gravação: se o registro se perder, o documento é apenas reimpresso
+ * na próxima execução.
+ *
+ * @param doc Documento impresso
+ */
+void journal_complete(const Document *doc)
+{
+    if (doc->job == 0)
+    {
+        return;
+    }
+
+    PrintJournalRecord rec = {
+        .kind = PRINT_JOURNAL_DONE,
+        .job = doc->job,
+        .doc_id = doc->id,
+        .size = doc->size,
+        .producer_id = doc->producer_id};
+    memcpy(rec.type, doc->type, sizeof(rec.type));
+    print_journal_append(&rec);
+}
+
+/**
+ * Conclusão da gravação de um documento no spool
+ *
+ * Registra o tempo de serviço, devolve o bloco ao pool e, se o documento foi gravado
+ * por inteiro, registra a impressão no diário: só agora o conteúdo saiu da memória.
+ * Uma gravação que falhou não é registrada, e o documento é reimpresso na
+ * recuperação do diário.
+ *
+ * @param ctx Saída da impressora
+ * @param slot Slot da gravação
+ * @param result Tamanho da gravação, ou -errno
+ */
+void output_done(void *ctx, int slot, int result)
+{
+    PrinterOutput *out = ctx;
+    Document *doc = &out->docs[slot];
+    const PayloadHeader *header = print_slab_ptr(doc->payload);
+    int written = result == (int)(sizeof(PayloadHeader) + header->length);
+
+    if (!written)
+    {
+        print_log("[Consumidor %d] Falha ao gravar documento %d no spool: %s\n", out->printer + 1, doc->id,
+                  strerror(result < 0 ? -result : EIO));
+    }
+    print_service_record(&latency[out->printer], print_log_now() - out->started[slot]);
+    release_document(out->printer + 1, doc);
+    if (written)
+    {
+        journal_complete(doc);
+    }
+}
+
+/**
+ * Imprime um documento retirado da fila
+ *
+ * Com --spool, envia o conteúdo ao spool da impressora e retorna sem esperar a
+ * gravação (concluída em output_done). Sem spool, simula o tempo de impressão.
+ *
+ * @param printer Índice da impressora
+ * @param doc Documento
+ * @param started Momento da retirada da fila
+ */
+void print_document(int printer, const Document *doc, uint64_t started)
+{
+    if (outputs != NULL)
+    {
+        PrinterOutput *out = &outputs[printer];
+        int slot = print_spool_slot(&out->spool, output_done, out);
+        const PayloadHeader *header = print_slab_ptr(doc->payload);
+
+        out->docs[slot] = *doc;
+        out->started[slot] = started;
+        print_spool_write(&out->spool, slot, header, sizeof(PayloadHeader) + header->length, output_done, out);
+        return;
+    }
+
+    release_document(printer + 1, doc);
+
+    // Simula tempo de impressão proporcional ao tamanho do documento
+    if (config.simulate_delays)
+    {
+        usleep(doc->size * 10000);
+    }
+    print_service_record(&latency[printer], print_log_now() - started);
+    journal_complete(doc);
+}
+
+/**
+ * Envia as gravações acumuladas de uma impressora antes de ela esperar por documentos
+ *
+ * @param printer Índice da impressora
+ */
+void printer_idle(int printer)
+{
+    if (outputs != NULL)
+    {
+        print_spool_flush(&outputs[printer].spool, output_done, &outputs[printer]);
+    }
+}
+
+/**
+ * Espera todas as gravações de uma impressora
+ *
+ * @param printer Índice da impressora
+ */
+void printer_finish(int printer)
+{
+    if (outputs != NULL)
+    {
+        print_spool_drain(&outputs[printer].spool, output_done, &outputs[printer]);
+    }
+}
+
+/**
+ * Abre os arquivos de spool das impressoras
+ *
+ * Deve ser chamada depois de print_slab_init: a área do pool é registrada no anel.
+ *
+ * @param dir Diretório dos arquivos
+ * @param num_printers Número de impressoras
+ * @return PRINT_SUCCESS, PRINT_ERR_NOMEM ou PRINT_ERR_STOPPED se um arquivo não puder ser criado
+ */
+int open_outputs(const char *dir, int num_printers)
+{
+    outputs = calloc(num_printers, sizeof(PrinterOutput));
+    if (outputs == NULL)
+    {
+        return PRINT_ERR_NOMEM;
+    }
+
+    for (int i = 0; i < num_printers; i++)
+    {
+        char path[4096];
+
+        snprintf(path, sizeof(path), "%s/impressora-%d.spool", dir, i + 1);
+        outputs[i].printer = i;
+        if (print_spool_open(&outputs[i].spool, path, print_slab.arena,
+                             (size_t)print_slab.num_blocks * print_slab.block_size) != 0)
+        {
+            return PRINT_ERR_STOPPED;
+        }
+    }
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Fecha os arquivos de spool e exibe as gravações de cada impressora
+ *
+ * @param num_printers Número de impressoras
+ */
+void close_outputs(int num_printers)
+{
+    for (int i = 0; i < num_printers; i++)
+    {
+        PrintSpool *sp = &outputs[i].spool;
+
+        if (!config.quiet)
+        {
+            printf("Spool da impressora %d: %lu gravações, %lu chamadas io_uring_enter (%s)\n",
+                   i + 1, sp->writes, sp->enters, print_spool_mode(sp));
+        }
+        print_spool_close(sp);
+    }
+    free(outputs);
+    outputs = NULL;
+}
+
+/**
+ * Inicializa as filas por impressora
+ *
+ * @param capacity Capacidade de cada fila (potência de dois)
+ * @param num_printers Número de impressoras
+ * @param num_producers Número de produtores
+ * @param event_loop Cria os eventfds do laço de eventos
+ * @return PRINT_SUCCESS em caso de sucesso, código de erro em caso de falha
+ */
+int init_steal_dispatch(size_t capacity, int num_printers, int num_producers, int event_loop)
+{
+    dispatch.deques = aligned_alloc(CACHE_LINE_SIZE, num_printers * sizeof(PrinterDeque));
+    if (dispatch.deques == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar filas das impressoras: %s\n", strerror(errno));
+        return PRINT_ERR_NOMEM;
+    }
+    memset(dispatch.deques, 0, num_printers * sizeof(PrinterDeque));
+    dispatch.num_deques = num_printers;
+    dispatch.capacity = capacity;
+    dispatch.mask = capacity - 1;
+
+    for (int i = 0; i < num_printers; i++)
+    {
+        PrinterDeque *d = &dispatch.deques[i];
+
+        d->buffer = alloc_documents(capacity);
+        if (d->buffer == NULL || pthread_mutex_init(&d->mutex, NULL) != 0)
+        {
+            fprintf(stderr, "Falha ao inicializar fila da impressora %d\n", i + 1);
+            return d->buffer == NULL ? PRINT_ERR_NOMEM : PRINT_ERR_MUTEX;
+        }
+        d->event_fd = event_loop ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1;
+        if (event_loop && d->event_fd < 0)
+        {
+            fprintf(stderr, "Falha ao criar eventfd da impressora %d: %s\n", i + 1, strerror(errno));
+            return PRINT_ERR_COND;
+        }
+    }
+
+    dispatch.done_fd = event_loop ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1;
+    if (event_loop && dispatch.done_fd < 0)
+    {
+        fprintf(stderr, "Falha ao criar eventfd de fim da produção: %s\n", strerror(errno));
+        return PRINT_ERR_COND;
+    }
+
+    atomic_init(&dispatch.pending, 0);
+    atomic_init(&dispatch.idle_printers, 0);
+    atomic_init(&dispatch.waiting_producers, 0);
+    atomic_init(&dispatch.active_producers, num_producers);
+    atomic_init(&dispatch.should_stop, 0);
+
+    if (pthread_mutex_init(&dispatch.wait_mutex, NULL) != 0)
+    {
+        return PRINT_ERR_MUTEX;
+    }
+    print_waitlist_init(&dispatch.has_work);
+    print_waitlist_init(&dispatch.has_space);
+    return PRINT_SUCCESS;
+}
+
+/**
+ * Libera as filas por impressora
+ */
+void cleanup_steal_dispatch(void)
+{
+    for (int i = 0; i < dispatch.num_deques; i++)
+    {
+        pthread_mutex_destroy(&dispatch.deques[i].mutex);
+        free(dispatch.deques[i].buffer);
+        if (dispatch.deques[i].event_fd >= 0)
+        {
+            close(dispatch.deques[i].event_fd);
+        }
+    }
+    if (dispatch.done_fd >= 0)
+    {
+        close(dispatch.done_fd);
+    }
+    pthread_mutex_destroy(&dispatch.wait_mutex);
+    free(dispatch.deques);
+    dispatch.deques = NULL;
+}
+
+/**
+ * Escreve em um eventfd, acordando o laço de eventos
+ *
+ * Um contador já diferente de zero apenas acumula; a escrita nunca bloqueia.
+ *
+ * @param fd eventfd a notificar
+ */
+static void event_notify(int fd)
+{
+    if (eventfd_write(fd, 1) != 0 && errno != EAGAIN)
+    {
+        print_log("[Laço de eventos] Falha ao notificar eventfd %d: %s\n", fd, strerror(errno));
+    }
+}
+
+/**
+ * Insere um documento na cauda de uma fila, se houver espaço
+ *
+ * Com o laço de eventos, a inserção em uma fila vazia escreve no eventfd da fila.
+ *
+ * @param d Fila de destino
+ * @param doc Documento (recebe a marca de tempo de inserção)
+ * @param pos Recebe a posição ocupada
+ * @return 1 se o documento foi inserido, 0 se a fila estava cheia
+ */
+int deque_push(PrinterDeque *d, Document *doc, size_t *pos)
+{
+    pthread_mutex_lock(&d->mutex);
+    if (d->tail - d->head == dispatch.capacity)
+    {
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
+    }
+
+    int was_empty = d->head == d->tail;
+    *pos = d->tail & dispatch.mask;
+    doc->enqueue_ns = print_log_now();
+    d->buffer[*pos] = *doc;
+    d->tail++;
+    pthread_mutex_unlock(&d->mutex);
+
+    if (was_empty && d->event_fd >= 0)
+    {
+        event_notify(d->event_fd);
+    }
+    return 1;
+}
+
+/**
+ * Remove o documento mais antigo da própria fila (cabeça)
+ *
+ * @param d Fila da impressora
+ * @param doc Recebe o documento
+ * @param pos Recebe a posição liberada
+ * @return 1 se um documento foi removido, 0 se a fila estava vazia
+ */
+int deque_pop(PrinterDeque *d, Document *doc, size_t *pos)
+{
+    pthread_mutex_lock(&d->mutex);
+    if (d->head == d->tail)
+    {
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
+    }
+
+    *pos = d->head & dispatch.mask;
+    *doc = d->buffer[*pos];
+    d->head++;
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
+
+/**
+ * Remove da cabeça de uma fila até max documentos em uma única seção crítica
+ *
+ * @param d Fila da impressora
+ * @param out Recebe os documentos
+ * @param max Número máximo de documentos
+ * @return Número de documentos removidos (0 se a fila estava vazia)
+ */
+int deque_pop_batch(PrinterDeque *d, Document *out, int max)
+{
+    int n = 0;
+
+    pthread_mutex_lock(&d->mutex);
+    while (n < max && d->head != d->tail)
+    {
+        out[n++] = d->buffer[d->head & dispatch.mask];
+        d->head++;
+    }
+    pthread_mutex_unlock(&d->mutex);
+    return n;
+}
+
+/**
+ * Rouba o documento mais recente de outra fila (cauda)
+ *
+ * Usa trylock para não esperar por uma fila disputada: outra vítima pode ser tentada.
+ *
+ * @param d Fila vítima
+ * @param doc Recebe o documento
+ * @param pos Recebe a posição liberada
+ * @return 1 se um documento foi roubado, 0 caso contrário
+ */
+int deque_steal(PrinterDeque *d, Document *doc, size_t *pos)
+{
+    if (pthread_mutex_trylock(&d->mutex) != 0)
+    {
+        return 0;
+    }
+    if (d->head == d->tail)
+    {
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
+    }
+
+    d->tail--;
+    *pos = d->tail & dispatch.mask;
+    *doc = d->buffer[*pos];
+    d->stolen++;
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
+
+/**
+ * Fila de destino de um documento
+ *
+ * @param producer_id ID do produtor
+ * @param next Contador de rodízio do produtor (incrementado no modo rr)
+ */
+int dispatch_target(int producer_id, unsigned *next)
+{
+    if (config.dispatch == PRINT_DISPATCH_HASH)
+    {
+        return (int)(((unsigned)producer_id * STEAL_HASH_MULTIPLIER) % (unsigned)dispatch.num_deques);
+    }
+    return (int)((*next)++ % (unsigned)dispatch.num_deques);
+}
+
+/**
+ * Publica um documento em uma fila de impressora
+ *
+ * Tenta a fila de destino e, se estiver cheia, as seguintes. Se todas estiverem
+ * cheias, espera uma impressora liberar espaço até o prazo.
+ *
+ * @param producer_id ID do produtor
+ * @param next Contador de rodízio do produtor
+ * @param doc Documento a publicar
+ * @param printer Recebe o índice da fila usada
+ * @param pos Recebe a posição ocupada
+ * @param deadline Prazo absoluto (NULL espera indefinidamente)
+ * @return PRINT_SUCCESS, PRINT_ERR_TIMEOUT se as filas continuaram cheias até o prazo,
+ *         ou PRINT_ERR_STOPPED em desligamento
+ */
+int dispatch_submit(int producer_id, unsigned *next, Document *doc, int *printer, size_t *pos,
+                    const struct timespec *deadline)
+{
+    int target = dispatch_target(producer_id, next);
+
+    for (;;)
+    {
+        for (int i = 0; i < dispatch.num_deques; i++)
+        {
+            *printer = (target + i) % dispatch.num_deques;
+            if (deque_push(&dispatch.deques[*printer], doc, pos))
+            {
+                atomic_fetch_add(&dispatch.pending, 1);
+
+                // Só adquire o mutex global se houver impressora esperando
+                if (atomic_load(&dispatch.idle_printers) > 0)
+                {
+                    pthread_mutex_lock(&dispatch.wait_mutex);
+                    print_waitlist_wake(&dispatch.has_work, 1);
+                    pthread_mutex_unlock(&dispatch.wait_mutex);
+                }
+                return PRINT_SUCCESS;
+            }
+        }
+
+        // Todas as filas cheias: espera uma remoção
+        int timed_out = 0;
+        pthread_mutex_lock(&dispatch.wait_mutex);
+        atomic_fetch_add(&dispatch.waiting_producers, 1);
+        while (atomic_load(&dispatch.pending) == dispatch.capacity * dispatch.num_deques &&
+               !atomic_load(&dispatch.should_stop) && !timed_out)
+        {
+            timed_out = print_waitlist_wait(&dispatch.has_space, &dispatch.wait_mutex, deadline) == ETIMEDOUT;
+        }
+        atomic_fetch_sub(&dispatch.waiting_producers, 1);
+        pthread_mutex_unlock(&dispatch.wait_mutex);
+
+        if (atomic_load(&dispatch.should_stop))
+        {
+            return PRINT_ERR_STOPPED;
+        }
+        if (timed_out && atomic_load(&dispatch.pending) == dispatch.capacity * dispatch.num_deques)
+        {
+            return PRINT_ERR_TIMEOUT;
+        }
+    }
+}
+
+/**
+ * Contabiliza documentos removidos das filas
+ *
+ * @param n Número de documentos removidos
+ */
+void dispatch_removed(int n)
+{
+    atomic_fetch_sub(&dispatch.pending, n);
+
+    // Só adquire o mutex global se houver produtor esperando; acorda um produtor por
+    // posição liberada
+    if (atomic_load(&dispatch.waiting_producers) > 0)
+    {
+        pthread_mutex_lock(&dispatch.wait_mutex);
+        print_waitlist_wake(&dispatch.has_space, n);
+        pthread_mutex_unlock(&dispatch.wait_mutex);
+    }
+}
+
+/**
+ * Remove o registro de um produtor do despacho por impressora
+ *
+ * O último produtor fecha a lista das impressoras ociosas, que acordam em cascata
+ * para encerrar, e avisa o laço de eventos.
+ */
+void dispatch_producer_done(void)
+{
+    if (atomic_fetch_sub(&dispatch.active_producers, 1) == 1)
+    {
+        pthread_mutex_lock(&dispatch.wait_mutex);
+        print_waitlist_close(&dispatch.has_work);
+        pthread_mutex_unlock(&dispatch.wait_mutex);
+        if (dispatch.done_fd >= 0)
+        {
+            event_notify(dispatch.done_fd);
+        }
+    }
+}
+
+/**
+ * Obtém o próximo documento de uma impressora
+ *
+ * Consome a própria fila e, se ela estiver vazia, rouba das demais a partir da
+ * vizinha. Sem documentos em nenhuma fila, espera até que um produtor publique ou
+ * que todos os produtores terminem.
+ *
+ * @param printer Índice da impressora
+ * @param doc Recebe o documento
+ * @param pos Recebe a posição liberada
+ * @param stolen Recebe 1 se o documento foi roubado de outra fila
+ * @return 1 se um documento foi obtido, 0 se não há mais documentos
+ */
+int dispatch_take(int printer, Document *doc, size_t *pos, int *stolen)
+{
+    for (;;)
+    {
+        *stolen = 0;
+        int found = deque_pop(&dispatch.deques[printer], doc, pos);
+
+        for (int i = 1; !found && i < dispatch.num_deques; i++)
+        {
+            found = deque_steal(&dispatch.deques[(printer + i) % dispatch.num_deques], doc, pos);
+            *stolen = found;
+        }
+
+        if (found)
+        {
+            dispatch_removed(1);
+            return 1;
+        }
+
+        // Nenhum documento visível: envia as gravações pendentes e espera publicação
+        // ou fim da produção
+        printer_idle(printer);
+        pthread_mutex_lock(&dispatch.wait_mutex);
+        atomic_fetch_add(&dispatch.idle_printers, 1);
+        while (atomic_load(&dispatch.pending) == 0 && atomic_load(&dispatch.active_producers) > 0 &&
+               !atomic_load(&dispatch.should_stop))
+        {
+            print_waitlist_wait(&dispatch.has_work, &dispatch.wait_mutex, NULL);
+        }
+        atomic_fetch_sub(&dispatch.idle_printers, 1);
+        pthread_mutex_unlock(&dispatch.wait_mutex);
+
+        if (atomic_load(&dispatch.pending) == 0 &&
+            (atomic_load(&dispatch.active_producers) == 0 || atomic_load(&dispatch.should_stop)))
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * Função da Thread Produtora (despacho por impressora)
+ *
+ * @param arg Ponteiro para o ID do produtor (int)
+ * @return NULL
+ */
+void *producer(void *arg)
+{
+    int producer_id = *(int *)arg;
+    unsigned next = (unsigned)(producer_id - 1);
+    int docs_produced = 0;
+    struct timespec deadline;
+    WorkloadRng rng;
+    PrintTraceCursor trace = {0};
+
+    workload_rng_init(&rng, config.seed, (uint64_t)producer_id);
+    print_affinity_pin(PRINT_AFFINITY_PRODUCER, producer_id - 1);
+
+    while (docs_produced < config.max_documents && !atomic_load(&dispatch.should_stop))
+    {
+        Document doc = {
+            .id = (producer_id * config.max_documents) + docs_produced,
+            .size = (int)workload_sample(&config.job_sizes, &rng),
+            .producer_id = producer_id};
+        snprintf(doc.type, MAX_TYPE_LENGTH, "Doc%d", producer_id);
+        if (print_trace_document(&trace, producer_id, &doc.size, doc.type, MAX_TYPE_LENGTH) != 0)
+        {
+            break; // Fim do trace deste produtor
+        }
+        if (render_document(&doc) != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        int printer;
+        size_t pos;
+        if (journal_submit(&doc) != PRINT_SUCCESS)
+        {
+            print_slab_free(doc.payload);
+            break;
+        }
+        int ret = dispatch_submit(producer_id, &next, &doc, &printer, &pos,
+                                  print_deadline_for(config.submit_timeout, &deadline));
+        if (ret == PRINT_ERR_TIMEOUT)
+        {
+            // Todas as filas saturadas: descarta o documento em vez de bloquear o produtor
+            print_slab_free(doc.payload);
+            journal_complete(&doc);
+            atomic_fetch_add_explicit(&docs_shed, 1, memory_order_relaxed);
+            print_log("[Produtor %d] Filas cheias, documento %d descartado\n", producer_id, doc.id);
+        }
+        else if (ret != PRINT_SUCCESS)
+        {
+            print_slab_free(doc.payload);
+            break;
+        }
+        else
+        {
+            print_affinity_note(PRINT_AFFINITY_PRODUCER, producer_id - 1, 1);
+            print_log_at(doc.enqueue_ns, "[Produtor %d] Adicionou documento %d (%s, %dKB) na fila %d, posição %zu\n",
+                         producer_id, doc.id, doc.type, doc.size, printer + 1, pos);
+        }
+
+        docs_produced++;
+        if (config.simulate_delays && !print_trace.replaying)
+        {
+            usleep(workload_gap(&config.arrivals, &rng, PRINT_MAX_PRODUCE_GAP_US)); // Simula tempo variável de criação de documento
+        }
+    }
+
+    dispatch_producer_done();
+
+    print_slab_thread_flush();
+    print_log("[Produtor %d] Finalizou a produção de documentos\n", producer_id);
+    return NULL;
+}
+
+/**
+ * Função da Thread Consumidora (despacho por impressora)
+ *
+ * @param arg Ponteiro para o ID do consumidor (int)
+ * @return NULL
+ */
+void *consumer(void *arg)
+{
+    int consumer_id = *(int *)arg;
+    int docs_stolen = 0;
+    Document doc;
+    size_t pos;
+    int stolen;
+
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, consumer_id - 1);
+    while (dispatch_take(consumer_id - 1, &doc, &pos, &stolen))
+    {
+        uint64_t timestamp = print_log_now();
+
+        docs_stolen += stolen;
+        print_latency_record(&latency[consumer_id - 1], timestamp - doc.enqueue_ns);
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, consumer_id - 1, 1);
+        print_log_at(timestamp, "[Consumidor %d] Imprimindo documento %d (%s, %dKB)%s\n",
+                     consumer_id, doc.id, doc.type, doc.size, stolen ? " (roubado)" : "");
+        print_document(consumer_id - 1, &doc, timestamp);
+    }
+
+    printer_finish(consumer_id - 1);
+    print_slab_thread_flush();
+    print_log("[Consumidor %d] Não há mais documentos para imprimir, encerrando (%d roubados)\n",
+              consumer_id, docs_stolen);
+    return NULL;
+}
+
+/**
+ * Imprime os documentos de uma fila, em lotes
+ *
+ * Imprime no máximo uma capacidade da fila por chamada, para que uma fila sempre
+ * reabastecida não monopolize o laço; se parar antes de esvaziá-la, escreve de novo
+ * no eventfd da fila para que o epoll volte a ela depois das demais.
+ *
+ * @param printer Índice da impressora
+ * @return Número de documentos impressos
+ */
+int event_drain(int printer)
+{
+    Document batch[PRINT_MAX_BATCH_SIZE];
+    int printed = 0;
+    int n = 0;
+
+    while ((size_t)printed < dispatch.capacity &&
+           (n = deque_pop_batch(&dispatch.deques[printer], batch, config.batch_size)) > 0)
+    {
+        dispatch_removed(n);
+        print_affinity_note(PRINT_AFFINITY_CONSUMER, 0, n);
+
+        uint64_t now = print_log_now();
+        for (int i = 0; i < n; i++)
+        {
+            Document *doc = &batch[i];
+            uint64_t started = print_log_now();
+
+            print_latency_record(&latency[printer], now - doc->enqueue_ns);
+            print_log_at(started, "[Impressora %d] Imprimindo documento %d (%s, %dKB)\n",
+                         printer + 1, doc->id, doc->type, doc->size);
+            print_document(printer, doc, started);
+        }
+        printed += n;
+    }
+
+    if ((size_t)printed >= dispatch.capacity && n > 0)
+    {
+        event_notify(dispatch.deques[printer].event_fd);
+    }
+    return printed;
+}
+
+/**
+ * Função da Thread do Laço de Eventos (--event-loop)
+ *
+ * Registra no epoll o eventfd de cada fila e o de fim da produção. A cada fila
+ * notificada, zera o eventfd e imprime os documentos em lotes até esvaziá-la.
+ * Com --spool, registra também o anel io_uring de cada impressora, que fica pronto
+ * quando há gravações concluídas, e envia as gravações acumuladas antes de esperar.
+ * Encerra quando a produção terminou e nenhum documento está pendente.
+ *
+ * @param arg Não utilizado
+ * @return NULL
+ */
+void *event_loop(void *arg)
+{
+    struct epoll_event events[2 * PRINT_MAX_THREADS + 1];
+    struct epoll_event ev = {.events = EPOLLIN};
+    int num_fds = outputs != NULL ? 2 * dispatch.num_deques + 1 : dispatch.num_deques + 1;
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    long printed = 0;
+    eventfd_t value;
+
+    (void)arg;
+    print_affinity_pin(PRINT_AFFINITY_CONSUMER, 0);
+    if (epfd < 0)
+    {
+        fprintf(stderr, "Falha ao criar epoll: %s\n", strerror(errno));
+        atomic_store(&dispatch.should_stop, 1);
+        return NULL;
+    }
+    // Identificadores: filas 0..K-1, fim da produção K, anéis io_uring K+1..2K
+    for (int i = 0; i < num_fds; i++)
+    {
+        ev.data.u32 = (uint32_t)i;
+        int fd = i < dispatch.num_deques    ? dispatch.deques[i].event_fd
+                 : i == dispatch.num_deques ? dispatch.done_fd
+                                            : print_spool_poll_fd(&outputs[i - dispatch.num_deques - 1].spool);
+        if (fd < 0)
+        {
+            continue; // Spool sem io_uring: gravações síncronas
+        }
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        {
+            fprintf(stderr, "Falha ao registrar eventfd no epoll: %s\n", strerror(errno));
+            atomic_store(&dispatch.should_stop, 1);
+            close(epfd);
+            return NULL;
+        }
+    }
+
+    for (;;)
+    {
+        for (int i = 0; outputs != NULL && i < dispatch.num_deques; i++)
+        {
+            printer_idle(i);
+        }
+
+        int n = epoll_wait(epfd, events, num_fds, -1);
+        if (n < 0 && errno != EINTR)
+        {
+            fprintf(stderr, "Falha em epoll_wait: %s\n", strerror(errno));
+            atomic_store(&dispatch.should_stop, 1);
+            break;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            int printer = (int)events[i].data.u32;
+            if (printer == dispatch.num_deques)
+            {
+                eventfd_read(dispatch.done_fd, &value);
+                continue;
+            }
+            if (printer > dispatch.num_deques)
+            {
+                printer_idle(printer - dispatch.num_deques - 1); // Gravações concluídas
+                continue;
+            }
+
+            // Zera a notificação antes de esvaziar a fila
+            eventfd_read(dispatch.deques[printer].event_fd, &value);
+            printed += event_drain(printer);
+        }
+
+        // Produção encerrada: inserções concluídas antes do aviso ainda podem estar nas filas
+        if (atomic_load(&dispatch.active_producers) == 0)
+        {
+            for (int i = 0; i < dispatch.num_deques; i++)
+            {
+                printed += event_drain(i);
+            }
+            if (atomic_load(&dispatch.pending) == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < dispatch.num_deques; i++)
+    {
+        printer_finish(i);
+    }
+    close(epfd);
+    print_slab_thread_flush();
+    print_log("[Laço de eventos] Não há mais documentos para imprimir, encerrando (%ld impressos)\n", printed);
+    return NULL;
+}
+
+/**
+ * Função da Thread de Reexecução do Diário
+ *
+ * Reenvia à fila os trabalhos que a execução anterior aceitou e não imprimiu. Os
+ * trabalhos já estão no diário, então não são registrados de novo; conta como um
+ * produtor adicional para que as impressoras não encerrem antes do fim do reenvio.
+ *
+ * @param arg Não utilizado
+ * @return NULL
+ */
+void *replay_producer(void *arg)
+{
+    unsigned next = 0;
+    size_t replayed = 0;
+
+    (void)arg;
+    for (; replayed < num_recovered_jobs && !atomic_load(&dispatch.should_stop); replayed++)
+    {
+        const PrintJournalRecord *rec = &recovered_jobs[replayed];
+        Document doc = {
+            .id = rec->doc_id,
+            .size = rec->size,
+            .producer_id = rec->producer_id,
+            .job = rec->job};
+        memcpy(doc.type, rec->type, MAX_TYPE_LENGTH);
+        doc.type[MAX_TYPE_LENGTH - 1] = '\0';
+        if (render_document(&doc) != PRINT_SUCCESS)
+        {
+            break;
+        }
+
+        int printer;
+        size_t pos;
+        if (dispatch_submit(doc.producer_id, &next, &doc, &printer, &pos, NULL) != PRINT_SUCCESS)
+        {
+            print_slab_free(doc.payload);
+            break;
+        }
+
+        print_log_at(doc.enqueue_ns, "[Diário] Reenviou o trabalho %llu: documento %d (%s, %dKB) na fila %d, posição %zu\n",
+                     (unsigned long long)doc.job, doc.id, doc.type, doc.size, printer + 1, pos);
+    }
+
+    // Remove o registro do produtor de reexecução
+    dispatch_producer_done();
+
+    print_slab_thread_flush();
+    print_log("[Diário] %zu trabalhos pendentes reenviados\n", replayed);
+    return NULL;
+}
+
+/**
+ * Função Principal
+ *
+ * Inicializa o sistema, cria threads produtoras e consumidoras,
+ * aguarda conclusão e realiza limpeza.
+ *
+ * Ciclo de Vida do Sistema:
+ * 1. Inicializa as filas das impressoras e primitivas de sincronização
+ * 2. Cria threads produtoras e consumidoras
+ * 3. Aguarda conclusão de todas as threads
+ * 4. Limpa recursos
+ *
+ * @param argc Número de argumentos
+ * @param argv Vetor de argumentos (veja print_config.h)
+ * @return EXIT_SUCCESS em caso de execução bem-sucedida, EXIT_FAILURE caso contrário
+ */
+int main(int argc, char *argv[])
+{
+    pthread_t *producers;
+    pthread_t *consumers;
+    int *producer_ids;
+    int *consumer_ids;
+    pthread_t replayer;
+    PrintStats stats;
+    int replayers = 0;
+    int ret;
+
+    // Lê a configuração da execução
+    if ((ret = print_config_load(&config, argc, argv, PROGRAM_OPTIONS)) != PRINT_CONFIG_OK)
+    {
+        return ret == PRINT_CONFIG_EXIT ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Abre o trace a gravar ou reproduzir (na reprodução, define os documentos por produtor)
+    if (print_trace_init(&config) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    producers = calloc(config.num_producers, sizeof(pthread_t));
+    consumers = calloc(config.num_consumers, sizeof(pthread_t));
+    producer_ids = calloc(config.num_producers, sizeof(int));
+    consumer_ids = calloc(config.num_consumers, sizeof(int));
+    latency = calloc(config.num_consumers, sizeof(PrintLatencyRecorder));
+    if (!producers || !consumers || !producer_ids || !consumer_ids || !latency)
+    {
+        fprintf(stderr, "Falha ao alocar vetores de threads\n");
+        return EXIT_FAILURE;
+    }
+
+    // Recupera os trabalhos pendentes do diário; havendo algum, uma thread de
+    // reexecução os reenvia como um produtor adicional
+    if (config.journal != NULL)
+    {
+        if (print_journal_replay(config.journal, &recovered_jobs, &num_recovered_jobs) != 0)
+        {
+            fprintf(stderr, "Falha ao ler o diário %s: %s\n", config.journal, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        if (print_journal_open(config.journal, config.journal_us, config.num_producers,
+                               recovered_jobs, num_recovered_jobs) != 0)
+        {
+            return EXIT_FAILURE;
+        }
+        replayers = num_recovered_jobs > 0;
+    }
+
+    // Topologia e nó das filas, antes de alocá-las (o laço de eventos é a única impressora)
+    if (print_affinity_init(&config, config.num_producers, config.event_loop ? 1 : config.num_consumers) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Inicializa sistema; os produtores são registrados antes da criação das
+    // threads, para que nenhuma impressora encerre antes de o primeiro começar
+    if ((ret = init_steal_dispatch(config.buffer_size, config.num_consumers, config.num_producers + replayers,
+                                   config.event_loop)) != PRINT_SUCCESS)
+    {
+        fprintf(stderr, "Falha ao inicializar filas das impressoras: %d\n", ret);
+        return EXIT_FAILURE;
+    }
+
+    // Pool de conteúdo: um bloco por documento que cabe nas filas, mais as listas
+    // locais de cada thread
+    size_t queued = config.buffer_size * config.num_consumers;
+    if (config.spool != NULL)
+    {
+        queued += (size_t)config.num_consumers * PRINT_SPOOL_DEPTH; // Blocos com gravação em andamento
+    }
+    if (print_slab_init(print_slab_blocks_for(queued, config.num_producers + replayers + config.num_consumers),
+                        sizeof(PayloadHeader) + config.payload_size) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+    if (config.spool != NULL && open_outputs(config.spool, config.num_consumers) != PRINT_SUCCESS)
+    {
+        fprintf(stderr, "Falha ao abrir os arquivos de spool em %s\n", config.spool);
+        return EXIT_FAILURE;
+    }
+
+    int num_consumer_threads = config.event_loop ? 1 : config.num_consumers;
+    void *(*consumer_fn)(void *) = config.event_loop ? event_loop : consumer;
+
+    if (!config.quiet)
+    {
+        printf("Fila de impressão: buffer de %zu posições por impressora, %d produtores, %d impressoras%s\n",
+               config.buffer_size, config.num_producers, config.num_consumers,
+               config.event_loop ? " em um laço de eventos" : "");
+    }
+
+    // Inicia a thread escritora do log
+    print_log_mute(config.quiet);
+    if (print_log_start() != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de log\n");
+        return EXIT_FAILURE;
+    }
+
+    const char *impl = config.event_loop ? "steal-epoll" : "steal";
+    if (print_stats_watch_start(impl, latency, config.num_consumers) != 0)
+    {
+        fprintf(stderr, "Falha ao iniciar relatório de latências\n");
+        return EXIT_FAILURE;
+    }
+    print_stats_begin(&stats);
+
+    // Reenvia os trabalhos pendentes do diário
+    if (replayers && pthread_create(&replayer, NULL, replay_producer, NULL) != 0)
+    {
+        fprintf(stderr, "Falha ao criar thread de reexecução do diário: %s\n", strerror(errno));
+        atomic_store(&dispatch.should_stop, 1);
+        return EXIT_FAILURE;
+    }
+
+    // Cria threads produtoras
+    print_trace_start();
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        producer_ids[i] = i + 1;
+        if (pthread_create(&producers[i], NULL, producer, &producer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread produtora %d: %s\n", i, strerror(errno));
+            atomic_store(&dispatch.should_stop, 1);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Cria threads consumidoras (uma só com o laço de eventos)
+    for (int i = 0; i < num_consumer_threads; i++)
+    {
+        consumer_ids[i] = i + 1;
+        if (pthread_create(&consumers[i], NULL, consumer_fn, &consumer_ids[i]) != 0)
+        {
+            fprintf(stderr, "Falha ao criar thread consumidora %d: %s\n", i, strerror(errno));
+            atomic_store(&dispatch.should_stop, 1);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Aguarda conclusão das threads
+    if (replayers)
+    {
+        pthread_join(replayer, NULL);
+    }
+    for (int i = 0; i < config.num_producers; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+    for (int i = 0; i < num_consumer_threads; i++)
+    {
+        pthread_join(consumers[i], NULL);
+    }
+
+    print_stats_end(&stats);
+    print_stats_watch_stop();
+    if (config.journal != NULL)
+    {
+        print_journal_close();
+    }
+
+    // Escreve as mensagens pendentes e limpa recursos
+    print_log_stop();
+    print_trace_finish(&config);
+    if (config.stats_format != PRINT_STATS_NONE)
+    {
+        print_stats_report(impl, &config, &stats, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        print_stats_summary(stdout, impl, latency, config.num_consumers);
+    }
+    if (!config.quiet)
+    {
+        printf("Pool de conteúdo: %u blocos de %zu bytes, %lu lotes retirados e %lu devolvidos à lista global\n",
+               print_slab.num_blocks, print_slab.block_size, atomic_load(&print_slab.refills),
+               atomic_load(&print_slab.flushes));
+    }
+    if (!config.quiet)
+    {
+        print_affinity_report(stdout);
+    }
+    if (config.submit_timeout >= 0 && !config.quiet)
+    {
+        printf("Documentos descartados por prazo de submissão: %lu\n", atomic_load(&docs_shed));
+    }
+    if (config.journal != NULL && !config.quiet)
+    {
+        printf("Diário: %zu trabalhos reexecutados, %lu registros gravados em %lu commits (%.1f por fdatasync)\n",
+               num_recovered_jobs, print_journal.records, print_journal.commits,
+               print_journal.commits ? (double)print_journal.records / print_journal.commits : 0.0);
+    }
+    if (outputs != NULL)
+    {
+        close_outputs(config.num_consumers);
+    }
+    free(recovered_jobs);
+    print_slab_destroy();
+    print_affinity_cleanup();
+    cleanup_steal_dispatch();
+    print_latency_free(latency, config.num_consumers);
+    free(latency);
+    free(producers);
+    free(consumers);
+    free(producer_ids);
+    free(consumer_ids);
+    if (!config.quiet)
+    {
+        printf("Sistema de fila de impressão finalizado com sucesso\n");
+    }
+
+    return EXIT_SUCCESS;
+}
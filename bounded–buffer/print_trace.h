@@ -0,0 +1,454 @@
+/**
+ * Gravação e Reprodução de Traces de Carga
+ *
+ * Este cabeçalho é compartilhado pelas implementações do produtor-consumidor.
+ * Em vez de tamanhos e intervalos sintéticos (../common/workload.h), os produtores
+ * podem reproduzir um trace binário capturado de uma execução real, de modo que
+ * regressões de desempenho sejam avaliadas com o padrão de chegada real.
+ *
+ * Formato (little-endian, tamanho fixo):
+ * - Cabeçalho de 32 bytes: marca "PRTRACE1", versão, tamanho do registro e número
+ *   de registros
+ * - Registros de 40 bytes: instante da criação do documento em ns desde o início da
+ *   gravação, produtor, tamanho em KB e tipo
+ *
+ * Gravação (--record-trace ARQUIVO):
+ * - O arquivo é criado com espaço para todos os documentos da execução e mapeado com
+ *   mmap; cada produtor reserva a próxima posição com um único incremento atômico e
+ *   escreve o registro direto no mapeamento, sem lock nem chamada de sistema
+ * - Os registros de um mesmo produtor ficam em ordem crescente de instante
+ * - Ao final, o cabeçalho recebe o número de registros e o arquivo é truncado
+ *
+ * Reprodução (--replay-trace ARQUIVO, --trace-speed N):
+ * - O arquivo é mapeado somente para leitura; o registro do produtor P do trace vai
+ *   para o produtor ((P - 1) % produtores) + 1 desta execução
+ * - Na abertura, um índice agrupa os registros de cada produtor, de modo que cada
+ *   documento reproduzido custa O(1) em vez de uma busca no trace inteiro
+ * - Cada produtor espera até o instante do registro dividido por N (N = 1 reproduz
+ *   a velocidade gravada, N = 0 não espera) e cria o documento com o tamanho e o
+ *   tipo gravados; os atrasos simulados do produtor são desativados
+ * - O número de documentos por produtor passa a ser o do trace
+ *
+ * Uso:
+ *   print_trace_init(&config);                            // abre o trace configurado
+ *   print_trace_start();                                  // antes dos produtores
+ *   PrintTraceCursor cursor = {0};                        // em cada produtor
+ *   print_trace_document(&cursor, id, &tamanho, tipo, n); // a cada documento
+ *   print_trace_close();
+ */
+
+#ifndef PRINT_TRACE_H
+#define PRINT_TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "print_config.h"
+
+/**
+ * Parâmetros do formato
+ */
+#define PRINT_TRACE_MAGIC "PRTRACE1"         // Marca do cabeçalho
+#define PRINT_TRACE_VERSION 1                // Versão do formato
+#define PRINT_TRACE_TYPE_LENGTH 20           // Tamanho do tipo do documento no registro
+#define PRINT_TRACE_MAX_RECORDS (1ULL << 28) // Maior trace gravado (10 GB)
+
+/**
+ * Cabeçalho do arquivo de trace
+ */
+typedef struct
+{
+    char magic[8];        // PRINT_TRACE_MAGIC
+    uint32_t version;     // PRINT_TRACE_VERSION
+    uint32_t record_size; // sizeof(PrintTraceRecord)
+    uint64_t count;       // Registros no arquivo
+    uint64_t reserved;    // Reservado (zero)
+} PrintTraceHeader;
+
+/**
+ * Registro de um documento criado
+ */
+typedef struct
+{
+    uint64_t timestamp_ns;              // Instante da criação, desde o início da gravação
+    int32_t producer_id;                // Produtor que criou o documento
+    int32_t size;                       // Tamanho do documento em KB
+    char type[PRINT_TRACE_TYPE_LENGTH]; // Tipo do documento
+    uint32_t reserved;                  // Reservado (zero)
+} PrintTraceRecord;
+
+/**
+ * Posição de um produtor no trace reproduzido
+ */
+typedef struct
+{
+    uint64_t next; // Próximo registro do produtor (posição na sua parte do índice)
+} PrintTraceCursor;
+
+/**
+ * Estado do trace
+ */
+typedef struct
+{
+    int recording;             // Gravando o trace desta execução
+    int replaying;             // Reproduzindo um trace gravado
+    int fd;                    // Arquivo do trace (gravação)
+    void *map;                 // Arquivo mapeado
+    size_t map_length;         // Tamanho do mapeamento
+    PrintTraceRecord *records; // Registros (logo após o cabeçalho)
+    uint64_t count;            // Registros disponíveis (reprodução)
+    uint64_t *index;           // Registros agrupados por produtor (reprodução)
+    uint64_t *first;           // Início de cada produtor em index, mais o fim (reprodução)
+    uint64_t capacity;         // Registros reservados (gravação)
+    atomic_uint_fast64_t used; // Registros escritos (gravação)
+    uint64_t start_ns;         // Início da gravação ou da reprodução
+    long speed;                // Aceleração da reprodução (0 = sem espera)
+    int num_producers;         // Produtores da reprodução
+} PrintTrace;
+
+static PrintTrace print_trace;
+
+/**
+ * Instante atual em nanossegundos (CLOCK_MONOTONIC)
+ */
+static inline uint64_t print_trace_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * Produtor desta execução que reproduz um registro
+ */
+static inline int print_trace_owner(const PrintTraceRecord *rec)
+{
+    int32_t id = rec->producer_id > 0 ? rec->producer_id : 1;
+
+    return ((id - 1) % print_trace.num_producers) + 1;
+}
+
+/**
+ * Abre um trace para reprodução
+ *
+ * @param path Arquivo do trace
+ * @param speed Aceleração (1 = velocidade gravada, 0 = sem espera)
+ * @param num_producers Produtores desta execução
+ * @param max_documents Recebe o maior número de documentos de um produtor
+ * @return 0 em caso de sucesso, -1 em caso de erro (mensagem em stderr)
+ */
+static inline int print_trace_open_replay(const char *path, long speed, int num_producers, int *max_documents)
+{
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        fprintf(stderr, "Falha ao abrir o trace '%s': %s\n", path, strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(PrintTraceHeader))
+    {
+        fprintf(stderr, "Trace '%s' inválido: arquivo menor que o cabeçalho\n", path);
+        close(fd);
+        return -1;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "Falha ao mapear o trace '%s': %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    const PrintTraceHeader *header = map;
+    uint64_t available = ((size_t)st.st_size - sizeof(PrintTraceHeader)) / sizeof(PrintTraceRecord);
+    if (memcmp(header->magic, PRINT_TRACE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != PRINT_TRACE_VERSION || header->record_size != sizeof(PrintTraceRecord) ||
+        header->count > available)
+    {
+        fprintf(stderr, "Trace '%s' inválido ou incompleto\n", path);
+        munmap(map, (size_t)st.st_size);
+        return -1;
+    }
+    madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    print_trace.replaying = 1;
+    print_trace.map = map;
+    print_trace.map_length = (size_t)st.st_size;
+    print_trace.records = (PrintTraceRecord *)(header + 1);
+    print_trace.count = header->count;
+    print_trace.speed = speed;
+    print_trace.num_producers = num_producers;
+
+    // Índice por produtor desta execução (ordenação por contagem, estável, de modo
+    // que os registros de cada produtor mantêm a ordem de instante)
+    uint64_t *first = calloc((size_t)num_producers + 1, sizeof(uint64_t));
+    uint64_t *index = malloc((size_t)(print_trace.count > 0 ? print_trace.count : 1) * sizeof(uint64_t));
+    uint64_t most = 0;
+    if (first == NULL || index == NULL)
+    {
+        fprintf(stderr, "Falha ao alocar o índice do trace\n");
+        free(first);
+        free(index);
+        munmap(map, (size_t)st.st_size);
+        print_trace.replaying = 0;
+        return -1;
+    }
+    for (uint64_t i = 0; i < print_trace.count; i++)
+    {
+        first[print_trace_owner(&print_trace.records[i])]++;
+    }
+    for (int p = 0; p < num_producers; p++)
+    {
+        most = first[p + 1] > most ? first[p + 1] : most;
+        first[p + 1] += first[p];
+    }
+    for (uint64_t i = 0; i < print_trace.count; i++)
+    {
+        index[first[print_trace_owner(&print_trace.records[i]) - 1]++] = i;
+    }
+    for (int p = num_producers; p > 0; p--)
+    {
+        first[p] = first[p - 1];
+    }
+    first[0] = 0;
+
+    // Os identificadores (produtor * documentos + sequência) precisam caber em int,
+    // como na verificação de print_config_load
+    if (most > ((uint64_t)INT_MAX + 1) / (uint64_t)(num_producers + 1))
+    {
+        fprintf(stderr, "Trace '%s' tem documentos demais por produtor (%llu) para %d produtores\n", path,
+                (unsigned long long)most, num_producers);
+        free(first);
+        free(index);
+        munmap(map, (size_t)st.st_size);
+        print_trace.replaying = 0;
+        return -1;
+    }
+    print_trace.index = index;
+    print_trace.first = first;
+    *max_documents = (int)most;
+    return 0;
+}
+
+/**
+ * Cria um trace para gravação
+ *
+ * @param path Arquivo do trace (substituído se existir)
+ * @param capacity Maior número de documentos da execução
+ * @return 0 em caso de sucesso, -1 em caso de erro (mensagem em stderr)
+ */
+static inline int print_trace_open_record(const char *path, uint64_t capacity)
+{
+    if (capacity > PRINT_TRACE_MAX_RECORDS)
+    {
+        fprintf(stderr, "Documentos demais para gravar o trace (máximo %llu)\n",
+                (unsigned long long)PRINT_TRACE_MAX_RECORDS);
+        return -1;
+    }
+
+    size_t length = sizeof(PrintTraceHeader) + (size_t)capacity * sizeof(PrintTraceRecord);
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t)length) != 0)
+    {
+        fprintf(stderr, "Falha ao criar o trace '%s': %s\n", path, strerror(errno));
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        return -1;
+    }
+
+    void *map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "Falha ao mapear o trace '%s': %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    PrintTraceHeader *header = map;
+    memcpy(header->magic, PRINT_TRACE_MAGIC, sizeof(header->magic));
+    header->version = PRINT_TRACE_VERSION;
+    header->record_size = sizeof(PrintTraceRecord);
+    header->count = 0;
+
+    print_trace.recording = 1;
+    print_trace.fd = fd;
+    print_trace.map = map;
+    print_trace.map_length = length;
+    print_trace.records = (PrintTraceRecord *)(header + 1);
+    print_trace.capacity = capacity;
+    atomic_init(&print_trace.used, 0);
+    return 0;
+}
+
+/**
+ * Marca o início da gravação ou da reprodução (antes de criar os produtores)
+ */
+static inline void print_trace_start(void)
+{
+    print_trace.start_ns = print_trace_now();
+}
+
+/**
+ * Registra ou reproduz o próximo documento de um produtor
+ *
+ * Na gravação, acrescenta um registro com o tamanho e o tipo informados. Na
+ * reprodução, espera até o instante do próximo registro do produtor e substitui o
+ * tamanho e o tipo pelos gravados. Sem trace, não faz nada.
+ *
+ * @param cursor Posição do produtor no trace (iniciada com zeros)
+ * @param producer_id ID do produtor
+ * @param size Tamanho do documento em KB (entrada na gravação, saída na reprodução)
+ * @param type Tipo do documento (entrada na gravação, saída na reprodução)
+ * @param type_length Tamanho da área de type
+ * @return 0 em caso de sucesso, -1 se o trace do produtor terminou
+ */
+static inline int print_trace_document(PrintTraceCursor *cursor, int producer_id, int *size, char *type,
+                                       size_t type_length)
+{
+    if (print_trace.recording)
+    {
+        uint64_t slot = atomic_fetch_add_explicit(&print_trace.used, 1, memory_order_relaxed);
+        if (slot < print_trace.capacity)
+        {
+            PrintTraceRecord *rec = &print_trace.records[slot];
+            rec->timestamp_ns = print_trace_now() - print_trace.start_ns;
+            rec->producer_id = producer_id;
+            rec->size = *size;
+            snprintf(rec->type, sizeof(rec->type), "%s", type);
+        }
+        return 0;
+    }
+    if (!print_trace.replaying)
+    {
+        return 0;
+    }
+
+    // Próximo registro deste produtor
+    if (producer_id < 1 || producer_id > print_trace.num_producers)
+    {
+        return -1;
+    }
+    uint64_t position = print_trace.first[producer_id - 1] + cursor->next;
+    if (position >= print_trace.first[producer_id])
+    {
+        return -1;
+    }
+    cursor->next++;
+
+    const PrintTraceRecord *rec = &print_trace.records[print_trace.index[position]];
+    if (print_trace.speed > 0)
+    {
+        uint64_t due = print_trace.start_ns + rec->timestamp_ns / (uint64_t)print_trace.speed;
+        struct timespec ts = {(time_t)(due / 1000000000ULL), (long)(due % 1000000000ULL)};
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        {
+        }
+    }
+    *size = rec->size;
+    snprintf(type, type_length, "%.*s", PRINT_TRACE_TYPE_LENGTH, rec->type);
+    return 0;
+}
+
+/**
+ * Encerra o trace: na gravação, grava o número de registros e trunca o arquivo
+ *
+ * @return Registros gravados ou reproduzíveis
+ */
+static inline uint64_t print_trace_close(void)
+{
+    uint64_t count = print_trace.count;
+
+    if (print_trace.recording)
+    {
+        count = atomic_load(&print_trace.used);
+        count = count < print_trace.capacity ? count : print_trace.capacity;
+        ((PrintTraceHeader *)print_trace.map)->count = count;
+        munmap(print_trace.map, print_trace.map_length);
+        if (ftruncate(print_trace.fd, (off_t)(sizeof(PrintTraceHeader) + count * sizeof(PrintTraceRecord))) != 0)
+        {
+            fprintf(stderr, "Falha ao truncar o trace: %s\n", strerror(errno));
+        }
+        close(print_trace.fd);
+    }
+    else if (print_trace.replaying)
+    {
+        munmap(print_trace.map, print_trace.map_length);
+        free(print_trace.index);
+        free(print_trace.first);
+        print_trace.index = NULL;
+        print_trace.first = NULL;
+    }
+    print_trace.recording = 0;
+    print_trace.replaying = 0;
+    return count;
+}
+
+/**
+ * Abre o trace configurado (--replay-trace ou --record-trace)
+ *
+ * Na reprodução, cfg->max_documents passa a ser o maior número de documentos de um
+ * produtor no trace.
+ *
+ * @param cfg Configuração da execução
+ * @return 0 em caso de sucesso ou sem trace, -1 em caso de erro
+ */
+static inline int print_trace_init(PrintConfig *cfg)
+{
+    if (cfg->replay_trace != NULL)
+    {
+        return print_trace_open_replay(cfg->replay_trace, cfg->trace_speed, cfg->num_producers,
+                                       &cfg->max_documents);
+    }
+    if (cfg->record_trace != NULL)
+    {
+        return print_trace_open_record(cfg->record_trace, (uint64_t)cfg->num_producers * cfg->max_documents);
+    }
+    return 0;
+}
+
+/**
+ * Encerra o trace configurado e informa o total de documentos
+ *
+ * @param cfg Configuração da execução
+ */
+static inline void print_trace_finish(const PrintConfig *cfg)
+{
+    int recording = print_trace.recording;
+    uint64_t count = print_trace_close();
+
+    if (cfg->quiet)
+    {
+        return;
+    }
+    if (recording)
+    {
+        printf("Trace gravado em %s: %llu documentos\n", cfg->record_trace, (unsigned long long)count);
+    }
+    else if (cfg->replay_trace != NULL)
+    {
+        printf("Trace reproduzido de %s: %llu documentos\n", cfg->replay_trace, (unsigned long long)count);
+    }
+}
+
+#endif // PRINT_TRACE_H
@@ -0,0 +1,199 @@
+/**
+ * Lista de Espera com Despertar Direcionado
+ *
+ * Este cabeçalho substitui uma variável de condição compartilhada quando é preciso
+ * escolher quem acorda. Cada thread em espera entra em uma fila FIFO com a sua
+ * própria variável de condição, e quem sinaliza acorda exatamente as primeiras da
+ * fila, sem pthread_cond_broadcast.
+ *
+ * Fechamento e drenagem:
+ * Ao fim da produção, print_waitlist_close marca a lista como fechada e acorda uma
+ * única thread. Cada thread que sai de uma espera com a lista fechada acorda a
+ * seguinte antes de retornar (despertar em cascata), e quem chega depois do
+ * fechamento não dorme. O custo para quem fecha é constante, qualquer que seja o
+ * número de threads em espera, e cada thread acorda uma só vez, quando a anterior
+ * já liberou o mutex, em vez de todas disputarem o mutex ao mesmo tempo.
+ *
+ * Todas as funções exigem o mutex associado adquirido.
+ *
+ * Uso:
+ *   pthread_mutex_lock(&mutex);
+ *   while (vazio && !print_waitlist_closed(&waiters))
+ *   {
+ *       print_waitlist_wait(&waiters, &mutex, NULL);
+ *   }
+ *   pthread_mutex_unlock(&mutex);
+ *
+ *   print_waitlist_wake(&waiters, 1);                    // documento publicado
+ *   print_waitlist_close(&waiters);                      // fim da produção
+ */
+
+#ifndef PRINT_WAITLIST_H
+#define PRINT_WAITLIST_H
+
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/**
+ * Thread em espera (alocada na pilha de quem espera)
+ */
+typedef struct PrintWaiter
+{
+    pthread_cond_t cond;      // Variável de condição própria
+    struct PrintWaiter *prev; // Anterior na fila
+    struct PrintWaiter *next; // Seguinte na fila
+    int woken;                // Retirada da fila por quem sinalizou
+} PrintWaiter;
+
+/**
+ * Fila de threads em espera
+ */
+typedef struct
+{
+    PrintWaiter *head;     // Primeira a acordar
+    PrintWaiter *tail;     // Última a entrar
+    int waiters;           // Threads na fila
+    int closed;            // Fechada: ninguém mais dorme
+    unsigned long wakeups; // Despertares enviados
+} PrintWaitList;
+
+/**
+ * Inicializa uma lista de espera vazia e aberta
+ *
+ * @param list Lista de espera
+ */
+static inline void print_waitlist_init(PrintWaitList *list)
+{
+    list->head = NULL;
+    list->tail = NULL;
+    list->waiters = 0;
+    list->closed = 0;
+    list->wakeups = 0;
+}
+
+/**
+ * Retira uma thread da fila
+ *
+ * @param list Lista de espera
+ * @param w Thread a retirar
+ */
+static inline void print_waitlist_unlink(PrintWaitList *list, PrintWaiter *w)
+{
+    if (w->prev != NULL)
+    {
+        w->prev->next = w->next;
+    }
+    else
+    {
+        list->head = w->next;
+    }
+    if (w->next != NULL)
+    {
+        w->next->prev = w->prev;
+    }
+    else
+    {
+        list->tail = w->prev;
+    }
+    list->waiters--;
+}
+
+/**
+ * Acorda as primeiras threads da fila, em ordem de chegada
+ *
+ * @param list Lista de espera (com o mutex adquirido)
+ * @param n Número máximo de threads a acordar
+ * @return Número de threads acordadas
+ */
+static inline int print_waitlist_wake(PrintWaitList *list, int n)
+{
+    int woken = 0;
+
+    while (woken < n && list->head != NULL)
+    {
+        PrintWaiter *w = list->head;
+
+        print_waitlist_unlink(list, w);
+        w->woken = 1;
+        pthread_cond_signal(&w->cond); // A thread só retorna depois que o mutex for liberado
+        woken++;
+    }
+    list->wakeups += woken;
+    return woken;
+}
+
+/**
+ * Espera ser acordada, a lista ser fechada ou o prazo vencer
+ *
+ * Retorna imediatamente se a lista já estiver fechada. Saindo de uma espera com a
+ * lista fechada, acorda a próxima thread da fila (cascata do fechamento).
+ *
+ * @param list Lista de espera
+ * @param mutex Mutex associado (adquirido)
+ * @param deadline Prazo absoluto, ou NULL para esperar indefinidamente
+ * @return 0 se acordou, ETIMEDOUT se o prazo venceu
+ */
+static inline int print_waitlist_wait(PrintWaitList *list, pthread_mutex_t *mutex, const struct timespec *deadline)
+{
+    PrintWaiter self = {.cond = PTHREAD_COND_INITIALIZER, .prev = list->tail, .next = NULL, .woken = 0};
+    int ret = 0;
+
+    if (list->closed)
+    {
+        return 0;
+    }
+    if (list->tail != NULL)
+    {
+        list->tail->next = &self;
+    }
+    else
+    {
+        list->head = &self;
+    }
+    list->tail = &self;
+    list->waiters++;
+
+    while (!self.woken && ret != ETIMEDOUT)
+    {
+        ret = deadline == NULL ? pthread_cond_wait(&self.cond, mutex) : pthread_cond_timedwait(&self.cond, mutex, deadline);
+    }
+    if (!self.woken)
+    {
+        print_waitlist_unlink(list, &self); // Prazo vencido ainda na fila
+    }
+    else
+    {
+        ret = 0; // Um despertar que coincide com o prazo não se perde
+        if (list->closed)
+        {
+            print_waitlist_wake(list, 1);
+        }
+    }
+    pthread_cond_destroy(&self.cond);
+    return ret;
+}
+
+/**
+ * Fecha a lista e inicia a cascata de despertares
+ *
+ * @param list Lista de espera (com o mutex adquirido)
+ */
+static inline void print_waitlist_close(PrintWaitList *list)
+{
+    list->closed = 1;
+    print_waitlist_wake(list, 1);
+}
+
+/**
+ * Indica se a lista foi fechada
+ *
+ * @param list Lista de espera (com o mutex adquirido)
+ * @return 1 se fechada, 0 caso contrário
+ */
+static inline int print_waitlist_closed(const PrintWaitList *list)
+{
+    return list->closed;
+}
+
+#endif // PRINT_WAITLIST_H
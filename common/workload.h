@@ -0,0 +1,492 @@
+/**
+ * Gerador de Carga Reproduzível
+ *
+ * Este cabeçalho é compartilhado pelos três problemas (fila de impressão,
+ * leitores-escritores e filósofos). Substitui rand(), que guarda um estado global
+ * protegido por um lock interno da glibc e cuja sequência, dividida entre threads,
+ * depende do escalonamento.
+ *
+ * Cada thread tem o seu próprio gerador xoshiro256** (WorkloadRng), inicializado
+ * a partir de uma semente e de um número de fluxo (o ID da thread) com splitmix64.
+ * A sequência de cada thread depende apenas desses dois valores, de modo que uma
+ * execução pode ser repetida exatamente a partir da semente, sem disputa entre threads.
+ *
+ * Distribuições (WorkloadDist), escolhidas por nome no formato NOME[:PARÂMETRO]:
+ *   uniform          Inteiros equiprováveis em [min, max]
+ *   zipf[:s]         Valor min + k - 1 com probabilidade proporcional a 1/k^s
+ *                    (padrão s = 0,99), amostrado por rejeição-inversão sem tabela
+ *   pareto[:alfa]    Pareto limitada em [min, max], cauda pesada (padrão alfa = 1,2)
+ *
+ * Chegadas (WorkloadArrivals):
+ *   uniform          Intervalo uniforme em [0, max_gap) entre eventos
+ *   bursty[:n]       Rajadas de n eventos em média (padrão 16) sem intervalo,
+ *                    separadas por pausas que mantêm a taxa média do modo uniform
+ *
+ * Variáveis de ambiente (workload_env_*): WORKLOAD_SEED define a semente dos
+ * programas sem opções de linha de comando.
+ *
+ * As distribuições usam a libm: programas que chamam workload_dist_* devem ser
+ * ligados com -lm.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * Valores padrão
+ */
+#define WORKLOAD_DEFAULT_SEED 1     // Semente padrão: execuções repetíveis sem configuração
+#define WORKLOAD_DEFAULT_ZIPF 0.99  // Expoente padrão da distribuição Zipf
+#define WORKLOAD_DEFAULT_PARETO 1.2 // Expoente padrão da distribuição de Pareto
+#define WORKLOAD_DEFAULT_BURST 16   // Eventos padrão por rajada
+
+/**
+ * Tipos de distribuição
+ */
+#define WORKLOAD_UNIFORM 0 // Uniforme em [min, max]
+#define WORKLOAD_ZIPF 1    // Zipf sobre os valores de [min, max] (min é o mais frequente)
+#define WORKLOAD_PARETO 2  // Pareto limitada em [min, max]
+
+/**
+ * Gerador xoshiro256** de uma thread
+ */
+typedef struct
+{
+    uint64_t s[4]; // Estado do gerador (nunca todo zero)
+} WorkloadRng;
+
+/**
+ * Distribuição de valores inteiros em [min, max]
+ */
+typedef struct
+{
+    int kind;         // Tipo (WORKLOAD_UNIFORM, WORKLOAD_ZIPF ou WORKLOAD_PARETO)
+    long min;         // Menor valor
+    long max;         // Maior valor
+    double param;     // Expoente s (Zipf) ou alfa (Pareto)
+    double h_x1;      // Zipf: H(1,5) - 1
+    double h_n;       // Zipf: H(n + 0,5)
+    double threshold; // Zipf: aceitação imediata se k - x <= threshold
+    double tail;      // Pareto: 1 - (min / (max + 1))^alfa
+} WorkloadDist;
+
+/**
+ * Processo de chegada de eventos
+ */
+typedef struct
+{
+    int bursty;     // Chegadas em rajadas em vez de uniformes
+    long burst_len; // Eventos por rajada, em média
+} WorkloadArrivals;
+
+/**
+ * Passo do splitmix64, usado para espalhar a semente pelo estado do xoshiro
+ *
+ * @param x Estado do splitmix64
+ * @return Próximo valor de 64 bits
+ */
+static inline uint64_t workload_splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Inicializa o gerador de uma thread
+ *
+ * Threads com fluxos diferentes recebem sequências independentes da mesma semente.
+ *
+ * @param rng Gerador a inicializar
+ * @param seed Semente da execução
+ * @param stream Número do fluxo (normalmente o ID da thread)
+ */
+static inline void workload_rng_init(WorkloadRng *rng, uint64_t seed, uint64_t stream)
+{
+    uint64_t x = seed ^ (stream * 0xd1b54a32d192ed03ULL);
+
+    for (int i = 0; i < 4; i++)
+    {
+        rng->s[i] = workload_splitmix64(&x);
+    }
+}
+
+/**
+ * Gira os bits de um valor à esquerda
+ */
+static inline uint64_t workload_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Próximo valor de 64 bits do xoshiro256**
+ *
+ * @param rng Gerador da thread
+ * @return Valor pseudoaleatório
+ */
+static inline uint64_t workload_next(WorkloadRng *rng)
+{
+    uint64_t *s = rng->s;
+    uint64_t result = workload_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = workload_rotl(s[3], 45);
+    return result;
+}
+
+/**
+ * Inteiro uniforme em [0, n), sem o viés de %, pelo método de Lemire
+ *
+ * @param rng Gerador da thread
+ * @param n Limite (n >= 1)
+ * @return Valor em [0, n)
+ */
+static inline uint64_t workload_below(WorkloadRng *rng, uint64_t n)
+{
+    unsigned __int128 m = (unsigned __int128)workload_next(rng) * n;
+    uint64_t low = (uint64_t)m;
+
+    if (low < n)
+    {
+        uint64_t threshold = -n % n;
+        while (low < threshold)
+        {
+            m = (unsigned __int128)workload_next(rng) * n;
+            low = (uint64_t)m;
+        }
+    }
+    return (uint64_t)(m >> 64);
+}
+
+/**
+ * Real uniforme em [0, 1) com 53 bits de precisão
+ *
+ * @param rng Gerador da thread
+ * @return Valor em [0, 1)
+ */
+static inline double workload_unit(WorkloadRng *rng)
+{
+    return (double)(workload_next(rng) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * log(1 + x) / x, estável para x próximo de zero
+ */
+static inline double workload_log1p_ratio(double x)
+{
+    if (fabs(x) > 1e-8)
+    {
+        return log1p(x) / x;
+    }
+    return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+/**
+ * (exp(x) - 1) / x, estável para x próximo de zero
+ */
+static inline double workload_expm1_ratio(double x)
+{
+    if (fabs(x) > 1e-8)
+    {
+        return expm1(x) / x;
+    }
+    return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+/**
+ * Zipf: h(x) = x^-s
+ */
+static inline double workload_zipf_h(const WorkloadDist *d, double x)
+{
+    return exp(-d->param * log(x));
+}
+
+/**
+ * Zipf: primitiva H de h
+ */
+static inline double workload_zipf_hint(const WorkloadDist *d, double x)
+{
+    double log_x = log(x);
+
+    return workload_expm1_ratio((1.0 - d->param) * log_x) * log_x;
+}
+
+/**
+ * Zipf: inversa de H
+ */
+static inline double workload_zipf_hint_inv(const WorkloadDist *d, double x)
+{
+    double t = x * (1.0 - d->param);
+
+    if (t < -1.0)
+    {
+        t = -1.0; // Erro de arredondamento no extremo do intervalo
+    }
+    return exp(workload_log1p_ratio(t) * x);
+}
+
+/**
+ * Inicializa uma distribuição
+ *
+ * @param d Distribuição a inicializar
+ * @param kind Tipo (WORKLOAD_UNIFORM, WORKLOAD_ZIPF ou WORKLOAD_PARETO)
+ * @param min Menor valor (Pareto exige min >= 1)
+ * @param max Maior valor (max >= min)
+ * @param param Expoente (> 0); ignorado na uniforme
+ * @return 0 em caso de sucesso, -1 se os parâmetros forem inválidos
+ */
+static inline int workload_dist_init(WorkloadDist *d, int kind, long min, long max, double param)
+{
+    if (max < min || (kind != WORKLOAD_UNIFORM && !(param > 0.0)) || (kind == WORKLOAD_PARETO && min < 1))
+    {
+        return -1;
+    }
+
+    memset(d, 0, sizeof(*d));
+    d->kind = kind;
+    d->min = min;
+    d->max = max;
+    d->param = param;
+
+    if (kind == WORKLOAD_ZIPF)
+    {
+        double n = (double)(max - min + 1);
+
+        d->h_x1 = workload_zipf_hint(d, 1.5) - 1.0;
+        d->h_n = workload_zipf_hint(d, n + 0.5);
+        d->threshold = 2.0 - workload_zipf_hint_inv(d, workload_zipf_hint(d, 2.5) - workload_zipf_h(d, 2.0));
+    }
+    else if (kind == WORKLOAD_PARETO)
+    {
+        d->tail = 1.0 - pow((double)min / (double)(max + 1), param);
+    }
+    return 0;
+}
+
+/**
+ * Converte uma distribuição no formato NOME[:PARÂMETRO]
+ *
+ * @param name Texto (uniform, zipf[:s] ou pareto[:alfa])
+ * @param min Menor valor
+ * @param max Maior valor
+ * @param d Recebe a distribuição
+ * @return 0 em caso de sucesso, -1 se o texto for inválido
+ */
+static inline int workload_dist_parse(const char *name, long min, long max, WorkloadDist *d)
+{
+    const char *colon = strchr(name, ':');
+    size_t len = colon != NULL ? (size_t)(colon - name) : strlen(name);
+    double param;
+    int kind;
+
+    if (len == 7 && strncmp(name, "uniform", len) == 0)
+    {
+        kind = WORKLOAD_UNIFORM;
+        param = 0.0;
+    }
+    else if (len == 4 && strncmp(name, "zipf", len) == 0)
+    {
+        kind = WORKLOAD_ZIPF;
+        param = WORKLOAD_DEFAULT_ZIPF;
+    }
+    else if (len == 6 && strncmp(name, "pareto", len) == 0)
+    {
+        kind = WORKLOAD_PARETO;
+        param = WORKLOAD_DEFAULT_PARETO;
+    }
+    else
+    {
+        return -1;
+    }
+
+    if (colon != NULL)
+    {
+        char *end;
+
+        errno = 0;
+        param = strtod(colon + 1, &end);
+        if (kind == WORKLOAD_UNIFORM || errno != 0 || end == colon + 1 || *end != '\0')
+        {
+            return -1;
+        }
+    }
+    return workload_dist_init(d, kind, min, max, param);
+}
+
+/**
+ * Sorteia um valor da distribuição
+ *
+ * @param d Distribuição (somente leitura, pode ser compartilhada entre threads)
+ * @param rng Gerador da thread
+ * @return Valor em [d->min, d->max]
+ */
+static inline long workload_sample(const WorkloadDist *d, WorkloadRng *rng)
+{
+    switch (d->kind)
+    {
+    case WORKLOAD_ZIPF:
+    {
+        double n = (double)(d->max - d->min + 1);
+
+        // Rejeição-inversão (Hörmann e Derflinger): aceita quase sempre na primeira tentativa
+        for (;;)
+        {
+            double u = d->h_n + workload_unit(rng) * (d->h_x1 - d->h_n);
+            double x = workload_zipf_hint_inv(d, u);
+            double k = floor(x + 0.5);
+
+            if (k < 1.0)
+            {
+                k = 1.0;
+            }
+            else if (k > n)
+            {
+                k = n;
+            }
+            if (k - x <= d->threshold || u >= workload_zipf_hint(d, k + 0.5) - workload_zipf_h(d, k))
+            {
+                return d->min + (long)k - 1;
+            }
+        }
+    }
+    case WORKLOAD_PARETO:
+    {
+        // Inversão da Pareto limitada a [min, max + 1), truncada para inteiro
+        double x = (double)d->min * pow(1.0 - workload_unit(rng) * d->tail, -1.0 / d->param);
+        long v = (long)x;
+
+        return v > d->max ? d->max : v;
+    }
+    default:
+        return d->min + (long)workload_below(rng, (uint64_t)(d->max - d->min) + 1);
+    }
+}
+
+/**
+ * Converte um processo de chegada no formato NOME[:N]
+ *
+ * @param name Texto (uniform ou bursty[:n])
+ * @param a Recebe o processo de chegada
+ * @return 0 em caso de sucesso, -1 se o texto for inválido
+ */
+static inline int workload_arrivals_parse(const char *name, WorkloadArrivals *a)
+{
+    if (strcmp(name, "uniform") == 0)
+    {
+        a->bursty = 0;
+        a->burst_len = 1;
+        return 0;
+    }
+    if (strncmp(name, "bursty", 6) != 0 || (name[6] != '\0' && name[6] != ':'))
+    {
+        return -1;
+    }
+
+    a->bursty = 1;
+    a->burst_len = WORKLOAD_DEFAULT_BURST;
+    if (name[6] == ':')
+    {
+        char *end;
+
+        errno = 0;
+        a->burst_len = strtol(name + 7, &end, 10);
+        if (errno != 0 || end == name + 7 || *end != '\0' || a->burst_len < 1 || a->burst_len > 1000000)
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Intervalo até o próximo evento
+ *
+ * No modo bursty, cada rajada tem comprimento geométrico de média burst_len; os
+ * eventos da rajada não esperam e a pausa que a encerra é uniforme em
+ * [0, max_gap * burst_len), preservando o intervalo médio do modo uniform.
+ *
+ * @param a Processo de chegada
+ * @param rng Gerador da thread
+ * @param max_gap Maior intervalo do modo uniform
+ * @return Intervalo, na mesma unidade de max_gap
+ */
+static inline long workload_gap(const WorkloadArrivals *a, WorkloadRng *rng, long max_gap)
+{
+    if (max_gap <= 0)
+    {
+        return 0;
+    }
+    if (!a->bursty)
+    {
+        return (long)workload_below(rng, (uint64_t)max_gap);
+    }
+    if (workload_below(rng, (uint64_t)a->burst_len) != 0)
+    {
+        return 0; // Continua a rajada
+    }
+    return (long)workload_below(rng, (uint64_t)max_gap * (uint64_t)a->burst_len);
+}
+
+/**
+ * Lê a semente da variável WORKLOAD_SEED
+ *
+ * @return Semente informada, ou WORKLOAD_DEFAULT_SEED se ausente ou inválida
+ */
+static inline uint64_t workload_env_seed(void)
+{
+    const char *text = getenv("WORKLOAD_SEED");
+    char *end;
+
+    if (text == NULL)
+    {
+        return WORKLOAD_DEFAULT_SEED;
+    }
+    errno = 0;
+    unsigned long long seed = strtoull(text, &end, 0);
+    if (errno != 0 || end == text || *end != '\0')
+    {
+        fprintf(stderr, "Valor inválido para WORKLOAD_SEED: '%s', usando %d\n", text, WORKLOAD_DEFAULT_SEED);
+        return WORKLOAD_DEFAULT_SEED;
+    }
+    return (uint64_t)seed;
+}
+
+/**
+ * Lê uma distribuição de uma variável de ambiente, se definida
+ *
+ * @param name Nome da variável
+ * @param min Menor valor
+ * @param max Maior valor
+ * @param d Recebe a distribuição (uniforme se a variável estiver ausente ou for inválida)
+ */
+static inline void workload_env_dist(const char *name, long min, long max, WorkloadDist *d)
+{
+    const char *text = getenv(name);
+
+    if (text != NULL && workload_dist_parse(text, min, max, d) == 0)
+    {
+        return;
+    }
+    if (text != NULL)
+    {
+        fprintf(stderr, "Valor inválido para %s: '%s', usando uniform\n", name, text);
+    }
+    workload_dist_init(d, WORKLOAD_UNIFORM, min, max, 0.0);
+}
+
+#endif // WORKLOAD_H
@@ -23,6 +23,8 @@
 #include <pthread.h>
 #include <unistd.h>
 
+#include "../common/workload.h"
+
 /**
  * Constantes de Configuração do Sistema
  */
@@ -69,6 +71,10 @@ typedef struct
 // Instância global do monitor
 StudioMonitor studio;
 
+// Gerador de carga: semente da execução (WORKLOAD_SEED) e gerador de cada editor
+uint64_t workload_seed;
+_Thread_local WorkloadRng thread_rng;
+
 /**
  * Inicialização do Monitor
  *
@@ -231,7 +237,7 @@ void release_boards(int editor_id)
 void think(int editor_id)
 {
     printf("Editor %d está planejando a próxima edição...\n", editor_id);
-    sleep(rand() % THINK_TIME + 1);
+    sleep(workload_below(&thread_rng, THINK_TIME) + 1);
 }
 
 /**
@@ -244,7 +250,7 @@ void think(int editor_id)
 void edit(int editor_id)
 {
     printf("Editor %d está editando o vídeo...\n", editor_id);
-    sleep(rand() % EDIT_TIME + 1);
+    sleep(workload_below(&thread_rng, EDIT_TIME) + 1);
 }
 
 /**
@@ -263,6 +269,7 @@ void *editor(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)id);
     for (int i = 0; i < NUM_EDITS && !studio.should_stop; i++)
     {
         think(id);          // Fase de planejamento
@@ -292,6 +299,7 @@ int main()
     int editor_ids[NUM_EDITORS];
 
     // Inicializa sistema
+    workload_seed = workload_env_seed();
     monitor_init();
 
     // Cria threads dos editores
@@ -21,6 +21,8 @@
 #include <pthread.h>
 #include <unistd.h>
 
+#include "../common/workload.h"
+
 /**
  * Constantes de Configuração do Sistema
  */
@@ -62,6 +64,10 @@ typedef struct
 // Instância global do controle do estúdio
 StudioControl studio;
 
+// Gerador de carga: semente da execução (WORKLOAD_SEED) e gerador de cada editor
+uint64_t workload_seed;
+_Thread_local WorkloadRng thread_rng;
+
 /**
  * Inicializa o Sistema do Estúdio
  *
@@ -155,7 +161,7 @@ void test_editor(int editor_id)
 void think(int editor_id)
 {
     printf("Editor %d está planejando a próxima edição...\n", editor_id);
-    usleep((rand() % THINK_TIME) * 1000000);
+    usleep(workload_below(&thread_rng, THINK_TIME) * 1000000);
 }
 
 /**
@@ -198,7 +204,7 @@ void take_boards(int editor_id)
 void edit(int editor_id)
 {
     printf("Editor %d está editando o vídeo...\n", editor_id);
-    usleep((rand() % EDIT_TIME) * 1000000);
+    usleep(workload_below(&thread_rng, EDIT_TIME) * 1000000);
 }
 
 /**
@@ -245,6 +251,7 @@ void *editor(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)id);
     for (int i = 0; i < NUM_EDITS; i++)
     {
         think(id);       // Fase de planejamento
@@ -273,7 +280,7 @@ int main()
     pthread_t editors[NUM_EDITORS];
     int editor_ids[NUM_EDITORS];
 
-    srand(time(NULL));
+    workload_seed = workload_env_seed();
     init_studio();
 
     printf("Iniciando sistema do estúdio com %d editores\n", NUM_EDITORS);
@@ -22,6 +22,8 @@
 #include <semaphore.h>
 #include <unistd.h>
 
+#include "../common/workload.h"
+
 /**
  * Constantes de Configuração do Sistema
  */
@@ -65,6 +67,10 @@ typedef struct
 // Instância global do controle do estúdio
 StudioControl studio;
 
+// Gerador de carga: semente da execução (WORKLOAD_SEED) e gerador de cada editor
+uint64_t workload_seed;
+_Thread_local WorkloadRng thread_rng;
+
 /**
  * Inicializa o Sistema do Estúdio
  *
@@ -154,7 +160,7 @@ void test_editor(int editor_id)
 void think(int editor_id)
 {
     printf("Editor %d está planejando a próxima edição...\n", editor_id);
-    sleep(rand() % THINK_TIME + 1);
+    sleep(workload_below(&thread_rng, THINK_TIME) + 1);
 }
 
 /**
@@ -199,7 +205,7 @@ void get_boards(int editor_id)
 void edit(int editor_id)
 {
     printf("Editor %d está editando o vídeo...\n", editor_id);
-    sleep(rand() % EDIT_TIME + 1);
+    sleep(workload_below(&thread_rng, EDIT_TIME) + 1);
 }
 
 /**
@@ -248,6 +254,7 @@ void *editor(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)id);
     for (int i = 0; i < NUM_EDITS; i++)
     {
         think(id);      // Fase de planejamento
@@ -277,6 +284,7 @@ int main()
     int editor_ids[NUM_EDITORS];
 
     // Inicializa sistema
+    workload_seed = workload_env_seed();
     init_studio();
 
     // Cria threads dos editores
@@ -23,6 +23,8 @@
 #include <pthread.h>
 #include <unistd.h>
 
+#include "../common/workload.h"
+
 /**
  * Constantes de Configuração do Sistema
  */
@@ -65,6 +67,12 @@ typedef struct
 Catalog catalog = {
     .num_readers = 0};
 
+// Gerador de carga: semente da execução (WORKLOAD_SEED), escolha dos produtos
+// (WORKLOAD_PICKS: uniform ou zipf[:s] para produtos mais procurados) e gerador de cada thread
+uint64_t workload_seed;
+WorkloadDist product_picks;
+_Thread_local WorkloadRng thread_rng;
+
 /**
  * Inicializa o Catálogo
  *
@@ -82,8 +90,8 @@ void init_catalog()
     for (int i = 0; i < MAX_PRODUCTS; i++)
     {
         catalog.products[i].id = i + 1;
-        catalog.products[i].price = 10.0 + (rand() % 1000); // Preço entre R$10 e R$1010
-        catalog.products[i].stock = rand() % 50;            // Estoque entre 0 e 49
+        catalog.products[i].price = 10.0 + workload_below(&thread_rng, 1000); // Preço entre R$10 e R$1010
+        catalog.products[i].stock = (int)workload_below(&thread_rng, 50);     // Estoque entre 0 e 49
     }
 }
 
@@ -105,6 +113,7 @@ void *reader(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)id);
     for (int i = 0; i < NUM_READS; i++)
     {
         // Protocolo de entrada - Início da leitura
@@ -117,12 +126,12 @@ void *reader(void *arg)
         pthread_mutex_unlock(&catalog.mutex);
 
         // Seção crítica - Consulta do produto
-        int product_id = rand() % MAX_PRODUCTS;
+        int product_id = (int)workload_sample(&product_picks, &thread_rng);
         Product product = catalog.products[product_id];
         printf("Cliente %d consultando produto %d: Preço = R$%.2f, Estoque = %d\n",
                id, product.id, product.price, product.stock);
 
-        usleep(rand() % 500000); // Simula tempo de consulta (0-500ms)
+        usleep(workload_below(&thread_rng, 500000)); // Simula tempo de consulta (0-500ms)
 
         // Protocolo de saída - Fim da leitura
         pthread_mutex_lock(&catalog.mutex);
@@ -133,7 +142,7 @@ void *reader(void *arg)
         }
         pthread_mutex_unlock(&catalog.mutex);
 
-        usleep(rand() % 1000000); // Intervalo entre consultas (0-1s)
+        usleep(workload_below(&thread_rng, 1000000)); // Intervalo entre consultas (0-1s)
     }
 
     printf("Cliente %d finalizou suas consultas\n", id);
@@ -156,15 +165,16 @@ void *writer(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)(NUM_READERS + id));
     for (int i = 0; i < NUM_WRITES; i++)
     {
         // Protocolo de entrada - Início da escrita
         pthread_mutex_lock(&catalog.write_mutex);
 
         // Seção crítica - Atualização do produto
-        int product_id = rand() % MAX_PRODUCTS;
-        float price_change = (rand() % 20) - 10; // Variação de -10% a +10%
-        int stock_change = (rand() % 10) - 3;    // Variação de -3 a +6
+        int product_id = (int)workload_sample(&product_picks, &thread_rng);
+        float price_change = (int)workload_below(&thread_rng, 20) - 10; // Variação de -10% a +10%
+        int stock_change = (int)workload_below(&thread_rng, 10) - 3;    // Variação de -3 a +6
 
         Product *product = &catalog.products[product_id];
         product->price *= (1 + price_change / 100.0);
@@ -175,12 +185,12 @@ void *writer(void *arg)
         printf("Funcionário %d atualizando produto %d: Novo preço = R$%.2f, Novo estoque = %d\n",
                id, product->id, product->price, product->stock);
 
-        usleep(rand() % 1000000); // Simula tempo de atualização (0-1s)
+        usleep(workload_below(&thread_rng, 1000000)); // Simula tempo de atualização (0-1s)
 
         // Protocolo de saída - Fim da escrita
         pthread_mutex_unlock(&catalog.write_mutex);
 
-        usleep(rand() % 2000000); // Intervalo entre atualizações (0-2s)
+        usleep(workload_below(&thread_rng, 2000000)); // Intervalo entre atualizações (0-2s)
     }
 
     printf("Funcionário %d finalizou suas atualizações\n", id);
@@ -206,6 +216,9 @@ int main()
     int writer_ids[NUM_WRITERS];
 
     // Inicializa sistema
+    workload_seed = workload_env_seed();
+    workload_env_dist("WORKLOAD_PICKS", 0, MAX_PRODUCTS - 1, &product_picks);
+    workload_rng_init(&thread_rng, workload_seed, 0);
     init_catalog();
 
     // Cria threads de clientes (leitores)
@@ -25,6 +25,8 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+#include "../common/workload.h"
+
 /**
  * Constantes de Configuração do Sistema
  */
@@ -67,6 +69,12 @@ typedef struct
 Catalog catalog = {
     .num_readers = 0};
 
+// Gerador de carga: semente da execução (WORKLOAD_SEED), escolha dos produtos
+// (WORKLOAD_PICKS: uniform ou zipf[:s] para produtos mais procurados) e gerador de cada thread
+uint64_t workload_seed;
+WorkloadDist product_picks;
+_Thread_local WorkloadRng thread_rng;
+
 /**
  * Inicializa o catálogo e seus mecanismos de sincronização
  *
@@ -86,8 +94,8 @@ void init_catalog()
     for (int i = 0; i < MAX_PRODUCTS; i++)
     {
         catalog.products[i].id = i + 1;
-        catalog.products[i].price = 10.0 + (rand() % 1000); // Preço entre 10 e 1010
-        catalog.products[i].stock = rand() % 50;            // Estoque entre 0 e 49
+        catalog.products[i].price = 10.0 + workload_below(&thread_rng, 1000); // Preço entre 10 e 1010
+        catalog.products[i].stock = (int)workload_below(&thread_rng, 50);     // Estoque entre 0 e 49
     }
 }
 
@@ -113,6 +121,7 @@ void *reader(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)id);
     for (int i = 0; i < NUM_READS; i++)
     {
         // Protocolo de entrada para leitura
@@ -125,12 +134,12 @@ void *reader(void *arg)
         sem_post(&catalog.read_mutex);
 
         // Seção crítica - Consulta do produto
-        int product_id = rand() % MAX_PRODUCTS;
+        int product_id = (int)workload_sample(&product_picks, &thread_rng);
         Product product = catalog.products[product_id];
         printf("Cliente %d consultando produto %d: Preço = R$%.2f, Estoque = %d\n",
                id, product.id, product.price, product.stock);
 
-        usleep(rand() % 500000); // Simula tempo de consulta (0-500ms)
+        usleep(workload_below(&thread_rng, 500000)); // Simula tempo de consulta (0-500ms)
 
         // Protocolo de saída da leitura
         sem_wait(&catalog.read_mutex);
@@ -141,7 +150,7 @@ void *reader(void *arg)
         }
         sem_post(&catalog.read_mutex);
 
-        usleep(rand() % 1000000); // Intervalo entre consultas (0-1s)
+        usleep(workload_below(&thread_rng, 1000000)); // Intervalo entre consultas (0-1s)
     }
 
     printf("Cliente %d finalizou suas consultas\n", id);
@@ -166,15 +175,16 @@ void *writer(void *arg)
 {
     int id = *(int *)arg;
 
+    workload_rng_init(&thread_rng, workload_seed, (uint64_t)(NUM_READERS + id));
     for (int i = 0; i < NUM_WRITES; i++)
     {
         // Protocolo de entrada para escrita
         sem_wait(&catalog.write_mutex);
 
         // Seção crítica - Atualização do produto
-        int product_id = rand() % MAX_PRODUCTS;
-        float price_change = (rand() % 20) - 10; // Variação de preço entre -10% e +10%
-        int stock_change = (rand() % 10) - 3;    // Variação de estoque entre -3 e +6
+        int product_id = (int)workload_sample(&product_picks, &thread_rng);
+        float price_change = (int)workload_below(&thread_rng, 20) - 10; // Variação de preço entre -10% e +10%
+        int stock_change = (int)workload_below(&thread_rng, 10) - 3;    // Variação de estoque entre -3 e +6
 
         Product *product = &catalog.products[product_id];
         product->price *= (1 + price_change / 100.0);
@@ -185,12 +195,12 @@ void *writer(void *arg)
         printf("Funcionário %d atualizando produto %d: Novo preço = R$%.2f, Novo estoque = %d\n",
                id, product->id, product->price, product->stock);
 
-        usleep(rand() % 1000000); // Simula tempo de atualização (0-1s)
+        usleep(workload_below(&thread_rng, 1000000)); // Simula tempo de atualização (0-1s)
 
         // Protocolo de saída da escrita
         sem_post(&catalog.write_mutex);
 
-        usleep(rand() % 2000000); // Intervalo entre atualizações (0-2s)
+        usleep(workload_below(&thread_rng, 2000000)); // Intervalo entre atualizações (0-2s)
     }
 
     printf("Funcionário %d finalizou suas atualizações\n", id);
@@ -231,6 +241,9 @@ int main()
     int reader_ids[NUM_READERS];
     int writer_ids[NUM_WRITERS];
 
+    workload_seed = workload_env_seed();
+    workload_env_dist("WORKLOAD_PICKS", 0, MAX_PRODUCTS - 1, &product_picks);
+    workload_rng_init(&thread_rng, workload_seed, 0);
     init_catalog();
 
     // Cria threads de clientes